@@ -0,0 +1,80 @@
+#include "BaselineComparison.h"
+#include <cmath>
+#include <unordered_map>
+
+namespace DirtSim {
+namespace Bench {
+
+namespace {
+
+void classify(
+    Comparison& comparison,
+    const Tolerance& tolerance,
+    const std::string& key,
+    const std::string& stage,
+    double baselineMs,
+    double currentMs)
+{
+    const double delta = currentMs - baselineMs;
+    if (baselineMs <= 0.0 || std::abs(delta) <= tolerance.absoluteMs) {
+        return;
+    }
+
+    const double change = delta / baselineMs;
+    if (std::abs(change) <= tolerance.relative) {
+        return;
+    }
+
+    const Difference difference{
+        .key = key,
+        .stage = stage,
+        .baselineMs = baselineMs,
+        .currentMs = currentMs,
+        .change = change,
+    };
+    if (change > 0.0) {
+        comparison.regressions.push_back(difference);
+    }
+    else {
+        comparison.improvements.push_back(difference);
+    }
+}
+
+} // namespace
+
+Comparison compareToBaseline(
+    const std::vector<ScenarioResult>& baseline,
+    const std::vector<ScenarioResult>& current,
+    const Tolerance& tolerance)
+{
+    std::unordered_map<std::string, const ScenarioResult*> baselineByKey;
+    for (const auto& result : baseline) {
+        baselineByKey[resultKey(result)] = &result;
+    }
+
+    Comparison comparison;
+    for (const auto& result : current) {
+        const std::string key = resultKey(result);
+        const auto it = baselineByKey.find(key);
+        if (it == baselineByKey.end()) {
+            comparison.missing.push_back(key);
+            continue;
+        }
+
+        const ScenarioResult& reference = *it->second;
+        classify(comparison, tolerance, key, "step", reference.step_avg_ms, result.step_avg_ms);
+
+        for (const auto& [stage, timing] : result.stages) {
+            const auto stageIt = reference.stages.find(stage);
+            if (stageIt == reference.stages.end()) {
+                continue;
+            }
+            classify(
+                comparison, tolerance, key, stage, stageIt->second.per_step_ms, timing.per_step_ms);
+        }
+    }
+    return comparison;
+}
+
+} // namespace Bench
+} // namespace DirtSim
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "BenchmarkResults.h"
+#include <string>
+#include <vector>
+
+namespace DirtSim {
+namespace Bench {
+
+/**
+ * @brief How far a timing may move before it counts as a change.
+ *
+ * Both limits must be exceeded: the relative one catches real slowdowns, the absolute one
+ * keeps microsecond-scale stages from flagging on noise.
+ */
+struct Tolerance {
+    double relative = 0.10;
+    double absoluteMs = 0.05;
+};
+
+struct Difference {
+    std::string key;   // resultKey() of the matrix cell.
+    std::string stage; // "step" for the whole step, else a World timer name.
+    double baselineMs = 0.0;
+    double currentMs = 0.0;
+    double change = 0.0; // (current - baseline) / baseline.
+};
+
+struct Comparison {
+    std::vector<Difference> regressions;
+    std::vector<Difference> improvements;
+    std::vector<std::string> missing; // Matrix cells with no baseline entry.
+
+    bool passed() const { return regressions.empty(); }
+};
+
+/**
+ * @brief Compare per-step averages (whole step and each stage) against a baseline run.
+ */
+Comparison compareToBaseline(
+    const std::vector<ScenarioResult>& baseline,
+    const std::vector<ScenarioResult>& current,
+    const Tolerance& tolerance);
+
+} // namespace Bench
+} // namespace DirtSim
@@ -0,0 +1,66 @@
+#include "BenchmarkResults.h"
+#include "core/ReflectSerializer.h"
+
+namespace DirtSim {
+namespace Bench {
+
+void to_json(nlohmann::json& j, const StageResult& stage)
+{
+    j = ReflectSerializer::to_json(stage);
+}
+
+void from_json(const nlohmann::json& j, StageResult& stage)
+{
+    stage = ReflectSerializer::from_json<StageResult>(j);
+}
+
+void to_json(nlohmann::json& j, const ScenarioResult& result)
+{
+    j = ReflectSerializer::to_json(result);
+}
+
+void from_json(const nlohmann::json& j, ScenarioResult& result)
+{
+    result = ReflectSerializer::from_json<ScenarioResult>(j);
+}
+
+void to_json(nlohmann::json& j, const KernelResult& result)
+{
+    j = ReflectSerializer::to_json(result);
+}
+
+void from_json(const nlohmann::json& j, KernelResult& result)
+{
+    result = ReflectSerializer::from_json<KernelResult>(j);
+}
+
+std::string resultKey(const ScenarioResult& result)
+{
+    std::string key = result.scenario + "/" + std::to_string(result.width) + "x"
+        + std::to_string(result.height) + "/t" + std::to_string(result.threads);
+    if (!result.openmp) {
+        key += "/serial";
+    }
+    return key;
+}
+
+nlohmann::json resultsToJson(const std::vector<ScenarioResult>& results)
+{
+    return { { "results", results } };
+}
+
+std::vector<ScenarioResult> resultsFromJson(const nlohmann::json& j)
+{
+    if (!j.contains("results")) {
+        return {};
+    }
+    return j["results"].get<std::vector<ScenarioResult>>();
+}
+
+nlohmann::json kernelResultsToJson(const std::vector<KernelResult>& results)
+{
+    return { { "kernels", results } };
+}
+
+} // namespace Bench
+} // namespace DirtSim
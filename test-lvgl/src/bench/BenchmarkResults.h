@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace DirtSim {
+namespace Bench {
+
+/**
+ * @brief Time spent in one World timer scope over the measured steps.
+ */
+struct StageResult {
+    uint32_t calls = 0;
+    double total_ms = 0.0;
+    double per_step_ms = 0.0; // total_ms / measured steps.
+};
+
+void to_json(nlohmann::json& j, const StageResult& stage);
+void from_json(const nlohmann::json& j, StageResult& stage);
+
+/**
+ * @brief One cell of the scenario x size x thread matrix (flattened for ReflectSerializer).
+ */
+struct ScenarioResult {
+    std::string scenario;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    int threads = 1;
+    bool openmp = true; // GridOfCells::USE_OPENMP during the run.
+    uint32_t warmup_steps = 0;
+    uint32_t steps = 0;
+
+    // Whole step (scenario tick + World::advanceTime) wall time.
+    double step_avg_ms = 0.0;
+    double step_p50_ms = 0.0;
+    double step_p95_ms = 0.0;
+    double step_max_ms = 0.0;
+    double steps_per_sec = 0.0;
+
+    std::map<std::string, StageResult> stages;
+};
+
+void to_json(nlohmann::json& j, const ScenarioResult& result);
+void from_json(const nlohmann::json& j, ScenarioResult& result);
+
+/**
+ * @brief One calculator kernel timed on one synthetic grid.
+ */
+struct KernelResult {
+    std::string kernel;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::string mix; // Material mix preset the grid was filled with.
+    double density = 0.0;
+    double motion = 0.0;
+    uint32_t active_cells = 0; // Non-empty, non-wall cells.
+    uint32_t iterations = 0;
+
+    double avg_ms = 0.0;
+    double min_ms = 0.0;
+    double ns_per_cell = 0.0;        // Best iteration / (width * height).
+    double ns_per_active_cell = 0.0; // Best iteration / active_cells.
+    double scaling = 1.0; // ns_per_cell relative to the smallest grid of the same kernel.
+};
+
+void to_json(nlohmann::json& j, const KernelResult& result);
+void from_json(const nlohmann::json& j, KernelResult& result);
+
+// Identity of a result within a matrix, e.g. "sandbox/100x100/t4".
+std::string resultKey(const ScenarioResult& result);
+
+// Results file: { "results": [ ScenarioResult... ] }.
+nlohmann::json resultsToJson(const std::vector<ScenarioResult>& results);
+std::vector<ScenarioResult> resultsFromJson(const nlohmann::json& j);
+
+// Kernel results file: { "kernels": [ KernelResult... ] }.
+nlohmann::json kernelResultsToJson(const std::vector<KernelResult>& results);
+
+} // namespace Bench
+} // namespace DirtSim
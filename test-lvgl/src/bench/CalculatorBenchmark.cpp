@@ -0,0 +1,313 @@
+#include "CalculatorBenchmark.h"
+#include "core/Cell.h"
+#include "core/GridOfCells.h"
+#include "core/MaterialType.h"
+#include "core/RenderMessageUtils.h"
+#include "core/World.h"
+#include "core/WorldAdhesionCalculator.h"
+#include "core/WorldCohesionCalculator.h"
+#include "core/WorldData.h"
+#include "core/WorldFrictionCalculator.h"
+#include "core/WorldPressureCalculator.h"
+#include "core/WorldSupportCalculator.h"
+#include "core/WorldViscosityCalculator.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <spdlog/spdlog.h>
+
+namespace DirtSim {
+namespace Bench {
+
+namespace {
+
+constexpr double KERNEL_DELTA_TIME = 0.016; // Matches ScenarioBenchmark::TIMESTEP_SECONDS.
+
+// Keeps kernel results observable so the compiler cannot drop the work.
+volatile double benchmarkSink = 0.0;
+
+// Runs `body` over every non-empty, non-wall cell.
+template <typename Body>
+void forEachActiveCell(const WorldData& data, Body&& body)
+{
+    for (uint32_t y = 0; y < data.height; ++y) {
+        for (uint32_t x = 0; x < data.width; ++x) {
+            const Cell& cell = data.at(x, y);
+            if (cell.isEmpty() || cell.isWall()) {
+                continue;
+            }
+            body(x, y);
+        }
+    }
+}
+
+struct Kernel {
+    const char* name;
+    bool mutatesCells; // Restore the grid before each iteration.
+    std::function<void(World&, GridOfCells&, double&)> body;
+};
+
+const std::vector<Kernel>& kernels()
+{
+    static const std::vector<Kernel> kernels = {
+        { "cohesion_com",
+          false,
+          [](World& world, GridOfCells& grid, double& sink) {
+              const WorldCohesionCalculator calc{};
+              const uint32_t range = world.getCOMCohesionRange();
+              forEachActiveCell(world.getData(), [&](uint32_t x, uint32_t y) {
+                  sink += calc.calculateCOMCohesionForce(world, x, y, range, &grid)
+                              .force_magnitude;
+              });
+          } },
+        { "adhesion",
+          false,
+          [](World& world, GridOfCells& grid, double& sink) {
+              const WorldAdhesionCalculator& calc = world.getAdhesionCalculator();
+              forEachActiveCell(world.getData(), [&](uint32_t x, uint32_t y) {
+                  sink += calc.calculateAdhesionForce(
+                                  world, x, y, grid.getMaterialNeighborhood(x, y))
+                              .force_magnitude;
+              });
+          } },
+        { "viscosity",
+          false,
+          [](World& world, GridOfCells& grid, double& sink) {
+              const WorldViscosityCalculator& calc = world.getViscosityCalculator();
+              const double strength = world.getViscosityStrength();
+              forEachActiveCell(world.getData(), [&](uint32_t x, uint32_t y) {
+                  sink += calc.calculateViscousForce(world, x, y, strength, &grid).force.x;
+              });
+          } },
+        { "friction",
+          true,
+          [](World& world, GridOfCells& grid, double& sink) {
+              WorldFrictionCalculator calc{ grid };
+              calc.calculateAndApplyFrictionForces(world, KERNEL_DELTA_TIME);
+              sink += world.getData().cells[world.getData().cells.size() / 2].velocity.x;
+          } },
+        { "pressure_hydrostatic",
+          true,
+          [](World& world, GridOfCells& /*grid*/, double& sink) {
+              world.getPressureCalculator().calculateHydrostaticPressure(world);
+              sink += world.getData().cells[world.getData().cells.size() / 2].pressure;
+          } },
+        { "pressure_diffusion",
+          true,
+          [](World& world, GridOfCells& /*grid*/, double& sink) {
+              world.getPressureCalculator().applyPressureDiffusion(world, KERNEL_DELTA_TIME);
+              sink += world.getData().cells[world.getData().cells.size() / 2].pressure;
+          } },
+        { "pressure_gradient",
+          false,
+          [](World& world, GridOfCells& /*grid*/, double& sink) {
+              const WorldPressureCalculator& calc = world.getPressureCalculator();
+              forEachActiveCell(world.getData(), [&](uint32_t x, uint32_t y) {
+                  sink += calc.calculatePressureGradient(world, x, y).y;
+              });
+          } },
+        { "support_map",
+          true,
+          [](World& world, GridOfCells& grid, double& sink) {
+              const WorldSupportCalculator calc{ grid };
+              calc.computeSupportMapBottomUp(world);
+              sink += grid.supportBitmap().countSet();
+          } },
+        { "grid_build",
+          false,
+          [](World& world, GridOfCells& /*grid*/, double& sink) {
+              WorldData& data = world.getData();
+              const GridOfCells built(data.cells, data.debug_info, data.width, data.height);
+              sink += built.emptyCells().countSet();
+          } },
+        { "render_pack_basic",
+          false,
+          [](World& world, GridOfCells& /*grid*/, double& sink) {
+              sink += RenderMessageUtils::packBasicCells(world.getData()).size();
+          } },
+        { "render_pack_debug",
+          false,
+          [](World& world, GridOfCells& /*grid*/, double& sink) {
+              sink += RenderMessageUtils::packDebugCells(world.getData()).size();
+          } },
+    };
+    return kernels;
+}
+
+const Kernel* findKernel(const std::string& name)
+{
+    for (const auto& kernel : kernels()) {
+        if (name == kernel.name) {
+            return &kernel;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<std::vector<MaterialType>> mixMaterials(const std::string& mix)
+{
+    if (mix == "dirt") {
+        return std::vector<MaterialType>{ MaterialType::DIRT };
+    }
+    if (mix == "sand") {
+        return std::vector<MaterialType>{ MaterialType::SAND };
+    }
+    if (mix == "water") {
+        return std::vector<MaterialType>{ MaterialType::WATER };
+    }
+    if (mix == "mixed") {
+        return std::vector<MaterialType>{
+            MaterialType::DIRT,
+            MaterialType::SAND,
+            MaterialType::WATER,
+            MaterialType::WOOD,
+            MaterialType::METAL,
+        };
+    }
+    return std::nullopt;
+}
+
+// Deterministic fill of everything inside the boundary walls.
+uint32_t populate(World& world, const GridSpec& spec, const std::vector<MaterialType>& materials)
+{
+    std::mt19937 rng(spec.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> fill(0.5, 1.0);
+    std::uniform_real_distribution<double> velocity(-spec.motion, spec.motion);
+    std::uniform_int_distribution<size_t> pick(0, materials.size() - 1);
+
+    uint32_t active = 0;
+    for (Cell& cell : world.getData().cells) {
+        if (cell.isWall() || unit(rng) >= spec.density) {
+            continue;
+        }
+        cell.replaceMaterial(materials[pick(rng)], fill(rng));
+        cell.velocity = spec.motion > 0.0 ? Vector2d{ velocity(rng), velocity(rng) } : Vector2d{};
+        ++active;
+    }
+    return active;
+}
+
+} // namespace
+
+const std::vector<std::string>& CalculatorBenchmark::kernelNames()
+{
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> result;
+        for (const auto& kernel : kernels()) {
+            result.emplace_back(kernel.name);
+        }
+        return result;
+    }();
+    return names;
+}
+
+const std::vector<std::string>& CalculatorBenchmark::mixNames()
+{
+    static const std::vector<std::string> names = { "dirt", "sand", "water", "mixed" };
+    return names;
+}
+
+std::optional<KernelResult> CalculatorBenchmark::run(
+    const std::string& kernelName, const GridSpec& spec, uint32_t warmup, uint32_t iterations)
+{
+    const Kernel* kernel = findKernel(kernelName);
+    const auto materials = mixMaterials(spec.mix);
+    if (!kernel || !materials || spec.width == 0 || spec.height == 0) {
+        return std::nullopt;
+    }
+    iterations = std::max(iterations, 1u);
+
+    World world(spec.width, spec.height);
+    WorldData& data = world.getData();
+    const uint32_t active = populate(world, spec, *materials);
+
+    // Shared inputs: bitmaps for the cached paths, hydrostatic pressure for gradient/diffusion.
+    GridOfCells grid(data.cells, data.debug_info, data.width, data.height);
+    world.getPressureCalculator().calculateHydrostaticPressure(world);
+
+    const std::vector<Cell> pristineCells = data.cells;
+    const std::vector<CellDebug> pristineDebug = data.debug_info;
+
+    double sink = 0.0;
+    std::vector<double> iterationMs;
+    iterationMs.reserve(iterations);
+    for (uint32_t i = 0; i < warmup + iterations; ++i) {
+        if (kernel->mutatesCells) {
+            data.cells = pristineCells;
+            data.debug_info = pristineDebug;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        kernel->body(world, grid, sink);
+        const double ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                .count();
+        if (i >= warmup) {
+            iterationMs.push_back(ms);
+        }
+    }
+    benchmarkSink = benchmarkSink + sink;
+
+    double totalMs = 0.0;
+    for (const double ms : iterationMs) {
+        totalMs += ms;
+    }
+    const double minMs = *std::min_element(iterationMs.begin(), iterationMs.end());
+    const double cells = static_cast<double>(spec.width) * spec.height;
+
+    KernelResult result;
+    result.kernel = kernelName;
+    result.width = spec.width;
+    result.height = spec.height;
+    result.mix = spec.mix;
+    result.density = spec.density;
+    result.motion = spec.motion;
+    result.active_cells = active;
+    result.iterations = iterations;
+    result.avg_ms = totalMs / iterationMs.size();
+    result.min_ms = minMs;
+    result.ns_per_cell = minMs * 1e6 / cells;
+    result.ns_per_active_cell = active > 0 ? minMs * 1e6 / active : 0.0;
+    return result;
+}
+
+std::vector<KernelResult> CalculatorBenchmark::runMatrix(
+    const std::vector<std::string>& kernelList,
+    const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+    const GridSpec& spec,
+    uint32_t warmup,
+    uint32_t iterations)
+{
+    std::vector<KernelResult> results;
+    for (const auto& kernel : kernelList) {
+        if (!findKernel(kernel)) {
+            spdlog::error("Bench: Unknown kernel '{}', skipping", kernel);
+            continue;
+        }
+
+        double referenceNsPerCell = 0.0;
+        for (const auto& [width, height] : sizes) {
+            GridSpec sized = spec;
+            sized.width = width;
+            sized.height = height;
+
+            auto result = run(kernel, sized, warmup, iterations);
+            if (!result) {
+                continue;
+            }
+
+            if (referenceNsPerCell <= 0.0) {
+                referenceNsPerCell = result->ns_per_cell;
+            }
+            result->scaling =
+                referenceNsPerCell > 0.0 ? result->ns_per_cell / referenceNsPerCell : 1.0;
+            results.push_back(std::move(*result));
+        }
+    }
+    return results;
+}
+
+} // namespace Bench
+} // namespace DirtSim
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "BenchmarkResults.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DirtSim {
+namespace Bench {
+
+/**
+ * @brief Synthetic grid contents for kernel runs.
+ *
+ * Cells inside the boundary walls are filled with probability `density`, drawing material
+ * from the `mix` preset (dirt, sand, water, solid or mixed) with a random fill ratio in
+ * [0.5, 1] and a random velocity of up to `motion` cells/s per axis.
+ */
+struct GridSpec {
+    uint32_t width = 100;
+    uint32_t height = 100;
+    double density = 0.6;
+    std::string mix = "mixed";
+    double motion = 1.0;
+    uint32_t seed = 42;
+};
+
+/**
+ * @brief Times individual physics calculators on synthetic grids.
+ *
+ * Each kernel runs serially over a freshly generated World, with inputs (grid cache,
+ * hydrostatic pressure) prepared outside the timed region. Kernels that modify cells get
+ * their grid restored between iterations, also untimed, so every iteration sees the same
+ * input. The best iteration is reported, normalized per cell.
+ */
+class CalculatorBenchmark {
+public:
+    static const std::vector<std::string>& kernelNames();
+    static const std::vector<std::string>& mixNames();
+
+    // Nullopt if the kernel or mix is unknown.
+    static std::optional<KernelResult> run(
+        const std::string& kernel, const GridSpec& spec, uint32_t warmup, uint32_t iterations);
+
+    // Every kernel x size, kernel-major, with `scaling` filled relative to the first size.
+    static std::vector<KernelResult> runMatrix(
+        const std::vector<std::string>& kernels,
+        const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+        const GridSpec& spec,
+        uint32_t warmup,
+        uint32_t iterations);
+};
+
+} // namespace Bench
+} // namespace DirtSim
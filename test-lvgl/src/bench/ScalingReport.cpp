@@ -0,0 +1,111 @@
+#include "ScalingReport.h"
+#include "core/ReflectSerializer.h"
+#include <unordered_map>
+
+namespace DirtSim {
+namespace Bench {
+
+namespace {
+
+std::string sizeKey(const ScenarioResult& result)
+{
+    return result.scenario + "/" + std::to_string(result.width) + "x"
+        + std::to_string(result.height);
+}
+
+StageScaling scale(
+    double serialMs, double parallelMs, int threads, double threshold, double minStageMs)
+{
+    StageScaling scaling;
+    scaling.serial_ms = serialMs;
+    scaling.parallel_ms = parallelMs;
+    if (serialMs <= 0.0 || parallelMs <= 0.0) {
+        return scaling;
+    }
+
+    scaling.speedup = serialMs / parallelMs;
+    scaling.efficiency = scaling.speedup / threads;
+    scaling.flagged = threads > 1 && serialMs >= minStageMs && scaling.efficiency < threshold;
+    return scaling;
+}
+
+} // namespace
+
+void to_json(nlohmann::json& j, const StageScaling& stage)
+{
+    j = ReflectSerializer::to_json(stage);
+}
+
+void from_json(const nlohmann::json& j, StageScaling& stage)
+{
+    stage = ReflectSerializer::from_json<StageScaling>(j);
+}
+
+void to_json(nlohmann::json& j, const ScalingPoint& point)
+{
+    j = ReflectSerializer::to_json(point);
+}
+
+void from_json(const nlohmann::json& j, ScalingPoint& point)
+{
+    point = ReflectSerializer::from_json<ScalingPoint>(j);
+}
+
+std::vector<ScalingPoint> ScalingReport::build(
+    const std::vector<ScenarioResult>& results, double efficiencyThreshold, double minStageMs)
+{
+    std::unordered_map<std::string, const ScenarioResult*> serialBySize;
+    for (const auto& result : results) {
+        if (!result.openmp) {
+            serialBySize[sizeKey(result)] = &result;
+        }
+    }
+
+    std::vector<ScalingPoint> points;
+    for (const auto& result : results) {
+        if (!result.openmp) {
+            continue;
+        }
+        const auto it = serialBySize.find(sizeKey(result));
+        if (it == serialBySize.end()) {
+            continue;
+        }
+        const ScenarioResult& serial = *it->second;
+
+        ScalingPoint point;
+        point.scenario = result.scenario;
+        point.width = result.width;
+        point.height = result.height;
+        point.threads = result.threads;
+        point.below_parallel_cutoff = result.width * result.height < PARALLEL_CUTOFF_CELLS;
+        point.step = scale(
+            serial.step_avg_ms,
+            result.step_avg_ms,
+            result.threads,
+            efficiencyThreshold,
+            minStageMs);
+
+        for (const auto& [name, stage] : result.stages) {
+            const auto serialStage = serial.stages.find(name);
+            if (serialStage == serial.stages.end()) {
+                continue;
+            }
+            point.stages[name] = scale(
+                serialStage->second.per_step_ms,
+                stage.per_step_ms,
+                result.threads,
+                efficiencyThreshold,
+                minStageMs);
+        }
+        points.push_back(std::move(point));
+    }
+    return points;
+}
+
+nlohmann::json ScalingReport::toJson(const std::vector<ScalingPoint>& points)
+{
+    return { { "scaling", points } };
+}
+
+} // namespace Bench
+} // namespace DirtSim
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "BenchmarkResults.h"
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace DirtSim {
+namespace Bench {
+
+/**
+ * @brief Speedup of one timing against the serial (USE_OPENMP off) run of the same cell.
+ */
+struct StageScaling {
+    double serial_ms = 0.0; // Per step, OpenMP disabled.
+    double parallel_ms = 0.0;
+    double speedup = 0.0;    // serial_ms / parallel_ms.
+    double efficiency = 0.0; // speedup / threads.
+    bool flagged = false;    // Efficiency below threshold.
+};
+
+void to_json(nlohmann::json& j, const StageScaling& stage);
+void from_json(const nlohmann::json& j, StageScaling& stage);
+
+/**
+ * @brief One scenario x size x thread count point on the scaling curve.
+ */
+struct ScalingPoint {
+    std::string scenario;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    int threads = 1;
+    // World's parallel regions are skipped below this many cells (the ">= 2500" guards).
+    bool below_parallel_cutoff = false;
+
+    StageScaling step;
+    std::map<std::string, StageScaling> stages;
+};
+
+void to_json(nlohmann::json& j, const ScalingPoint& point);
+void from_json(const nlohmann::json& j, ScalingPoint& point);
+
+/**
+ * @brief Turns scenario results into speedup and parallel efficiency curves.
+ *
+ * Every OpenMP result is paired with the serial result (openmp = false) for the same
+ * scenario and size; results without a serial partner are dropped. Stages are flagged when
+ * their efficiency falls below `efficiencyThreshold`, ignoring stages shorter than
+ * `minStageMs` per step in the serial run, whose ratios are mostly timer noise.
+ */
+class ScalingReport {
+public:
+    static constexpr uint32_t PARALLEL_CUTOFF_CELLS = 2500; // Mirrors World.cpp.
+
+    static std::vector<ScalingPoint> build(
+        const std::vector<ScenarioResult>& results,
+        double efficiencyThreshold,
+        double minStageMs = 0.01);
+
+    // { "scaling": [ ScalingPoint... ] }.
+    static nlohmann::json toJson(const std::vector<ScalingPoint>& points);
+};
+
+} // namespace Bench
+} // namespace DirtSim
@@ -0,0 +1,264 @@
+#include "ScenarioBenchmark.h"
+#include "core/GridOfCells.h"
+#include "core/Timers.h"
+#include "core/World.h"
+#include "core/WorldData.h"
+#include "server/scenarios/ScenarioRegistry.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace DirtSim {
+namespace Bench {
+
+namespace {
+
+struct StageSnapshot {
+    uint32_t calls = 0;
+    double totalMs = 0.0;
+};
+
+std::map<std::string, StageSnapshot> snapshotStages(const Timers& timers)
+{
+    std::map<std::string, StageSnapshot> snapshot;
+    for (const auto& name : timers.getAllTimerNames()) {
+        snapshot[name] = StageSnapshot{
+            .calls = timers.getCallCount(name),
+            .totalMs = timers.getAccumulatedTime(name),
+        };
+    }
+    return snapshot;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+// Applies a run's parallelism settings and puts the process-wide ones back on scope exit,
+// so one scenario's thread count never leaks into the next or into the caller.
+class ParallelismScope {
+public:
+    ParallelismScope(int threads, bool openmp) : previousOpenmp_(GridOfCells::USE_OPENMP)
+    {
+#ifdef _OPENMP
+        previousThreads_ = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+        GridOfCells::USE_OPENMP = openmp;
+    }
+
+    ~ParallelismScope()
+    {
+        GridOfCells::USE_OPENMP = previousOpenmp_;
+#ifdef _OPENMP
+        omp_set_num_threads(previousThreads_);
+#endif
+    }
+
+    ParallelismScope(const ParallelismScope&) = delete;
+    ParallelismScope& operator=(const ParallelismScope&) = delete;
+
+private:
+    bool previousOpenmp_;
+    int previousThreads_ = 1;
+};
+
+} // namespace
+
+ScenarioBenchmark::ScenarioBenchmark(const ScenarioRegistry& registry) : registry_(registry)
+{}
+
+std::optional<ScenarioResult> ScenarioBenchmark::run(const ScenarioRun& run) const
+{
+    auto scenario = registry_.createScenario(run.scenario);
+    if (!scenario) {
+        return std::nullopt;
+    }
+
+    uint32_t width = run.width;
+    uint32_t height = run.height;
+    if (width == 0 || height == 0) {
+        const auto& metadata = scenario->getMetadata();
+        const bool fixed = metadata.requiredWidth > 0 && metadata.requiredHeight > 0;
+        width = fixed ? metadata.requiredWidth : DEFAULT_SIZE;
+        height = fixed ? metadata.requiredHeight : DEFAULT_SIZE;
+    }
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = std::max(run.threads, 1);
+#endif
+    const ParallelismScope parallelism(threads, run.openmp);
+
+    World world(width, height);
+    world.getData().scenario_id = run.scenario;
+    world.getData().scenario_config = scenario->getConfig();
+    scenario->setup(world);
+
+    auto step = [&]() {
+        scenario->tick(world, TIMESTEP_SECONDS);
+        world.advanceTime(TIMESTEP_SECONDS);
+    };
+
+    for (uint32_t i = 0; i < run.warmupSteps; ++i) {
+        step();
+    }
+
+    const auto before = snapshotStages(world.getTimers());
+    std::vector<double> stepMs;
+    stepMs.reserve(run.steps);
+    for (uint32_t i = 0; i < run.steps; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        step();
+        stepMs.push_back(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                .count());
+    }
+    const auto after = snapshotStages(world.getTimers());
+
+    ScenarioResult result;
+    result.scenario = run.scenario;
+    result.width = width;
+    result.height = height;
+    result.threads = threads;
+    result.openmp = run.openmp;
+    result.warmup_steps = run.warmupSteps;
+    result.steps = run.steps;
+
+    double totalMs = 0.0;
+    for (const double ms : stepMs) {
+        totalMs += ms;
+    }
+    std::sort(stepMs.begin(), stepMs.end());
+    result.step_avg_ms = stepMs.empty() ? 0.0 : totalMs / stepMs.size();
+    result.step_p50_ms = percentile(stepMs, 0.50);
+    result.step_p95_ms = percentile(stepMs, 0.95);
+    result.step_max_ms = stepMs.empty() ? 0.0 : stepMs.back();
+    result.steps_per_sec = totalMs > 0.0 ? stepMs.size() * 1000.0 / totalMs : 0.0;
+
+    for (const auto& [name, end] : after) {
+        const auto it = before.find(name);
+        const StageSnapshot start = it != before.end() ? it->second : StageSnapshot{};
+        const uint32_t calls = end.calls - start.calls;
+        if (calls == 0) {
+            continue;
+        }
+
+        StageResult stage;
+        stage.calls = calls;
+        stage.total_ms = end.totalMs - start.totalMs;
+        stage.per_step_ms = run.steps > 0 ? stage.total_ms / run.steps : 0.0;
+        result.stages[name] = stage;
+    }
+
+    return result;
+}
+
+std::vector<ScenarioResult> ScenarioBenchmark::runMatrix(
+    const std::vector<std::string>& scenarios,
+    const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+    const std::vector<int>& threads,
+    uint32_t warmupSteps,
+    uint32_t steps,
+    const std::function<void(const ScenarioResult&)>& onResult) const
+{
+    std::vector<ScenarioResult> results;
+    for (const auto& scenario : scenarios) {
+        if (!registry_.getMetadata(scenario)) {
+            spdlog::error("Bench: Unknown scenario '{}', skipping", scenario);
+            continue;
+        }
+
+        for (const auto& [width, height] : sizes) {
+            for (const int threadCount : threads) {
+                const ScenarioRun config{
+                    .scenario = scenario,
+                    .width = width,
+                    .height = height,
+                    .threads = threadCount,
+                    .openmp = true,
+                    .warmupSteps = warmupSteps,
+                    .steps = steps,
+                };
+
+                auto result = run(config);
+                if (!result) {
+                    continue;
+                }
+
+                if (onResult) {
+                    onResult(*result);
+                }
+                results.push_back(std::move(*result));
+            }
+        }
+    }
+    return results;
+}
+
+std::vector<ScenarioResult> ScenarioBenchmark::runScalingSweep(
+    const std::vector<std::string>& scenarios,
+    const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+    const std::vector<int>& threads,
+    uint32_t warmupSteps,
+    uint32_t steps,
+    const std::function<void(const ScenarioResult&)>& onResult) const
+{
+    std::vector<ScenarioResult> results;
+    for (const auto& scenario : scenarios) {
+        if (!registry_.getMetadata(scenario)) {
+            spdlog::error("Bench: Unknown scenario '{}', skipping", scenario);
+            continue;
+        }
+
+        for (const auto& [width, height] : sizes) {
+            ScenarioRun config{
+                .scenario = scenario,
+                .width = width,
+                .height = height,
+                .threads = 1,
+                .openmp = false,
+                .warmupSteps = warmupSteps,
+                .steps = steps,
+            };
+            auto serial = run(config);
+            if (!serial) {
+                continue;
+            }
+            if (onResult) {
+                onResult(*serial);
+            }
+            results.push_back(std::move(*serial));
+
+            config.openmp = true;
+            for (const int threadCount : threads) {
+                config.threads = threadCount;
+                auto result = run(config);
+                if (!result) {
+                    continue;
+                }
+                if (onResult) {
+                    onResult(*result);
+                }
+                results.push_back(std::move(*result));
+            }
+        }
+    }
+    return results;
+}
+
+} // namespace Bench
+} // namespace DirtSim
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "BenchmarkResults.h"
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+class ScenarioRegistry;
+
+namespace DirtSim {
+namespace Bench {
+
+/**
+ * @brief One scenario run: world size, OpenMP team size and step counts.
+ */
+struct ScenarioRun {
+    std::string scenario;
+    uint32_t width = 0; // 0 = the scenario's required size, else 100.
+    uint32_t height = 0;
+    int threads = 1;
+    bool openmp = true;
+    uint32_t warmupSteps = 20;
+    uint32_t steps = 200;
+};
+
+/**
+ * @brief Steps registered scenarios in-process, timing each World stage.
+ *
+ * Unlike the cli benchmark there is no server process, WebSocket or status polling: the
+ * scenario and World are driven directly, the same way SimRunning::tick() does, and each
+ * step is timed individually. Warmup steps are excluded from every number.
+ */
+class ScenarioBenchmark {
+public:
+    static constexpr double TIMESTEP_SECONDS = 0.016; // Matches SimRunning.
+    static constexpr uint32_t DEFAULT_SIZE = 100;
+
+    explicit ScenarioBenchmark(const ScenarioRegistry& registry);
+
+    // Nullopt if the scenario is not registered.
+    std::optional<ScenarioResult> run(const ScenarioRun& run) const;
+
+    // Every combination, scenario-major. Unknown scenarios are skipped with an error;
+    // onResult (optional) reports progress per run.
+    std::vector<ScenarioResult> runMatrix(
+        const std::vector<std::string>& scenarios,
+        const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+        const std::vector<int>& threads,
+        uint32_t warmupSteps,
+        uint32_t steps,
+        const std::function<void(const ScenarioResult&)>& onResult = {}) const;
+
+    // Like runMatrix, but each scenario x size also gets a serial run (USE_OPENMP off, one
+    // thread) first, as the reference for ScalingReport.
+    std::vector<ScenarioResult> runScalingSweep(
+        const std::vector<std::string>& scenarios,
+        const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+        const std::vector<int>& threads,
+        uint32_t warmupSteps,
+        uint32_t steps,
+        const std::function<void(const ScenarioResult&)>& onResult = {}) const;
+
+private:
+    const ScenarioRegistry& registry_;
+};
+
+} // namespace Bench
+} // namespace DirtSim
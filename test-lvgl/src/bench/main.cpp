@@ -0,0 +1,413 @@
+#include "BaselineComparison.h"
+#include "BenchmarkResults.h"
+#include "CalculatorBenchmark.h"
+#include "ScalingReport.h"
+#include "ScenarioBenchmark.h"
+#include "server/scenarios/ScenarioRegistry.h"
+#include <algorithm>
+#include <args.hxx>
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace DirtSim;
+
+namespace {
+
+std::vector<std::string> splitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= list.size()) {
+        const size_t end = std::min(list.find(',', start), list.size());
+        if (end > start) {
+            items.push_back(list.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return items;
+}
+
+std::optional<uint32_t> parseUint(std::string_view text)
+{
+    uint32_t value = 0;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || ptr != text.data() + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// "native" (0x0 = scenario's own size), "N" (square) or "WxH".
+std::optional<std::pair<uint32_t, uint32_t>> parseSize(const std::string& text)
+{
+    if (text == "native") {
+        return std::pair<uint32_t, uint32_t>{ 0, 0 };
+    }
+
+    const size_t separator = text.find('x');
+    if (separator == std::string::npos) {
+        const auto size = parseUint(text);
+        if (!size || *size == 0) {
+            return std::nullopt;
+        }
+        return std::pair<uint32_t, uint32_t>{ *size, *size };
+    }
+
+    const auto width = parseUint(std::string_view(text).substr(0, separator));
+    const auto height = parseUint(std::string_view(text).substr(separator + 1));
+    if (!width || !height || *width == 0 || *height == 0) {
+        return std::nullopt;
+    }
+    return std::pair<uint32_t, uint32_t>{ *width, *height };
+}
+
+int maxThreads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+bool contains(const std::vector<std::string>& list, const std::string& item)
+{
+    return std::find(list.begin(), list.end(), item) != list.end();
+}
+
+void printDifferences(const char* label, const std::vector<Bench::Difference>& differences)
+{
+    for (const auto& difference : differences) {
+        std::cerr << label << " " << difference.key << " " << difference.stage << ": "
+                  << difference.baselineMs << " -> " << difference.currentMs << " ms ("
+                  << (difference.change >= 0.0 ? "+" : "") << difference.change * 100.0 << "%)\n";
+    }
+}
+
+// To the --output file if given, else stdout.
+bool writeJson(const nlohmann::json& json, args::ValueFlag<std::string>& outputArg)
+{
+    const std::string text = json.dump(2);
+    if (!outputArg) {
+        std::cout << text << std::endl;
+        return true;
+    }
+
+    std::ofstream file(args::get(outputArg));
+    file << text << "\n";
+    if (!file.good()) {
+        std::cerr << "Failed to write " << args::get(outputArg) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // Results go to stdout, logs to stderr.
+    auto logger = spdlog::stderr_color_mt("bench");
+    spdlog::set_default_logger(logger);
+
+    args::ArgumentParser parser(
+        "Sparkle Duck in-process benchmark",
+        "Steps scenarios directly (no server) across a scenario x size x thread matrix and "
+        "reports per-stage timings as JSON. With --kernels, times individual physics "
+        "calculators on synthetic grids instead.");
+    args::HelpFlag help(parser, "help", "Display this help menu", { 'h', "help" });
+    args::Flag verbose(parser, "verbose", "Log simulation output too", { 'v', "verbose" });
+    args::ValueFlag<std::string> scenariosArg(
+        parser,
+        "list",
+        "Comma-separated scenario IDs",
+        { "scenarios" },
+        "benchmark,dam_break,raining,sandbox,tree_germination");
+    args::ValueFlag<std::string> sizesArg(
+        parser,
+        "list",
+        "Comma-separated world sizes: native, sweep (50..1000), N or WxH (default: native)",
+        { "sizes" },
+        "native");
+    args::ValueFlag<std::string> threadsArg(
+        parser,
+        "list",
+        "Comma-separated OpenMP thread counts, max, or sweep (1, 2, 4... max) (default: 1,max)",
+        { "threads" },
+        "1,max");
+    args::ValueFlag<uint32_t> warmupArg(
+        parser, "steps", "Unmeasured steps before timing (default: 20)", { "warmup" }, 20);
+    args::ValueFlag<uint32_t> stepsArg(
+        parser, "steps", "Measured steps per run (default: 200)", { "steps" }, 200);
+    args::Flag scalingFlag(
+        parser,
+        "scaling",
+        "Report speedup and parallel efficiency per stage against a serial run (defaults: "
+        "--scenarios sandbox --sizes sweep --threads sweep)",
+        { "scaling" });
+    args::ValueFlag<double> efficiencyArg(
+        parser,
+        "fraction",
+        "Flag stages whose parallel efficiency is below this (default: 0.5)",
+        { "efficiency-threshold" },
+        0.5);
+    args::ValueFlag<std::string> kernelsArg(
+        parser,
+        "list",
+        "Microbenchmark these calculator kernels (comma-separated, or all) instead of scenarios",
+        { "kernels" });
+    args::ValueFlag<std::string> mixArg(
+        parser,
+        "name",
+        "Kernel grid material mix: dirt, sand, water or mixed (default: mixed)",
+        { "mix" },
+        "mixed");
+    args::ValueFlag<double> densityArg(
+        parser, "fraction", "Kernel grid fill density (default: 0.6)", { "density" }, 0.6);
+    args::ValueFlag<double> motionArg(
+        parser,
+        "speed",
+        "Kernel grid max velocity per axis, cells/s (default: 1.0)",
+        { "motion" },
+        1.0);
+    args::ValueFlag<uint32_t> iterationsArg(
+        parser,
+        "count",
+        "Timed iterations per kernel and size (default: 50)",
+        { "iterations" },
+        50);
+    args::ValueFlag<std::string> outputArg(
+        parser, "file", "Write results JSON here instead of stdout", { 'o', "output" });
+    args::ValueFlag<std::string> baselineArg(
+        parser,
+        "file",
+        "Compare against this results file; exit 1 on regressions",
+        { "baseline" });
+    args::ValueFlag<double> toleranceArg(
+        parser,
+        "fraction",
+        "Relative slowdown that counts as a regression (default: 0.10)",
+        { "tolerance" },
+        0.10);
+    args::ValueFlag<double> minDeltaArg(
+        parser,
+        "ms",
+        "Ignore changes smaller than this many ms per step (default: 0.05)",
+        { "min-delta-ms" },
+        0.05);
+
+    try {
+        parser.ParseCLI(argc, argv);
+    }
+    catch (const args::Help&) {
+        std::cout << parser;
+        return 0;
+    }
+    catch (const args::ParseError& e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 2;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    if (verbose) {
+        spdlog::set_level(spdlog::level::info);
+    }
+
+    const bool scaling = args::get(scalingFlag);
+    const std::string scenarioList =
+        scaling && !scenariosArg ? std::string("sandbox") : args::get(scenariosArg);
+    const std::string sizeList =
+        scaling && !sizesArg ? std::string("sweep") : args::get(sizesArg);
+    const std::string threadList =
+        scaling && !threadsArg ? std::string("sweep") : args::get(threadsArg);
+
+    std::vector<std::pair<uint32_t, uint32_t>> sizes;
+    for (const auto& text : splitList(sizeList)) {
+        if (text == "sweep") {
+            for (const uint32_t side : { 50u, 100u, 200u, 500u, 1000u }) {
+                sizes.emplace_back(side, side);
+            }
+            continue;
+        }
+        const auto size = parseSize(text);
+        if (!size) {
+            std::cerr << "Invalid size: " << text << std::endl;
+            return 2;
+        }
+        sizes.push_back(*size);
+    }
+
+    std::vector<int> threads;
+    auto addThreads = [&threads](int count) {
+        if (std::find(threads.begin(), threads.end(), count) == threads.end()) {
+            threads.push_back(count);
+        }
+    };
+    for (const auto& text : splitList(threadList)) {
+        if (text == "sweep") {
+            for (int count = 1; count < maxThreads(); count *= 2) {
+                addThreads(count);
+            }
+            addThreads(maxThreads());
+            continue;
+        }
+        const auto count = text == "max" ? std::optional<uint32_t>(maxThreads()) : parseUint(text);
+        if (!count || *count == 0) {
+            std::cerr << "Invalid thread count: " << text << std::endl;
+            return 2;
+        }
+        addThreads(static_cast<int>(*count));
+    }
+
+    if (kernelsArg) {
+        std::vector<std::string> kernels = splitList(args::get(kernelsArg));
+        if (contains(kernels, "all")) {
+            kernels = Bench::CalculatorBenchmark::kernelNames();
+        }
+        for (const auto& kernel : kernels) {
+            if (!contains(Bench::CalculatorBenchmark::kernelNames(), kernel)) {
+                std::cerr << "Unknown kernel: " << kernel << std::endl;
+                return 2;
+            }
+        }
+        if (!contains(Bench::CalculatorBenchmark::mixNames(), args::get(mixArg))) {
+            std::cerr << "Unknown mix: " << args::get(mixArg) << std::endl;
+            return 2;
+        }
+
+        // Scenarios have a native size, synthetic grids do not: sweep 50 to 400 instead.
+        std::vector<std::pair<uint32_t, uint32_t>> kernelSizes;
+        for (const auto& size : sizes) {
+            if (size.first == 0) {
+                for (const uint32_t side : { 50u, 100u, 200u, 400u }) {
+                    kernelSizes.emplace_back(side, side);
+                }
+            }
+            else {
+                kernelSizes.push_back(size);
+            }
+        }
+
+        const Bench::GridSpec spec{
+            .width = 0, // Set per size.
+            .height = 0,
+            .density = std::clamp(args::get(densityArg), 0.0, 1.0),
+            .mix = args::get(mixArg),
+            .motion = args::get(motionArg),
+            .seed = 42,
+        };
+        const auto results = Bench::CalculatorBenchmark::runMatrix(
+            kernels, kernelSizes, spec, args::get(warmupArg), args::get(iterationsArg));
+        for (const auto& result : results) {
+            std::cerr << result.kernel << " " << result.width << "x" << result.height << ": "
+                      << result.ns_per_cell << " ns/cell (" << result.ns_per_active_cell
+                      << " ns/active cell, x" << result.scaling << " vs smallest)" << std::endl;
+        }
+        return writeJson(Bench::kernelResultsToJson(results), outputArg) ? 0 : 2;
+    }
+
+    const ScenarioRegistry registry = ScenarioRegistry::createDefault();
+    const Bench::ScenarioBenchmark benchmark(registry);
+    const auto printResult = [](const Bench::ScenarioResult& result) {
+        std::cerr << Bench::resultKey(result) << ": " << result.step_avg_ms << " ms/step (p95 "
+                  << result.step_p95_ms << ", " << result.steps_per_sec << " steps/s)"
+                  << std::endl;
+    };
+
+    if (scaling) {
+        const auto results = benchmark.runScalingSweep(
+            splitList(scenarioList),
+            sizes,
+            threads,
+            args::get(warmupArg),
+            args::get(stepsArg),
+            printResult);
+        const auto points = Bench::ScalingReport::build(results, args::get(efficiencyArg));
+
+        size_t flagged = 0;
+        for (const auto& point : points) {
+            std::cerr << point.scenario << "/" << point.width << "x" << point.height << "/t"
+                      << point.threads << ": speedup " << point.step.speedup << ", efficiency "
+                      << point.step.efficiency
+                      << (point.below_parallel_cutoff ? " (below parallel cutoff)" : "")
+                      << std::endl;
+            for (const auto& [name, stage] : point.stages) {
+                if (!stage.flagged) {
+                    continue;
+                }
+                ++flagged;
+                std::cerr << "  LOW EFFICIENCY " << name << ": " << stage.serial_ms << " -> "
+                          << stage.parallel_ms << " ms (speedup " << stage.speedup
+                          << ", efficiency " << stage.efficiency << ")" << std::endl;
+            }
+        }
+        std::cerr << flagged << " stage(s) below " << args::get(efficiencyArg) * 100.0
+                  << "% efficiency" << std::endl;
+        return writeJson(Bench::ScalingReport::toJson(points), outputArg) ? 0 : 2;
+    }
+
+    const auto results = benchmark.runMatrix(
+        splitList(scenarioList),
+        sizes,
+        threads,
+        args::get(warmupArg),
+        args::get(stepsArg),
+        printResult);
+
+    if (!writeJson(Bench::resultsToJson(results), outputArg)) {
+        return 2;
+    }
+
+    if (!baselineArg) {
+        return 0;
+    }
+
+    std::ifstream baselineFile(args::get(baselineArg));
+    if (!baselineFile) {
+        std::cerr << "Failed to open baseline " << args::get(baselineArg) << std::endl;
+        return 2;
+    }
+
+    std::vector<Bench::ScenarioResult> baseline;
+    try {
+        baseline = Bench::resultsFromJson(nlohmann::json::parse(baselineFile));
+    }
+    catch (const nlohmann::json::exception& e) {
+        std::cerr << "Invalid baseline " << args::get(baselineArg) << ": " << e.what()
+                  << std::endl;
+        return 2;
+    }
+
+    const Bench::Tolerance tolerance{
+        .relative = args::get(toleranceArg),
+        .absoluteMs = args::get(minDeltaArg),
+    };
+    const Bench::Comparison comparison =
+        Bench::compareToBaseline(baseline, results, tolerance);
+
+    printDifferences("REGRESSION", comparison.regressions);
+    printDifferences("improved  ", comparison.improvements);
+    for (const auto& key : comparison.missing) {
+        std::cerr << "no baseline " << key << "\n";
+    }
+    std::cerr << (comparison.passed() ? "PASS" : "FAIL") << ": "
+              << comparison.regressions.size() << " regressions, "
+              << comparison.improvements.size() << " improvements (tolerance "
+              << tolerance.relative * 100.0 << "%, " << tolerance.absoluteMs << " ms)"
+              << std::endl;
+
+    return comparison.passed() ? 0 : 1;
+}
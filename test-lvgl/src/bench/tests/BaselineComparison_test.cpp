@@ -0,0 +1,74 @@
+#include "bench/BaselineComparison.h"
+#include "bench/BenchmarkResults.h"
+#include <gtest/gtest.h>
+
+using namespace DirtSim::Bench;
+
+namespace {
+
+ScenarioResult makeResult(double stepMs, double forcesMs)
+{
+    ScenarioResult result;
+    result.scenario = "sandbox";
+    result.width = 100;
+    result.height = 100;
+    result.threads = 4;
+    result.steps = 200;
+    result.step_avg_ms = stepMs;
+    result.stages["resolve_forces"] = StageResult{
+        .calls = 200,
+        .total_ms = forcesMs * 200,
+        .per_step_ms = forcesMs,
+    };
+    return result;
+}
+
+} // namespace
+
+TEST(BaselineComparisonTest, ResultsRoundTripThroughJson)
+{
+    const std::vector<ScenarioResult> results = { makeResult(2.5, 1.0) };
+
+    const auto loaded = resultsFromJson(resultsToJson(results));
+
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(resultKey(loaded[0]), "sandbox/100x100/t4");
+    EXPECT_DOUBLE_EQ(loaded[0].step_avg_ms, 2.5);
+    EXPECT_DOUBLE_EQ(loaded[0].stages.at("resolve_forces").per_step_ms, 1.0);
+}
+
+TEST(BaselineComparisonTest, FlagsOnlyChangesBeyondBothTolerances)
+{
+    const Tolerance tolerance{ .relative = 0.10, .absoluteMs = 0.05 };
+
+    // Step +4% (within tolerance), stage +50%.
+    Comparison comparison =
+        compareToBaseline({ makeResult(2.5, 1.0) }, { makeResult(2.6, 1.5) }, tolerance);
+    ASSERT_EQ(comparison.regressions.size(), 1u);
+    EXPECT_EQ(comparison.regressions[0].stage, "resolve_forces");
+    EXPECT_NEAR(comparison.regressions[0].change, 0.5, 1e-9);
+    EXPECT_FALSE(comparison.passed());
+
+    // +100% on a 0.01ms stage is below the absolute floor.
+    comparison =
+        compareToBaseline({ makeResult(2.5, 0.01) }, { makeResult(2.5, 0.02) }, tolerance);
+    EXPECT_TRUE(comparison.passed());
+    EXPECT_TRUE(comparison.improvements.empty());
+
+    // Faster is reported but passes.
+    comparison = compareToBaseline({ makeResult(2.5, 1.0) }, { makeResult(1.5, 0.5) }, tolerance);
+    EXPECT_TRUE(comparison.passed());
+    EXPECT_EQ(comparison.improvements.size(), 2u);
+}
+
+TEST(BaselineComparisonTest, ReportsMatrixCellsMissingFromBaseline)
+{
+    ScenarioResult other = makeResult(2.5, 1.0);
+    other.threads = 1;
+
+    const Comparison comparison = compareToBaseline({ other }, { makeResult(2.5, 1.0) }, {});
+
+    EXPECT_TRUE(comparison.passed());
+    ASSERT_EQ(comparison.missing.size(), 1u);
+    EXPECT_EQ(comparison.missing[0], "sandbox/100x100/t4");
+}
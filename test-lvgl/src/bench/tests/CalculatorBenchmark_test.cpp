@@ -0,0 +1,41 @@
+#include "bench/CalculatorBenchmark.h"
+#include <gtest/gtest.h>
+
+using namespace DirtSim::Bench;
+
+TEST(CalculatorBenchmarkTest, EveryKernelRunsOnSmallGrid)
+{
+    GridSpec spec;
+    spec.width = 12;
+    spec.height = 10;
+
+    for (const auto& kernel : CalculatorBenchmark::kernelNames()) {
+        const auto result = CalculatorBenchmark::run(kernel, spec, 1, 2);
+        ASSERT_TRUE(result.has_value()) << kernel;
+        EXPECT_EQ(result->kernel, kernel);
+        EXPECT_EQ(result->iterations, 2u);
+        EXPECT_GT(result->active_cells, 0u) << kernel;
+        EXPECT_GE(result->ns_per_cell, 0.0) << kernel;
+        EXPECT_LE(result->min_ms, result->avg_ms) << kernel;
+    }
+}
+
+TEST(CalculatorBenchmarkTest, RejectsUnknownKernelOrMix)
+{
+    GridSpec spec;
+    EXPECT_FALSE(CalculatorBenchmark::run("no_such_kernel", spec, 0, 1).has_value());
+
+    spec.mix = "lava";
+    EXPECT_FALSE(CalculatorBenchmark::run("adhesion", spec, 0, 1).has_value());
+}
+
+TEST(CalculatorBenchmarkTest, MatrixScalesRelativeToFirstSize)
+{
+    GridSpec spec;
+    const auto results =
+        CalculatorBenchmark::runMatrix({ "grid_build" }, { { 10, 10 }, { 20, 20 } }, spec, 0, 1);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_DOUBLE_EQ(results[0].scaling, 1.0);
+    EXPECT_EQ(results[1].width, 20u);
+}
@@ -0,0 +1,66 @@
+#include "bench/ScalingReport.h"
+#include <gtest/gtest.h>
+
+using namespace DirtSim::Bench;
+
+namespace {
+
+ScenarioResult makeResult(int threads, bool openmp, double stepMs, double forcesMs)
+{
+    ScenarioResult result;
+    result.scenario = "sandbox";
+    result.width = 100;
+    result.height = 100;
+    result.threads = threads;
+    result.openmp = openmp;
+    result.steps = 100;
+    result.step_avg_ms = stepMs;
+    result.stages["resolve_forces"] = StageResult{
+        .calls = 100,
+        .total_ms = forcesMs * 100,
+        .per_step_ms = forcesMs,
+    };
+    return result;
+}
+
+} // namespace
+
+TEST(ScalingReportTest, ComputesSpeedupAndEfficiencyAgainstSerialRun)
+{
+    const std::vector<ScenarioResult> results = {
+        makeResult(1, false, 8.0, 4.0),
+        makeResult(4, true, 2.5, 2.0),
+    };
+
+    const auto points = ScalingReport::build(results, 0.6);
+
+    ASSERT_EQ(points.size(), 1u);
+    EXPECT_EQ(points[0].threads, 4);
+    EXPECT_FALSE(points[0].below_parallel_cutoff);
+    EXPECT_NEAR(points[0].step.speedup, 3.2, 1e-9);
+    EXPECT_NEAR(points[0].step.efficiency, 0.8, 1e-9);
+    EXPECT_FALSE(points[0].step.flagged);
+
+    // 2x on four threads is 50% efficient, below the 60% threshold.
+    const StageScaling& forces = points[0].stages.at("resolve_forces");
+    EXPECT_DOUBLE_EQ(forces.speedup, 2.0);
+    EXPECT_DOUBLE_EQ(forces.efficiency, 0.5);
+    EXPECT_TRUE(forces.flagged);
+}
+
+TEST(ScalingReportTest, SkipsResultsWithoutSerialReferenceAndMarksCutoff)
+{
+    ScenarioResult small = makeResult(1, false, 1.0, 0.5);
+    small.width = 40;
+    small.height = 40;
+    ScenarioResult smallParallel = makeResult(2, true, 1.0, 0.5);
+    smallParallel.width = 40;
+    smallParallel.height = 40;
+
+    const auto points =
+        ScalingReport::build({ small, smallParallel, makeResult(2, true, 1.0, 0.5) }, 0.5);
+
+    ASSERT_EQ(points.size(), 1u);
+    EXPECT_EQ(points[0].width, 40u);
+    EXPECT_TRUE(points[0].below_parallel_cutoff);
+}
@@ -0,0 +1,40 @@
+#include "bench/ScenarioBenchmark.h"
+#include "core/GridOfCells.h"
+#include "server/scenarios/ScenarioRegistry.h"
+#include <gtest/gtest.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace DirtSim;
+using namespace DirtSim::Bench;
+
+TEST(ScenarioBenchmarkTest, RunRestoresProcessParallelism)
+{
+    const ScenarioRegistry registry = ScenarioRegistry::createDefault();
+    const ScenarioBenchmark benchmark(registry);
+
+#ifdef _OPENMP
+    const int threadsBefore = omp_get_max_threads();
+#endif
+    const bool openmpBefore = GridOfCells::USE_OPENMP;
+
+    ScenarioRun run;
+    run.scenario = "empty";
+    run.width = 20;
+    run.height = 20;
+    run.threads = 3;
+    run.openmp = !openmpBefore;
+    run.warmupSteps = 1;
+    run.steps = 2;
+
+    const auto result = benchmark.run(run);
+    ASSERT_TRUE(result.has_value());
+
+#ifdef _OPENMP
+    EXPECT_EQ(result->threads, 3);
+    EXPECT_EQ(omp_get_max_threads(), threadsBefore);
+#endif
+    EXPECT_EQ(GridOfCells::USE_OPENMP, openmpBefore);
+}
@@ -6,6 +6,7 @@
 #include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <numeric>
 #include <spdlog/spdlog.h>
 #include <thread>
@@ -88,6 +89,8 @@ BenchmarkResults BenchmarkRunner::run(
         }
     }
 
+    startTrace();
+
     // Poll state_get until simulation completes.
     int timeoutSec = (steps * 50) / 1000 + 10;
     bool benchmarkComplete = false;
@@ -104,7 +107,7 @@ BenchmarkResults BenchmarkRunner::run(
 
         // Poll current step using lightweight status_get (not state_get).
         nlohmann::json statusGetCmd = { { "command", "status_get" } };
-        std::string response = client_.sendAndReceive(statusGetCmd.dump(), 1000);
+        std::string response = client_.sendCommandAndReceive(statusGetCmd, 1000);
 
         if (response.empty()) {
             // Response timeout or error - continue polling.
@@ -154,6 +157,8 @@ BenchmarkResults BenchmarkRunner::run(
     auto benchmarkEnd = std::chrono::steady_clock::now();
     results.duration_sec = std::chrono::duration<double>(benchmarkEnd - benchmarkStart).count();
 
+    stopTrace();
+
     if (!benchmarkComplete) {
         spdlog::error("BenchmarkRunner: Benchmark did not complete");
         client_.disconnect();
@@ -405,6 +410,66 @@ BenchmarkResults BenchmarkRunner::runWithServerArgs(
     return results;
 }
 
+void BenchmarkRunner::setTraceFile(const std::string& path)
+{
+    traceFile_ = path;
+}
+
+void BenchmarkRunner::startTrace()
+{
+    if (traceFile_.empty()) {
+        return;
+    }
+
+    nlohmann::json cmd = { { "command", "trace_start" } };
+    std::string response = client_.sendAndReceive(cmd.dump(), 2000);
+    try {
+        nlohmann::json json = nlohmann::json::parse(response);
+        if (json.contains("error")) {
+            spdlog::error(
+                "BenchmarkRunner: trace_start failed: {}", json["error"].get<std::string>());
+        }
+    }
+    catch (const std::exception& e) {
+        spdlog::error("BenchmarkRunner: Failed to parse trace_start response: {}", e.what());
+    }
+}
+
+void BenchmarkRunner::stopTrace()
+{
+    if (traceFile_.empty()) {
+        return;
+    }
+
+    // The trace comes back inline so it lands next to the CLI, wherever the server runs.
+    nlohmann::json cmd = { { "command", "trace_stop" } };
+    std::string response = client_.sendAndReceive(cmd.dump(), 10000);
+    try {
+        nlohmann::json json = nlohmann::json::parse(response);
+        if (json.contains("error")) {
+            spdlog::error(
+                "BenchmarkRunner: trace_stop failed: {}", json["error"].get<std::string>());
+            return;
+        }
+
+        const auto& value = json["value"];
+        std::ofstream file(traceFile_);
+        file << value["trace"].dump();
+        if (!file.good()) {
+            spdlog::error("BenchmarkRunner: Failed to write trace to {}", traceFile_);
+            return;
+        }
+        spdlog::info(
+            "BenchmarkRunner: Wrote {} trace events to {} ({} dropped)",
+            value.value("event_count", uint64_t{ 0 }),
+            traceFile_,
+            value.value("dropped_events", uint64_t{ 0 }));
+    }
+    catch (const std::exception& e) {
+        spdlog::error("BenchmarkRunner: Failed to parse trace_stop response: {}", e.what());
+    }
+}
+
 nlohmann::json BenchmarkRunner::queryPerfStats()
 {
     nlohmann::json cmd = { { "command", "perf_stats_get" } };
@@ -60,13 +60,23 @@ public:
         const std::string& serverArgs,
         int worldSize = 0);
 
+    /**
+     * @brief Record a Chrome/Perfetto trace of the measured steps into this file.
+     * Empty (the default) disables tracing.
+     */
+    void setTraceFile(const std::string& path);
+
 private:
     SubprocessManager subprocessManager_;
     WebSocketClient client_;
+    std::string traceFile_;
 
     bool waitForCompletion(uint32_t targetSteps, int timeoutSec);
 
     nlohmann::json queryPerfStats();
+
+    void startTrace();
+    void stopTrace();
 };
 
 } // namespace Client
@@ -2,6 +2,7 @@
 #include "core/MsgPackAdapter.h"
 #include "core/ReflectSerializer.h"
 #include "core/WorldData.h"
+#include "server/api/StateGet.h"
 #include <chrono>
 #include <spdlog/spdlog.h>
 #include <thread>
@@ -10,6 +11,25 @@
 namespace DirtSim {
 namespace Client {
 
+namespace {
+
+// Interned once at startup so per-frame timing skips the name lookup.
+const Timers::TimerId TIMER_BINARY_DESERIALIZE = Timers::intern("binary_deserialize");
+const Timers::TimerId TIMER_BINARY_WORLDDATA_PROCESSING =
+    Timers::intern("binary_worlddata_processing");
+const Timers::TimerId TIMER_JSON_CONVERSION = Timers::intern("json_conversion");
+
+// Commands go out as MessagePack binary frames (same map layout as the JSON form).
+rtc::binary encodeCommand(const nlohmann::json& command)
+{
+    msgpack::sbuffer buffer;
+    msgpack::pack(buffer, command);
+    const auto* bytes = reinterpret_cast<const std::byte*>(buffer.data());
+    return rtc::binary(bytes, bytes + buffer.size());
+}
+
+} // namespace
+
 WebSocketClient::WebSocketClient() : responseReceived_(false), connectionFailed_(false)
 {}
 
@@ -56,43 +76,67 @@ bool WebSocketClient::connect(const std::string& url)
                 }
             }
             else if (std::holds_alternative<rtc::binary>(data)) {
-                // Binary message (WorldData push) - no correlation ID.
                 const auto& binaryData = std::get<rtc::binary>(data);
-                spdlog::debug(
-                    "WebSocketClient: Received binary push ({} bytes)", binaryData.size());
-
-                // Optimization: Skip processing if no callback registered.
-                // Binary WorldData pushes are unsolicited and only needed for async callbacks.
-                // Benchmark mode doesn't use callbacks, so skip expensive JSON conversion.
-                if (!messageCallback_) {
-                    spdlog::trace("WebSocketClient: Dropping binary push (no callback)");
-                    return;
+
+                // Binary state_get replies are tagged with a magic and correlation ID.
+                uint32_t magic = 0;
+                uint64_t id = 0;
+                zpp::bits::in header(binaryData);
+                const bool isStateGetReply = !zpp::bits::failure(header(magic, id))
+                    && magic == Api::StateGet::BINARY_RESPONSE_MAGIC;
+
+                if (isStateGetReply) {
+                    spdlog::debug(
+                        "WebSocketClient: Received binary state_get reply ({} bytes, id={})",
+                        binaryData.size(),
+                        id);
+                    correlationId = id;
+                }
+                else {
+                    // Binary message (WorldData push) - no correlation ID.
+                    spdlog::debug(
+                        "WebSocketClient: Received binary push ({} bytes)", binaryData.size());
+
+                    // Optimization: Skip processing if no callback registered.
+                    // Binary WorldData pushes are unsolicited and only needed for async callbacks.
+                    // Benchmark mode doesn't use callbacks, so skip expensive JSON conversion.
+                    if (!messageCallback_) {
+                        spdlog::trace("WebSocketClient: Dropping binary push (no callback)");
+                        return;
+                    }
                 }
 
-                timers_.startTimer("binary_worlddata_processing");
+                timers_.startTimer(TIMER_BINARY_WORLDDATA_PROCESSING);
 
                 try {
-                    timers_.startTimer("binary_deserialize");
+                    timers_.startTimer(TIMER_BINARY_DESERIALIZE);
                     // Unpack binary to WorldData using zpp_bits.
                     WorldData worldData;
                     zpp::bits::in in(binaryData);
+                    if (isStateGetReply) {
+                        in(magic, id).or_throw();
+                    }
                     in(worldData).or_throw();
-                    timers_.stopTimer("binary_deserialize");
+                    timers_.stopTimer(TIMER_BINARY_DESERIALIZE);
 
-                    timers_.startTimer("json_conversion");
+                    timers_.startTimer(TIMER_JSON_CONVERSION);
                     // Convert to JSON string for MessageParser compatibility.
-                    nlohmann::json doc;
-                    doc["value"] = ReflectSerializer::to_json(worldData);
-                    message = doc.dump();
-                    timers_.stopTimer("json_conversion");
+                    message = "{";
+                    if (isStateGetReply) {
+                        message += "\"id\":" + std::to_string(id) + ",";
+                    }
+                    message += "\"value\":";
+                    ReflectSerializer::write_json(message, worldData);
+                    message += "}";
+                    timers_.stopTimer(TIMER_JSON_CONVERSION);
                 }
                 catch (const std::exception& e) {
                     spdlog::error("WebSocketClient: Failed to decode binary: {}", e.what());
-                    timers_.stopTimer("binary_worlddata_processing");
+                    timers_.stopTimer(TIMER_BINARY_WORLDDATA_PROCESSING);
                     return;
                 }
 
-                timers_.stopTimer("binary_worlddata_processing");
+                timers_.stopTimer(TIMER_BINARY_WORLDDATA_PROCESSING);
             }
 
             // Route message based on correlation ID.
@@ -183,6 +227,19 @@ bool WebSocketClient::connect(const std::string& url)
 }
 
 std::string WebSocketClient::sendAndReceive(const std::string& message, int timeoutMs)
+{
+    nlohmann::json command;
+    try {
+        command = nlohmann::json::parse(message);
+    }
+    catch (const std::exception& e) {
+        spdlog::error("WebSocketClient: Failed to parse command: {}", e.what());
+        return "";
+    }
+    return sendCommandAndReceive(command, timeoutMs);
+}
+
+std::string WebSocketClient::sendCommandAndReceive(const nlohmann::json& command, int timeoutMs)
 {
     if (!ws_ || !ws_->isOpen()) {
         spdlog::error("WebSocketClient: Not connected");
@@ -192,18 +249,15 @@ std::string WebSocketClient::sendAndReceive(const std::string& message, int time
     // Generate unique correlation ID.
     uint64_t id = nextId_.fetch_add(1);
 
-    // Inject ID into message JSON.
-    std::string messageWithId;
-    try {
-        nlohmann::json json = nlohmann::json::parse(message);
-        json["id"] = id;
-        messageWithId = json.dump();
-    }
-    catch (const std::exception& e) {
-        spdlog::error("WebSocketClient: Failed to inject correlation ID: {}", e.what());
-        return "";
-    }
+    nlohmann::json commandWithId = command;
+    commandWithId["id"] = id;
+
+    spdlog::debug("WebSocketClient: Sending (id={}): {}", id, commandWithId.dump());
+    return sendWithId(id, encodeCommand(commandWithId), timeoutMs);
+}
 
+std::string WebSocketClient::sendWithId(uint64_t id, rtc::message_variant message, int timeoutMs)
+{
     // Create pending request.
     auto pending = std::make_shared<PendingRequest>();
     {
@@ -212,8 +266,7 @@ std::string WebSocketClient::sendAndReceive(const std::string& message, int time
     }
 
     // Send message with correlation ID.
-    spdlog::debug("WebSocketClient: Sending (id={}): {}", id, messageWithId);
-    ws_->send(messageWithId);
+    ws_->send(std::move(message));
 
     // Wait for response with matching ID.
     std::unique_lock<std::mutex> reqLock(pending->mutex);
@@ -245,7 +298,7 @@ bool WebSocketClient::send(const std::string& message)
 
     try {
         spdlog::debug("WebSocketClient: Sending: {}", message);
-        ws_->send(message);
+        ws_->send(encodeCommand(nlohmann::json::parse(message)));
         return true;
     }
     catch (const std::exception& e) {
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <nlohmann/json.hpp>
 #include <rtc/rtc.hpp>
 #include <string>
 
@@ -26,8 +27,16 @@ public:
     ~WebSocketClient();
 
     bool connect(const std::string& url);
+
+    // Commands are JSON text here but always go out as MessagePack binary frames, which the
+    // server and the UI both parse once. Replies come back as JSON text.
     bool send(const std::string& message);
     std::string sendAndReceive(const std::string& message, int timeoutMs = 5000);
+
+    /**
+     * @brief Like sendAndReceive, for a command that is already a document (no text parse).
+     */
+    std::string sendCommandAndReceive(const nlohmann::json& command, int timeoutMs = 5000);
     void disconnect();
     bool isConnected() const;
 
@@ -43,6 +52,8 @@ public:
     Timers& getTimers() { return timers_; }
 
 private:
+    std::string sendWithId(uint64_t id, rtc::message_variant message, int timeoutMs);
+
     Timers timers_; // Performance instrumentation.
     struct PendingRequest {
         std::string response;
@@ -164,6 +164,11 @@ int main(int argc, char** argv)
         "size",
         "Benchmark: world grid size (default: scenario default)",
         { "world-size", "size" });
+    args::ValueFlag<std::string> benchTrace(
+        parser,
+        "file",
+        "Benchmark: write a Chrome trace (open in ui.perfetto.dev) of the run to this file",
+        { "trace" });
     args::Flag compareCache(
         parser,
         "compare-cache",
@@ -274,6 +279,9 @@ int main(int argc, char** argv)
         else {
             // Single run (default behavior).
             Client::BenchmarkRunner runner;
+            if (benchTrace) {
+                runner.setTraceFile(args::get(benchTrace));
+            }
             auto results = runner.run(serverPath.string(), actualSteps, actualScenario);
 
             // Output results as JSON using ReflectSerializer.
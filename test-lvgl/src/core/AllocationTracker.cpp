@@ -0,0 +1,166 @@
+#include "AllocationTracker.h"
+#include <atomic>
+
+#ifdef DIRTSIM_ALLOC_TRACKING
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace {
+
+// Constant-initialized so the hooks never trigger dynamic TLS setup (which may allocate).
+thread_local AllocationTracker::Counts threadTotals;
+
+std::atomic<uint64_t> processAllocations{ 0 };
+std::atomic<uint64_t> processBytes{ 0 };
+std::atomic<uint64_t> processFrees{ 0 };
+
+} // namespace
+
+AllocationTracker::Counts AllocationTracker::threadCounts()
+{
+    return threadTotals;
+}
+
+AllocationTracker::Counts AllocationTracker::processCounts()
+{
+    return Counts{
+        .allocations = processAllocations.load(std::memory_order_relaxed),
+        .bytes = processBytes.load(std::memory_order_relaxed),
+        .frees = processFrees.load(std::memory_order_relaxed),
+    };
+}
+
+void AllocationTracker::recordAllocation(size_t bytes)
+{
+    threadTotals.allocations++;
+    threadTotals.bytes += bytes;
+    processAllocations.fetch_add(1, std::memory_order_relaxed);
+    processBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::recordFree()
+{
+    threadTotals.frees++;
+    processFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+#ifdef DIRTSIM_ALLOC_TRACKING
+
+// Replacement global allocation functions. Everything funnels through malloc/free (or
+// posix_memalign for over-aligned types), so the library's own delete never sees our
+// pointers and vice versa.
+namespace {
+
+void* allocate(std::size_t size)
+{
+    AllocationTracker::recordAllocation(size);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    AllocationTracker::recordAllocation(size);
+    const std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, align, size == 0 ? 1 : size) == 0) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void release(void* ptr) noexcept
+{
+    if (ptr) {
+        AllocationTracker::recordFree();
+        std::free(ptr);
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return allocate(size);
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return allocate(size);
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    release(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    release(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    release(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    release(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    release(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    release(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    release(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    release(ptr);
+}
+
+#endif // DIRTSIM_ALLOC_TRACKING
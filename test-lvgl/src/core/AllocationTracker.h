@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Heap allocation counters fed by a replacement global operator new/delete.
+ *
+ * The hooks are only compiled into the allocation-tracking build flavour
+ * (-DSPARKLE_DUCK_ALLOC_TRACKING=ON, which defines DIRTSIM_ALLOC_TRACKING). Otherwise
+ * isCompiledIn() is false, every count reads zero and Timers skips the bookkeeping.
+ *
+ * Each thread keeps its own counts, so a stage or frame measured on the physics thread is
+ * not polluted by network threads. Allocations made by OpenMP workers inside a parallel
+ * region land on those workers and only show up in processCounts().
+ */
+class AllocationTracker {
+public:
+    struct Counts {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0; // Requested bytes, excluding allocator overhead.
+        uint64_t frees = 0;
+    };
+
+    static constexpr bool isCompiledIn()
+    {
+#ifdef DIRTSIM_ALLOC_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Running totals for the calling thread.
+    static Counts threadCounts();
+
+    // Running totals over all threads.
+    static Counts processCounts();
+
+    // Called by the operator new/delete hooks.
+    static void recordAllocation(size_t bytes);
+    static void recordFree();
+};
+
+inline AllocationTracker::Counts operator-(
+    const AllocationTracker::Counts& end, const AllocationTracker::Counts& start)
+{
+    return AllocationTracker::Counts{
+        .allocations = end.allocations - start.allocations,
+        .bytes = end.bytes - start.bytes,
+        .frees = end.frees - start.frees,
+    };
+}
+
+/**
+ * @brief Allocations made by the calling thread during this object's lifetime.
+ *
+ * Handy for asserting that a code path is allocation-free:
+ *   AllocationScope scope;
+ *   world.advanceTime(0.016);
+ *   EXPECT_EQ(scope.counts().allocations, 0u);
+ */
+class AllocationScope {
+public:
+    AllocationScope() : start_(AllocationTracker::threadCounts()) {}
+
+    AllocationTracker::Counts counts() const
+    {
+        return AllocationTracker::threadCounts() - start_;
+    }
+
+private:
+    AllocationTracker::Counts start_;
+};
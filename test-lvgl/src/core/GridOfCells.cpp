@@ -30,6 +30,21 @@ GridOfCells::GridOfCells(
     spdlog::debug("GridOfCells: Construction complete");
 }
 
+void GridOfCells::rebuild(uint32_t width, uint32_t height)
+{
+    width_ = width;
+    height_ = height;
+    empty_cells_.reset(width, height);
+    wall_cells_.reset(width, height);
+    support_bitmap_.reset(width, height);
+    empty_neighborhoods_.assign(static_cast<size_t>(width) * height, 0);
+    material_neighborhoods_.assign(static_cast<size_t>(width) * height, 0);
+
+    populateMaps();
+    precomputeEmptyNeighborhoods();
+    precomputeMaterialNeighborhoods();
+}
+
 void GridOfCells::populateMaps()
 {
     // Single pass over all cells to build all bitmaps.
@@ -95,31 +110,47 @@ void GridOfCells::precomputeMaterialNeighborhoods()
     // Precompute 3×3 material neighborhood for every cell.
     for (uint32_t y = 0; y < height_; ++y) {
         for (uint32_t x = 0; x < width_; ++x) {
-            uint64_t packed = 0;
-
-            // Pack 9 material types (4 bits each) into uint64_t.
-            for (int dy = -1; dy <= 1; ++dy) {
-                for (int dx = -1; dx <= 1; ++dx) {
-                    int bit_group = (dy + 1) * 3 + (dx + 1); // 0-8
-                    int nx = static_cast<int>(x) + dx;
-                    int ny = static_cast<int>(y) + dy;
-
-                    MaterialType mat = MaterialType::AIR; // Default for OOB.
-                    if (nx >= 0 && nx < static_cast<int>(width_) && ny >= 0
-                        && ny < static_cast<int>(height_)) {
-                        const Cell& cell = cells_[ny * width_ + nx];
-                        mat = cell.material_type;
-                    }
-
-                    // Pack material type (4 bits) into position.
-                    uint64_t mat_bits = static_cast<uint64_t>(mat) & 0xF;
-                    packed |= (mat_bits << (bit_group * 4));
-                }
+            material_neighborhoods_[y * width_ + x] = computeMaterialNeighborhood(x, y);
+        }
+    }
+}
+
+uint64_t GridOfCells::computeMaterialNeighborhood(uint32_t x, uint32_t y) const
+{
+    uint64_t packed = 0;
+
+    // Pack 9 material types (4 bits each) into uint64_t.
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int bit_group = (dy + 1) * 3 + (dx + 1); // 0-8
+            int nx = static_cast<int>(x) + dx;
+            int ny = static_cast<int>(y) + dy;
+
+            MaterialType mat = MaterialType::AIR; // Default for OOB.
+            if (nx >= 0 && nx < static_cast<int>(width_) && ny >= 0
+                && ny < static_cast<int>(height_)) {
+                const Cell& cell = cells_[ny * width_ + nx];
+                mat = cell.material_type;
             }
 
-            material_neighborhoods_[y * width_ + x] = packed;
+            // Pack material type (4 bits) into position.
+            uint64_t mat_bits = static_cast<uint64_t>(mat) & 0xF;
+            packed |= (mat_bits << (bit_group * 4));
         }
     }
+
+    return packed;
+}
+
+size_t GridOfCells::bitmapBytes() const
+{
+    return empty_cells_.memoryBytes() + wall_cells_.memoryBytes() + support_bitmap_.memoryBytes();
+}
+
+size_t GridOfCells::neighborhoodBytes() const
+{
+    return (empty_neighborhoods_.capacity() + material_neighborhoods_.capacity())
+        * sizeof(uint64_t);
 }
 
 } // namespace DirtSim
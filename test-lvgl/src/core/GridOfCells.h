@@ -56,6 +56,7 @@ private:
     void buildWallCellMap();
     void precomputeEmptyNeighborhoods();
     void precomputeMaterialNeighborhoods();
+    uint64_t computeMaterialNeighborhood(uint32_t x, uint32_t y) const;
 
 public:
     GridOfCells(
@@ -64,6 +65,12 @@ public:
         uint32_t width,
         uint32_t height);
 
+    /**
+     * @brief Recompute every map from the current cells for a width × height grid.
+     * Reuses the existing storage, so a per-step rebuild at a fixed size does not allocate.
+     */
+    void rebuild(uint32_t width, uint32_t height);
+
     inline const CellBitmap& emptyCells() const { return empty_cells_; }
     inline const CellBitmap& wallCells() const { return wall_cells_; }
     inline const CellBitmap& supportBitmap() const { return support_bitmap_; }
@@ -106,6 +113,10 @@ public:
 
     inline const std::vector<Cell>& getCells() const { return cells_; }
 
+    // Heap bytes held by the bitmaps (empty, wall, support) and the precomputed neighborhoods.
+    size_t bitmapBytes() const;
+    size_t neighborhoodBytes() const;
+
     // Grid dimensions.
     inline uint32_t getWidth() const { return width_; }
     inline uint32_t getHeight() const { return height_; }
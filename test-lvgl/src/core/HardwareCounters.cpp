@@ -0,0 +1,192 @@
+#include "HardwareCounters.h"
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+std::atomic<bool> HardwareCounters::enabled_{ false };
+
+namespace {
+
+constexpr std::array<uint64_t, HardwareCounters::EVENT_COUNT> EVENT_CONFIGS = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, // Last-level cache on x86 and most ARM cores.
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+struct ThreadGroup {
+    int leaderFd = -1;
+    std::vector<int> fds;
+    std::array<int, HardwareCounters::EVENT_COUNT> slotOf; // Position in the group read.
+};
+
+struct CounterState {
+    std::mutex mutex; // Guards available/warned; never taken by read().
+    std::array<bool, HardwareCounters::EVENT_COUNT> available = {};
+    bool warned = false;
+};
+
+CounterState& state()
+{
+    static CounterState instance;
+    return instance;
+}
+
+// Groups for the enabling thread and its OpenMP team, owned by the enabling thread. Only that
+// thread sums them, so read() needs no lock and other threads see no groups at all.
+thread_local std::vector<ThreadGroup> ownedGroups;
+
+int openCounter(size_t event, int groupFd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = EVENT_CONFIGS[event];
+    attr.exclude_kernel = 1; // Allowed at the default perf_event_paranoid level.
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Calling thread, any CPU.
+    return static_cast<int>(
+        ::syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+bool openGroup(ThreadGroup& group, int& leaderErrno)
+{
+    group.slotOf.fill(-1);
+    for (size_t event = 0; event < HardwareCounters::EVENT_COUNT; ++event) {
+        const int fd = openCounter(event, group.leaderFd);
+        if (fd < 0) {
+            if (group.leaderFd < 0) {
+                leaderErrno = errno;
+            }
+            continue;
+        }
+        if (group.leaderFd < 0) {
+            group.leaderFd = fd;
+        }
+        group.slotOf[event] = static_cast<int>(group.fds.size());
+        group.fds.push_back(fd);
+    }
+    return group.leaderFd >= 0;
+}
+
+} // namespace
+
+bool HardwareCounters::enable()
+{
+    if (ownedGroups.empty()) {
+        std::vector<ThreadGroup> groups;
+        int leaderErrno = 0;
+        ThreadGroup own;
+        if (openGroup(own, leaderErrno)) {
+            groups.push_back(std::move(own));
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+        {
+            // The primary thread is the caller, opened above.
+            if (omp_get_thread_num() != 0) {
+                ThreadGroup worker;
+                int workerErrno = 0;
+                const bool opened = openGroup(worker, workerErrno);
+#pragma omp critical(hardware_counters_enable)
+                {
+                    if (opened) {
+                        groups.push_back(std::move(worker));
+                    }
+                    else if (leaderErrno == 0) {
+                        leaderErrno = workerErrno;
+                    }
+                }
+            }
+        }
+#endif
+
+        auto& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (groups.empty()) {
+            if (!s.warned) {
+                s.warned = true;
+                spdlog::warn(
+                    "HardwareCounters: perf_event_open failed ({}); counters unavailable",
+                    std::strerror(leaderErrno));
+            }
+            return false;
+        }
+        for (const ThreadGroup& group : groups) {
+            for (size_t event = 0; event < EVENT_COUNT; ++event) {
+                s.available[event] = s.available[event] || group.slotOf[event] >= 0;
+            }
+        }
+        ownedGroups = std::move(groups);
+    }
+
+    enabled_.store(true);
+    spdlog::info(
+        "HardwareCounters: Enabled on {} threads (cycles={}, instructions={}, llc_misses={}, "
+        "branch_misses={})",
+        ownedGroups.size(),
+        isAvailable(Cycles),
+        isAvailable(Instructions),
+        isAvailable(LlcMisses),
+        isAvailable(BranchMisses));
+    return true;
+}
+
+void HardwareCounters::disable()
+{
+    enabled_.store(false);
+}
+
+bool HardwareCounters::isAvailable(Event event)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.available[event];
+}
+
+HardwareCounters::Values HardwareCounters::read()
+{
+    Values totals = {};
+    if (!isEnabled()) {
+        return totals;
+    }
+
+    for (const ThreadGroup& group : ownedGroups) {
+        // { nr, time_enabled, time_running, value[nr] }.
+        uint64_t buffer[3 + EVENT_COUNT] = {};
+        if (::read(group.leaderFd, buffer, sizeof(buffer)) <= 0) {
+            continue;
+        }
+
+        const uint64_t count = buffer[0];
+        const uint64_t timeEnabled = buffer[1];
+        const uint64_t timeRunning = buffer[2];
+        if (timeRunning == 0) {
+            continue;
+        }
+        const double scale = static_cast<double>(timeEnabled) / static_cast<double>(timeRunning);
+
+        for (size_t event = 0; event < EVENT_COUNT; ++event) {
+            const int slot = group.slotOf[event];
+            if (slot >= 0 && static_cast<uint64_t>(slot) < count) {
+                const double value = static_cast<double>(buffer[3 + slot]) * scale;
+                totals[event] += static_cast<uint64_t>(value);
+            }
+        }
+    }
+    return totals;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Optional perf_event_open hardware counters, sampled by Timers at scope edges.
+ *
+ * enable() opens one counter group (user space only) per thread: the calling thread and,
+ * when built with OpenMP, every worker of its default team, so parallel stages are
+ * counted too. The groups belong to the calling thread (the physics thread): read() there
+ * sums them without locking, scaling counts when the kernel multiplexed them, and read()
+ * on any other thread returns zeros without touching the counters.
+ * Counters the CPU or kernel refuses are reported as unavailable and read as zero; if
+ * none open (no PMU in a VM, perf_event_paranoid > 2), enable() returns false and every
+ * call stays a no-op.
+ *
+ * Worker threads that spin between parallel regions are counted, as they burn the cycles.
+ */
+class HardwareCounters {
+public:
+    enum Event : size_t { Cycles, Instructions, LlcMisses, BranchMisses, EVENT_COUNT };
+
+    using Values = std::array<uint64_t, EVENT_COUNT>;
+
+    static constexpr std::array<std::string_view, EVENT_COUNT> EVENT_NAMES = {
+        "cycles",
+        "instructions",
+        "llc_misses",
+        "branch_misses",
+    };
+
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Open counters for this thread and its OpenMP team, and make this thread their owner.
+    // False if nothing is countable.
+    static bool enable();
+
+    // Stop sampling. Open groups are kept so a later enable() is cheap.
+    static void disable();
+
+    // Whether a specific event opened (false for all before enable()).
+    static bool isAvailable(Event event);
+
+    // Current totals over the owner's team (zeros when disabled or off the owning thread).
+    static Values read();
+
+private:
+    static std::atomic<bool> enabled_;
+};
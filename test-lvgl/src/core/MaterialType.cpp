@@ -252,6 +252,14 @@ void from_json(const nlohmann::json& j, MaterialType& type)
     throw std::runtime_error("MaterialType::from_json: Unknown material type '" + name + "'");
 }
 
+void append_json(std::string& out, MaterialType type)
+{
+    // Material names are plain identifiers, so no escaping is needed.
+    out += '"';
+    out += getMaterialName(type);
+    out += '"';
+}
+
 void setMaterialCohesion(MaterialType type, double cohesion)
 {
     const auto index = static_cast<size_t>(type);
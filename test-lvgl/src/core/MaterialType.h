@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <msgpack.hpp>
 #include <nlohmann/json.hpp>
+#include <string>
 
 namespace DirtSim {
 
@@ -91,6 +92,11 @@ double getFrictionCoefficient(double velocity_magnitude, const MaterialPropertie
 void to_json(nlohmann::json& j, MaterialType type);
 void from_json(const nlohmann::json& j, MaterialType& type);
 
+/**
+ * Streaming JSON hook for ReflectSerializer::write_json (appends the quoted name).
+ */
+void append_json(std::string& out, MaterialType type);
+
 } // namespace DirtSim
 
 MSGPACK_ADD_ENUM(DirtSim::MaterialType);
\ No newline at end of file
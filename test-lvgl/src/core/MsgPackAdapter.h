@@ -1,9 +1,11 @@
 #pragma once
 
 #include "MaterialType.h"
+#include <cstdint>
 #include <msgpack.hpp>
 #include <nlohmann/json.hpp>
 #include <variant>
+#include <vector>
 
 namespace msgpack {
 MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
@@ -38,6 +40,11 @@ MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
             else if (v.is_string()) {
                 o.pack(v.get<std::string>());
             }
+            else if (v.is_binary()) {
+                const auto& bytes = v.get_binary();
+                o.pack_bin(static_cast<uint32_t>(bytes.size()));
+                o.pack_bin_body(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            }
             else if (v.is_array()) {
                 o.pack_array(static_cast<uint32_t>(v.size()));
                 for (const auto& elem : v) {
@@ -79,6 +86,11 @@ MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
                 case msgpack::type::STR:
                     v = o.as<std::string>();
                     break;
+                case msgpack::type::BIN:
+                    v = nlohmann::json::binary(std::vector<uint8_t>(
+                        reinterpret_cast<const uint8_t*>(o.via.bin.ptr),
+                        reinterpret_cast<const uint8_t*>(o.via.bin.ptr) + o.via.bin.size));
+                    break;
                 case msgpack::type::ARRAY:
                     v = nlohmann::json::array();
                     for (uint32_t i = 0; i < o.via.array.size; ++i) {
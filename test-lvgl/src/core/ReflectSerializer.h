@@ -1,8 +1,14 @@
 #pragma once
 
 #include "reflect.h"
+#include <charconv>
+#include <cmath>
+#include <iterator>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 /**
  * Generic reflection-based JSON serialization for aggregate types.
@@ -15,6 +21,9 @@
  *   Point p{1.5, 2.5};
  *   auto j = ReflectSerializer::to_json(p);
  *   auto p2 = ReflectSerializer::from_json<Point>(j);
+ *
+ * For large payloads (e.g. full WorldData), write_json() streams JSON text
+ * straight into a caller-owned buffer without building a DOM.
  */
 namespace ReflectSerializer {
 
@@ -60,4 +69,188 @@ T from_json(const nlohmann::json& j)
     return obj;
 }
 
+namespace detail {
+
+// Poison pill so the requires-expression below only finds append_json via ADL.
+void append_json() = delete;
+
+template <typename T>
+concept HasAppendJson = requires(std::string& out, const T& value) { append_json(out, value); };
+
+template <typename T>
+struct IsOptional : std::false_type {};
+
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+concept StringLike = std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+concept StringKeyedMap = requires {
+    typename T::key_type;
+    typename T::mapped_type;
+} && StringLike<typename T::key_type>;
+
+template <typename T>
+concept Range = requires(const T& r) {
+    std::begin(r);
+    std::end(r);
+};
+
+inline void appendEscaped(std::string& out, std::string_view text)
+{
+    static constexpr char HEX[] = "0123456789abcdef";
+
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += HEX[(c >> 4) & 0xF];
+                    out += HEX[c & 0xF];
+                }
+                else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        // Match nlohmann: non-finite values are not representable in JSON.
+        if (!std::isfinite(value)) {
+            out += "null";
+            return;
+        }
+    }
+
+    char buf[32];
+    const auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    const std::string_view text(buf, result.ptr);
+    out += text;
+
+    // Keep floats recognizable as floats when re-parsed (nlohmann dumps 1.0, not 1).
+    if constexpr (std::is_floating_point_v<T>) {
+        if (text.find_first_of(".e") == std::string_view::npos) {
+            out += ".0";
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * Append the JSON encoding of value to out without building an nlohmann DOM.
+ *
+ * Aggregates are written member by member in declaration order (nlohmann sorts
+ * keys on dump, so text differs but parses to the same document). Types can
+ * provide a faster encoding with an ADL overload of append_json(out, value).
+ * Anything else (variants, enums without a hook) falls back to nlohmann.
+ */
+template <typename T>
+void write_json(std::string& out, const T& value)
+{
+    if constexpr (detail::HasAppendJson<T>) {
+        append_json(out, value);
+    }
+    else if constexpr (std::is_same_v<T, bool>) {
+        out += value ? "true" : "false";
+    }
+    else if constexpr (std::is_arithmetic_v<T>) {
+        detail::appendNumber(out, value);
+    }
+    else if constexpr (detail::StringLike<T>) {
+        detail::appendEscaped(out, std::string_view(value));
+    }
+    else if constexpr (detail::IsOptional<T>::value) {
+        if (value.has_value()) {
+            write_json(out, *value);
+        }
+        else {
+            out += "null";
+        }
+    }
+    else if constexpr (detail::StringKeyedMap<T>) {
+        out += '{';
+        bool first = true;
+        for (const auto& [key, mapped] : value) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            detail::appendEscaped(out, std::string_view(key));
+            out += ':';
+            write_json(out, mapped);
+        }
+        out += '}';
+    }
+    else if constexpr (detail::Range<T>) {
+        out += '[';
+        bool first = true;
+        for (const auto& element : value) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            write_json(out, element);
+        }
+        out += ']';
+    }
+    else if constexpr (std::is_aggregate_v<T>) {
+        out += '{';
+        reflect::for_each(
+            [&](auto I) {
+                if constexpr (I != 0) {
+                    out += ',';
+                }
+                detail::appendEscaped(out, reflect::member_name<I>(value));
+                out += ':';
+                write_json(out, reflect::get<I>(value));
+            },
+            value);
+        out += '}';
+    }
+    else {
+        out += nlohmann::json(value).dump();
+    }
+}
+
+/**
+ * Serialize value to a JSON string via write_json().
+ */
+template <typename T>
+std::string to_json_string(const T& value)
+{
+    std::string out;
+    write_json(out, value);
+    return out;
+}
+
 } // namespace ReflectSerializer
@@ -0,0 +1,37 @@
+#include "RenderFrame.h"
+#include "WorldData.h"
+#include <stdexcept>
+#include <string>
+
+namespace DirtSim {
+
+RenderFrame::RenderFrame(RenderMessage message) : message_(std::move(message))
+{
+    const size_t cellSize = isDebug() ? sizeof(DebugCell) : sizeof(BasicCell);
+    if (message_.payload.size() < cellCount() * cellSize) {
+        throw std::invalid_argument(
+            "RenderFrame: payload has " + std::to_string(message_.payload.size())
+            + " bytes, expected " + std::to_string(cellCount() * cellSize) + " for "
+            + std::to_string(message_.width) + "x" + std::to_string(message_.height));
+    }
+}
+
+std::shared_ptr<const RenderFrame> RenderFrame::fromWorldData(const WorldData& data)
+{
+    return std::make_shared<const RenderFrame>(
+        RenderMessageUtils::packRenderMessage(data, RenderFormat::DEBUG));
+}
+
+RenderMessageUtils::UnpackedDebugCell RenderFrame::decodeAt(size_t index) const
+{
+    if (isDebug()) {
+        return RenderMessageUtils::unpackDebugCell(debugCells()[index]);
+    }
+
+    RenderMessageUtils::UnpackedDebugCell result{};
+    RenderMessageUtils::unpackBasicCell(
+        basicCells()[index], result.material_type, result.fill_ratio);
+    return result;
+}
+
+} // namespace DirtSim
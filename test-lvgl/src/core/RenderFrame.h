@@ -0,0 +1,76 @@
+#pragma once
+
+#include "MaterialType.h"
+#include "RenderMessage.h"
+#include "RenderMessageUtils.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace DirtSim {
+
+struct WorldData;
+
+/**
+ * @brief Read-only view of a received RenderMessage, rendered from directly.
+ *
+ * Owns the deserialized message and reads cells straight out of its BasicCell/DebugCell
+ * payload, so the UI never builds Cell objects or copies a WorldData per frame. Frames are
+ * immutable and shared (std::shared_ptr) between the event queue and UI states.
+ */
+class RenderFrame {
+public:
+    // Throws std::invalid_argument if the payload does not hold width × height cells.
+    explicit RenderFrame(RenderMessage message);
+
+    // Pack a full WorldData (JSON state_get responses) into a DEBUG-format frame.
+    static std::shared_ptr<const RenderFrame> fromWorldData(const WorldData& data);
+
+    RenderFormat format() const { return message_.format; }
+    uint32_t width() const { return message_.width; }
+    uint32_t height() const { return message_.height; }
+    uint32_t timestep() const { return message_.timestep; }
+    double fpsServer() const { return message_.fps_server; }
+    const std::string& scenarioId() const { return message_.scenario_id; }
+    const ScenarioConfig& scenarioConfig() const { return message_.scenario_config; }
+    const std::optional<TreeSensoryData>& treeVision() const { return message_.tree_vision; }
+    const std::vector<OrganismData>& organisms() const { return message_.organisms; }
+
+    size_t cellCount() const { return static_cast<size_t>(message_.width) * message_.height; }
+
+    MaterialType materialAt(size_t index) const
+    {
+        return static_cast<MaterialType>(
+            isDebug() ? debugCells()[index].material_type : basicCells()[index].material_type);
+    }
+
+    // Quantized fill [0, 255]; 0 means the cell is empty.
+    uint8_t fillAt(size_t index) const
+    {
+        return isDebug() ? debugCells()[index].fill_ratio : basicCells()[index].fill_ratio;
+    }
+
+    double fillRatioAt(size_t index) const { return fillAt(index) / 255.0; }
+
+    // Everything the wire carries for one cell (physics fields are zero for BASIC frames).
+    RenderMessageUtils::UnpackedDebugCell decodeAt(size_t index) const;
+
+    bool isDebug() const { return message_.format == RenderFormat::DEBUG; }
+
+    // Packed cells of a BASIC frame, row-major; nullptr for DEBUG frames.
+    const BasicCell* basicPayload() const { return isDebug() ? nullptr : basicCells(); }
+
+private:
+    RenderMessage message_;
+
+    const BasicCell* basicCells() const
+    {
+        return reinterpret_cast<const BasicCell*>(message_.payload.data());
+    }
+    const DebugCell* debugCells() const
+    {
+        return reinterpret_cast<const DebugCell*>(message_.payload.data());
+    }
+};
+
+} // namespace DirtSim
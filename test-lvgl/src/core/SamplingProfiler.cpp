@@ -0,0 +1,338 @@
+#include "SamplingProfiler.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <spdlog/spdlog.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+std::atomic<bool> SamplingProfiler::running_{ false };
+
+namespace {
+
+constexpr size_t RING_SIZE = 4096;
+constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(20);
+
+// backtrace() from the handler starts with the handler itself and the signal trampoline.
+constexpr int SKIPPED_FRAMES = 2;
+
+enum SlotState : uint32_t { Free, Writing, Ready };
+
+struct Slot {
+    std::atomic<uint32_t> state{ Free };
+    uint32_t tid = 0;
+    int depth = 0;
+    void* frames[SamplingProfiler::MAX_DEPTH + SKIPPED_FRAMES];
+};
+
+using RawStack = std::pair<uint32_t, std::vector<void*>>; // Thread, innermost frame first.
+
+struct ProfilerState {
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint32_t> nextSlot{ 0 };
+    std::atomic<uint32_t> activeHandlers{ 0 };
+    std::atomic<uint64_t> samples{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+
+    uint32_t frequencyHz = 0;
+    struct sigaction previousAction = {};
+
+    // Collector side, owned by the collector thread while running.
+    std::thread collector;
+    std::atomic<bool> collecting{ false };
+    std::map<RawStack, uint64_t> rawCounts;
+
+    // Symbolized result of the last profile.
+    std::map<std::string, uint64_t> folded;
+
+    // Serializes start/stop/export (never taken by the signal handler).
+    std::mutex controlMutex;
+};
+
+ProfilerState& state()
+{
+    static ProfilerState instance;
+    return instance;
+}
+
+// Async-signal-safe: atomics, backtrace() (pre-warmed in start()) and gettid() only.
+void onSignal(int)
+{
+    const int savedErrno = errno;
+    auto& s = state();
+    s.activeHandlers.fetch_add(1, std::memory_order_acquire);
+
+    const uint32_t index = s.nextSlot.fetch_add(1, std::memory_order_relaxed) & (RING_SIZE - 1);
+    Slot& slot = s.slots[index];
+    uint32_t expected = Free;
+    if (slot.state.compare_exchange_strong(expected, Writing, std::memory_order_acquire)) {
+        slot.tid = static_cast<uint32_t>(::gettid());
+        slot.depth = ::backtrace(slot.frames, static_cast<int>(std::size(slot.frames)));
+        slot.state.store(Ready, std::memory_order_release);
+        s.samples.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    s.activeHandlers.fetch_sub(1, std::memory_order_release);
+    errno = savedErrno;
+}
+
+void drainSlots(ProfilerState& s)
+{
+    for (size_t i = 0; i < RING_SIZE; ++i) {
+        Slot& slot = s.slots[i];
+        if (slot.state.load(std::memory_order_acquire) != Ready) {
+            continue;
+        }
+
+        RawStack stack{ slot.tid, {} };
+        if (slot.depth > SKIPPED_FRAMES) {
+            stack.second.assign(slot.frames + SKIPPED_FRAMES, slot.frames + slot.depth);
+        }
+        slot.state.store(Free, std::memory_order_release);
+
+        s.rawCounts[std::move(stack)]++;
+    }
+}
+
+void collectLoop()
+{
+    pthread_setname_np(pthread_self(), "profiler");
+
+    auto& s = state();
+    while (s.collecting.load()) {
+        std::this_thread::sleep_for(DRAIN_INTERVAL);
+        drainSlots(s);
+    }
+}
+
+std::string symbolize(void* address)
+{
+    Dl_info info = {};
+    if (::dladdr(address, &info) == 0) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%p", address);
+        return buffer;
+    }
+
+    if (info.dli_sname) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+
+        // ';' separates frames in the folded format.
+        std::replace(name.begin(), name.end(), ';', ':');
+        return name;
+    }
+
+    // Unexported symbol: module and offset, resolvable offline with addr2line.
+    std::string module = info.dli_fname ? info.dli_fname : "?";
+    module = module.substr(module.find_last_of('/') + 1);
+    char offset[32];
+    std::snprintf(
+        offset,
+        sizeof(offset),
+        "+0x%zx",
+        static_cast<size_t>(
+            static_cast<const char*>(address) - static_cast<const char*>(info.dli_fbase)));
+    return module + offset;
+}
+
+std::string threadLabel(uint32_t tid)
+{
+    std::string name = TraceRecorder::threadName(tid);
+    if (!name.empty()) {
+        return name;
+    }
+
+    std::ifstream comm("/proc/self/task/" + std::to_string(tid) + "/comm");
+    if (std::getline(comm, name) && !name.empty()) {
+        return name;
+    }
+    return "thread-" + std::to_string(tid);
+}
+
+std::map<std::string, uint64_t> foldStacks(const std::map<RawStack, uint64_t>& rawCounts)
+{
+    std::unordered_map<void*, std::string> symbols;
+    std::unordered_map<uint32_t, std::string> threads;
+    std::map<std::string, uint64_t> folded;
+
+    for (const auto& [stack, count] : rawCounts) {
+        const auto& [tid, frames] = stack;
+
+        auto threadIt = threads.find(tid);
+        if (threadIt == threads.end()) {
+            threadIt = threads.emplace(tid, threadLabel(tid)).first;
+        }
+        std::string line = threadIt->second;
+
+        // Outermost first. Return addresses point past the call, so look up the call itself.
+        for (size_t i = frames.size(); i-- > 0;) {
+            void* address = i == 0 ? frames[i] : static_cast<char*>(frames[i]) - 1;
+            auto symbolIt = symbols.find(address);
+            if (symbolIt == symbols.end()) {
+                symbolIt = symbols.emplace(address, symbolize(address)).first;
+            }
+            line += ';';
+            line += symbolIt->second;
+        }
+
+        folded[line] += count;
+    }
+    return folded;
+}
+
+} // namespace
+
+bool SamplingProfiler::start(uint32_t frequencyHz)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+    if (running_.load()) {
+        return false;
+    }
+
+    // The first backtrace() loads the unwinder (dlopen + malloc), which is not safe inside a
+    // signal handler. Do it here, before the handler can run, so onSignal only walks frames.
+    void* warmup[4];
+    ::backtrace(warmup, 4);
+
+    if (!s.slots) {
+        s.slots = std::make_unique<Slot[]>(RING_SIZE);
+    }
+    for (size_t i = 0; i < RING_SIZE; ++i) {
+        s.slots[i].state.store(Free, std::memory_order_relaxed);
+    }
+    s.nextSlot.store(0);
+    s.samples.store(0);
+    s.dropped.store(0);
+    s.rawCounts.clear();
+    s.folded.clear();
+    s.frequencyHz = std::clamp<uint32_t>(frequencyHz, 1, MAX_FREQUENCY_HZ);
+
+    struct sigaction action = {};
+    action.sa_handler = onSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (::sigaction(SIGPROF, &action, &s.previousAction) != 0) {
+        spdlog::error("SamplingProfiler: Failed to install SIGPROF handler");
+        return false;
+    }
+
+    s.collecting.store(true);
+    s.collector = std::thread(collectLoop);
+
+    const suseconds_t intervalUs = 1000000 / s.frequencyHz;
+    itimerval timer = {};
+    timer.it_interval.tv_sec = intervalUs / 1000000;
+    timer.it_interval.tv_usec = intervalUs % 1000000;
+    timer.it_value = timer.it_interval;
+    if (::setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        spdlog::error("SamplingProfiler: Failed to arm ITIMER_PROF");
+        s.collecting.store(false);
+        s.collector.join();
+        ::sigaction(SIGPROF, &s.previousAction, nullptr);
+        return false;
+    }
+
+    running_.store(true);
+    spdlog::info("SamplingProfiler: Sampling started at {} Hz", s.frequencyHz);
+    return true;
+}
+
+uint32_t SamplingProfiler::frequency()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+    return s.frequencyHz;
+}
+
+SamplingProfiler::Summary SamplingProfiler::stop()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+    if (running_.load()) {
+        const itimerval disarmed = {};
+        ::setitimer(ITIMER_PROF, &disarmed, nullptr);
+
+        // A SIGPROF may still be pending, and under a restored SIG_DFL it would terminate.
+        // Setting SIG_IGN discards pending ones; the timer is disarmed, so no new ones come.
+        struct sigaction ignore = {};
+        ignore.sa_handler = SIG_IGN;
+        sigemptyset(&ignore.sa_mask);
+        ::sigaction(SIGPROF, &ignore, nullptr);
+
+        while (s.activeHandlers.load() != 0) {
+            std::this_thread::yield();
+        }
+
+        // Put back exactly what start() replaced, SIG_DFL included.
+        ::sigaction(SIGPROF, &s.previousAction, nullptr);
+        running_.store(false);
+
+        s.collecting.store(false);
+        s.collector.join();
+        drainSlots(s);
+
+        s.folded = foldStacks(s.rawCounts);
+        s.rawCounts.clear();
+    }
+
+    const Summary summary{
+        .samples = s.samples.load(),
+        .dropped = s.dropped.load(),
+        .stacks = s.folded.size(),
+    };
+    spdlog::info(
+        "SamplingProfiler: Sampling stopped ({} samples, {} dropped, {} stacks)",
+        summary.samples,
+        summary.dropped,
+        summary.stacks);
+    return summary;
+}
+
+std::string SamplingProfiler::exportFolded()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+
+    std::string out;
+    for (const auto& [stack, count] : s.folded) {
+        out += stack;
+        out += ' ';
+        out += std::to_string(count);
+        out += '\n';
+    }
+    return out;
+}
+
+bool SamplingProfiler::writeFolded(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file) {
+        spdlog::error("SamplingProfiler: Failed to open {}", path);
+        return false;
+    }
+
+    file << exportFolded();
+    return file.good();
+}
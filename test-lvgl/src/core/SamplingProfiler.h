@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Process-wide SIGPROF sampler that aggregates call stacks as folded stacks.
+ *
+ * setitimer(ITIMER_PROF) fires on consumed CPU time, so every busy thread is sampled
+ * (physics, OpenMP workers, network) and idle threads cost nothing. The signal handler
+ * only unwinds into a free slot of a fixed ring; a collector thread folds the slots into
+ * per-stack counts, and symbolization happens once at export. Needs no perf binary and
+ * no perf_event permissions.
+ *
+ * Output is one "thread;outermost;...;innermost count" line per stack, as consumed by
+ * flamegraph.pl and speedscope. Frames resolve through dladdr(), so executables need
+ * exported symbols (-rdynamic) for names beyond shared libraries.
+ */
+class SamplingProfiler {
+public:
+    // Slightly off 1kHz so sampling does not lock step with millisecond-periodic work.
+    static constexpr uint32_t DEFAULT_FREQUENCY_HZ = 997;
+    static constexpr uint32_t MAX_FREQUENCY_HZ = 10000;
+    static constexpr size_t MAX_DEPTH = 64;
+
+    struct Summary {
+        uint64_t samples = 0; // Stacks captured since start().
+        uint64_t dropped = 0; // Samples lost because the ring was full.
+        size_t stacks = 0;    // Distinct stacks.
+    };
+
+    static bool isRunning() { return running_.load(std::memory_order_relaxed); }
+
+    // Install the SIGPROF handler and arm the timer. False if already running or on failure.
+    static bool start(uint32_t frequencyHz = DEFAULT_FREQUENCY_HZ);
+
+    // Sampling rate of the current or last profile.
+    static uint32_t frequency();
+
+    // Disarm the timer, restore the previous handler, and fold the remaining samples.
+    static Summary stop();
+
+    // Folded stacks of the last profile. Valid until the next start().
+    static std::string exportFolded();
+
+    // Write exportFolded() to a file. False on I/O failure.
+    static bool writeFolded(const std::string& path);
+
+private:
+    static std::atomic<bool> running_;
+};
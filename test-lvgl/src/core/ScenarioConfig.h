@@ -87,6 +87,15 @@ struct BenchmarkConfig {
     using serialize = zpp::bits::members<0>;
 };
 
+/**
+ * @brief Tree germination scenario - a seed growing into a tree.
+ */
+struct TreeGerminationConfig {
+    using serialize = zpp::bits::members<1>;
+
+    std::string brain_weights_path; // NeuralNetwork weights file (empty = rule-based brain).
+};
+
 /**
  * @brief Variant type containing all scenario configurations.
  *
@@ -99,7 +108,8 @@ using ScenarioConfig = std::variant<
     RainingConfig,
     WaterEqualizationConfig,
     FallingDirtConfig,
-    BenchmarkConfig>;
+    BenchmarkConfig,
+    TreeGerminationConfig>;
 
 /**
  * @brief Get scenario ID string from config variant.
@@ -125,6 +135,8 @@ inline std::string getScenarioId(const ScenarioConfig& config)
                 return "falling_dirt";
             else if constexpr (std::is_same_v<T, BenchmarkConfig>)
                 return "benchmark";
+            else if constexpr (std::is_same_v<T, TreeGerminationConfig>)
+                return "tree_germination";
             else
                 return "unknown";
         },
@@ -170,6 +182,9 @@ inline void to_json(nlohmann::json& j, const ScenarioConfig& config)
             else if constexpr (std::is_same_v<T, BenchmarkConfig>) {
                 j["type"] = "benchmark";
             }
+            else if constexpr (std::is_same_v<T, TreeGerminationConfig>) {
+                j["type"] = "tree_germination";
+            }
         },
         config);
 }
@@ -200,6 +215,9 @@ inline void from_json(const nlohmann::json& j, ScenarioConfig& config)
     else if (type == "benchmark") {
         config = ReflectSerializer::from_json<BenchmarkConfig>(j);
     }
+    else if (type == "tree_germination") {
+        config = ReflectSerializer::from_json<TreeGerminationConfig>(j);
+    }
     else {
         config = EmptyConfig{};
     }
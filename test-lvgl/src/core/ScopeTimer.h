@@ -5,14 +5,20 @@
 
 class ScopeTimer {
 public:
-    explicit ScopeTimer(Timers& timers, const std::string& name) : m_timers(timers), m_name(name)
+    // Constant overhead: no name lookup, no string copy.
+    explicit ScopeTimer(Timers& timers, Timers::TimerId id) : m_timers(timers), m_id(id)
     {
-        m_timers.startTimer(m_name);
+        m_timers.startTimer(m_id);
     }
 
-    ~ScopeTimer() { m_timers.stopTimer(m_name); }
+    // Convenience for cold paths; interns the name once per scope.
+    explicit ScopeTimer(Timers& timers, const std::string& name)
+        : ScopeTimer(timers, Timers::intern(name))
+    {}
+
+    ~ScopeTimer() { m_timers.stopTimer(m_id); }
 
 private:
     Timers& m_timers;
-    std::string m_name;
-};
\ No newline at end of file
+    Timers::TimerId m_id;
+};
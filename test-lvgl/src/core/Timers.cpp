@@ -1,87 +1,257 @@
 #include "Timers.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <bit>
+#include <deque>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+namespace {
+
+// Global name <-> ID table. Deque keeps names at stable addresses for nameOf().
+struct TimerRegistry {
+    std::mutex mutex;
+    std::unordered_map<std::string, Timers::TimerId> ids;
+    std::deque<std::string> names;
+};
+
+TimerRegistry& registry()
+{
+    static TimerRegistry instance;
+    return instance;
+}
+
+// Look up a name without registering it.
+bool lookup(const std::string& name, Timers::TimerId& id)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = reg.ids.find(name);
+    if (it == reg.ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+size_t registeredCount()
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.names.size();
+}
+
+} // namespace
+
+Timers::Timers() : slots(registeredCount(), NO_SLOT)
+{}
+
+Timers::TimerId Timers::intern(std::string_view name)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto [it, inserted] =
+        reg.ids.try_emplace(std::string(name), static_cast<TimerId>(reg.names.size()));
+    if (inserted) {
+        reg.names.emplace_back(name);
+    }
+    return it->second;
+}
+
+const std::string& Timers::nameOf(TimerId id)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    return reg.names.at(id);
+}
+
 void Timers::startTimer(const std::string& name)
 {
-    auto& timer = timers[name];
+    startTimer(intern(name));
+}
+
+void Timers::startTimer(TimerId id)
+{
+    auto& timer = slot(id);
     if (!timer.isRunning) {
         timer.startTime = std::chrono::steady_clock::now();
         timer.isRunning = true;
         timer.callCount++; // Increment call count when timer starts.
+        timer.countersRunning = countHardware && HardwareCounters::isEnabled();
+        if (timer.countersRunning) {
+            timer.countersAtStart = HardwareCounters::read();
+        }
+        if constexpr (AllocationTracker::isCompiledIn()) {
+            timer.allocationsAtStart = AllocationTracker::threadCounts();
+        }
+        TraceRecorder::begin(id);
     }
 }
 
 double Timers::stopTimer(const std::string& name)
 {
-    auto it = timers.find(name);
-    if (it == timers.end()) {
+    TimerId id = 0;
+    if (!lookup(name, id)) {
+        return -1.0; // Timer not found.
+    }
+    return stopTimer(id);
+}
+
+double Timers::stopTimer(TimerId id)
+{
+    TimerData* found = find(id);
+    if (!found) {
         return -1.0; // Timer not found.
     }
 
-    auto& timer = it->second;
+    auto& timer = *found;
     if (!timer.isRunning) {
-        return timer.accumulatedTime; // Return accumulated time if timer wasn't running.
+        return accumulatedMs(timer); // Return accumulated time if timer wasn't running.
     }
 
-    auto end = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - timer.startTime);
-    timer.accumulatedTime += duration.count() / 1000.0; // Convert to milliseconds.
+    const auto end = std::chrono::steady_clock::now();
+    const int64_t ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - timer.startTime).count();
+    timer.accumulatedNs += ns;
+    timer.maxNs = std::max(timer.maxNs, ns);
+    timer.histogram[bucketFor(ns)]++;
     timer.isRunning = false;
-    return timer.accumulatedTime;
+    if (timer.countersRunning && HardwareCounters::isEnabled()) {
+        const HardwareCounters::Values now = HardwareCounters::read();
+        for (size_t event = 0; event < now.size(); ++event) {
+            // Multiplex scaling can make a reading dip slightly below an earlier one.
+            if (now[event] > timer.countersAtStart[event]) {
+                timer.counters[event] += now[event] - timer.countersAtStart[event];
+            }
+        }
+    }
+    timer.countersRunning = false;
+    if constexpr (AllocationTracker::isCompiledIn()) {
+        const AllocationTracker::Counts delta =
+            AllocationTracker::threadCounts() - timer.allocationsAtStart;
+        timer.allocations.allocations += delta.allocations;
+        timer.allocations.bytes += delta.bytes;
+        timer.allocations.frees += delta.frees;
+    }
+    TraceRecorder::end(id);
+    return accumulatedMs(timer);
 }
 
 bool Timers::hasTimer(const std::string& name) const
 {
-    return timers.find(name) != timers.end();
+    return find(name) != nullptr;
 }
 
 double Timers::getAccumulatedTime(const std::string& name) const
 {
-    auto it = timers.find(name);
-    if (it == timers.end()) {
+    const TimerData* timer = find(name);
+    if (!timer) {
         return -1.0; // Timer not found.
     }
+    return accumulatedMs(*timer);
+}
 
-    const auto& timer = it->second;
-    if (!timer.isRunning) {
-        return timer.accumulatedTime;
-    }
-
-    // If timer is running, include current session.
-    auto current = std::chrono::steady_clock::now();
-    auto currentDuration =
-        std::chrono::duration_cast<std::chrono::microseconds>(current - timer.startTime);
-    return timer.accumulatedTime + (currentDuration.count() / 1000.0); // Convert to milliseconds.
+int64_t Timers::getAccumulatedNs(TimerId id) const
+{
+    const TimerData* timer = find(id);
+    return timer ? timer->accumulatedNs : 0;
 }
 
 void Timers::resetTimer(const std::string& name)
 {
-    auto it = timers.find(name);
-    if (it != timers.end()) {
-        it->second.accumulatedTime = 0.0;
-        if (it->second.isRunning) {
-            it->second.startTime = std::chrono::steady_clock::now();
+    TimerData* timer = find(name);
+    if (timer) {
+        timer->accumulatedNs = 0;
+        timer->maxNs = 0;
+        timer->histogram.fill(0);
+        timer->counters = {};
+        timer->allocations = {};
+        if (timer->isRunning) {
+            timer->startTime = std::chrono::steady_clock::now();
         }
     }
 }
 
 uint32_t Timers::getCallCount(const std::string& name) const
 {
-    auto it = timers.find(name);
-    if (it == timers.end()) {
+    const TimerData* timer = find(name);
+    if (!timer) {
         return 0; // Return 0 for non-existent timer.
     }
-    return it->second.callCount;
+    return timer->callCount;
 }
 
 void Timers::resetCallCount(const std::string& name)
 {
-    auto it = timers.find(name);
-    if (it != timers.end()) {
-        it->second.callCount = 0;
+    TimerData* timer = find(name);
+    if (timer) {
+        timer->callCount = 0;
+    }
+}
+
+Timers::Percentiles Timers::getPercentiles(const std::string& name) const
+{
+    const TimerData* timer = find(name);
+    if (!timer) {
+        return Percentiles{};
+    }
+    return percentiles(*timer);
+}
+
+uint64_t Timers::getCumulativeCounts(
+    TimerId id, std::span<const double> upperBoundsMs, std::span<uint64_t> counts) const
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    const TimerData* timer = find(id);
+    if (!timer) {
+        return 0;
+    }
+
+    const auto& histogram = timer->histogram;
+    const size_t bounds = std::min(upperBoundsMs.size(), counts.size());
+    uint64_t total = 0;
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+        if (histogram[bucket] == 0) {
+            continue;
+        }
+        total += histogram[bucket];
+
+        const double ms = bucketMidpointNs(bucket) / 1e6;
+        const auto it = std::lower_bound(upperBoundsMs.begin(), upperBoundsMs.begin() + bounds, ms);
+        const size_t first = static_cast<size_t>(it - upperBoundsMs.begin());
+        if (first < bounds) {
+            counts[first] += histogram[bucket];
+        }
+    }
+
+    // Per-bound counts to cumulative.
+    for (size_t i = 1; i < bounds; ++i) {
+        counts[i] += counts[i - 1];
+    }
+    return total;
+}
+
+HardwareCounters::Values Timers::getHardwareCounters(const std::string& name) const
+{
+    const TimerData* timer = find(name);
+    if (!timer) {
+        return HardwareCounters::Values{};
+    }
+    return timer->counters;
+}
+
+AllocationTracker::Counts Timers::getAllocations(const std::string& name) const
+{
+    const TimerData* timer = find(name);
+    if (!timer) {
+        return AllocationTracker::Counts{};
     }
+    return timer->allocations;
 }
 
 void Timers::dumpTimerStats() const
@@ -159,8 +329,8 @@ std::vector<std::string> Timers::getAllTimerNames() const
 {
     std::vector<std::string> names;
     names.reserve(timers.size());
-    for (const auto& pair : timers) {
-        names.push_back(pair.first);
+    for (const TimerData& timer : timers) {
+        names.push_back(nameOf(timer.id));
     }
     return names;
 }
@@ -169,13 +339,135 @@ nlohmann::json Timers::exportAllTimersAsJson() const
 {
     nlohmann::json j = nlohmann::json::object();
 
-    for (const auto& [name, timerData] : timers) {
-        double total_ms = getAccumulatedTime(name);
+    for (const TimerData& timerData : timers) {
+        double total_ms = accumulatedMs(timerData);
         uint32_t calls = timerData.callCount;
         double avg_ms = calls > 0 ? total_ms / calls : 0.0;
+        const Percentiles p = percentiles(timerData);
 
-        j[name] = { { "total_ms", total_ms }, { "avg_ms", avg_ms }, { "calls", calls } };
+        j[nameOf(timerData.id)] = {
+            { "total_ms", total_ms }, { "avg_ms", avg_ms }, { "calls", calls },
+            { "p50_ms", p.p50_ms },   { "p90_ms", p.p90_ms }, { "p99_ms", p.p99_ms },
+            { "max_ms", p.max_ms }
+        };
     }
 
     return j;
 }
+
+int Timers::bucketFor(int64_t ns)
+{
+    if (ns < HISTOGRAM_SUB_BUCKETS) {
+        return ns < 0 ? 0 : static_cast<int>(ns);
+    }
+
+    const int exponent = std::bit_width(static_cast<uint64_t>(ns)) - 1;
+    if (exponent >= MAX_HISTOGRAM_EXPONENT) {
+        return OVERFLOW_BUCKET;
+    }
+
+    // Top three bits below the leading one select the sub-bucket.
+    const int sub = static_cast<int>((ns >> (exponent - 3)) & (HISTOGRAM_SUB_BUCKETS - 1));
+    return (exponent - 2) * HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+double Timers::bucketMidpointNs(int bucket)
+{
+    if (bucket < HISTOGRAM_SUB_BUCKETS) {
+        return bucket;
+    }
+    if (bucket >= OVERFLOW_BUCKET) {
+        // Unbounded: counts only toward +Inf, and percentiles clamp to the exact max.
+        return std::numeric_limits<double>::infinity();
+    }
+
+    const int exponent = bucket / HISTOGRAM_SUB_BUCKETS + 2;
+    const int sub = bucket % HISTOGRAM_SUB_BUCKETS;
+    const double width = static_cast<double>(int64_t{ 1 } << (exponent - 3));
+    return (HISTOGRAM_SUB_BUCKETS + sub) * width + width / 2.0;
+}
+
+const Timers::TimerData* Timers::find(TimerId id) const
+{
+    if (id >= slots.size() || slots[id] == NO_SLOT) {
+        return nullptr;
+    }
+    return &timers[slots[id]];
+}
+
+Timers::TimerData* Timers::find(TimerId id)
+{
+    return const_cast<TimerData*>(std::as_const(*this).find(id));
+}
+
+const Timers::TimerData* Timers::find(const std::string& name) const
+{
+    TimerId id = 0;
+    if (!lookup(name, id)) {
+        return nullptr;
+    }
+    return find(id);
+}
+
+Timers::TimerData* Timers::find(const std::string& name)
+{
+    return const_cast<TimerData*>(std::as_const(*this).find(name));
+}
+
+Timers::TimerData& Timers::slot(TimerId id)
+{
+    if (id >= slots.size()) {
+        // Name interned after this instance was built: catch up with the registry once.
+        slots.resize(std::max<size_t>(id + 1, registeredCount()), NO_SLOT);
+    }
+    if (slots[id] == NO_SLOT) {
+        // First use of this name by this instance; later calls hit the existing slot.
+        slots[id] = static_cast<uint32_t>(timers.size());
+        timers.emplace_back().id = id;
+    }
+    return timers[slots[id]];
+}
+
+double Timers::accumulatedMs(const TimerData& timer) const
+{
+    if (!timer.isRunning) {
+        return timer.accumulatedNs / 1e6;
+    }
+
+    // If timer is running, include current session.
+    const auto current = std::chrono::steady_clock::now();
+    const int64_t currentNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(current - timer.startTime).count();
+    return (timer.accumulatedNs + currentNs) / 1e6; // Convert to milliseconds.
+}
+
+Timers::Percentiles Timers::percentiles(const TimerData& timer) const
+{
+    uint64_t samples = 0;
+    for (const uint32_t count : timer.histogram) {
+        samples += count;
+    }
+    if (samples == 0) {
+        return Percentiles{};
+    }
+
+    const double maxMs = timer.maxNs / 1e6;
+    const auto quantile = [&](double q) {
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * samples + 0.5));
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+            seen += timer.histogram[bucket];
+            if (seen >= rank) {
+                return std::min(bucketMidpointNs(bucket) / 1e6, maxMs);
+            }
+        }
+        return maxMs;
+    };
+
+    return Percentiles{
+        .p50_ms = quantile(0.50),
+        .p90_ms = quantile(0.90),
+        .p99_ms = quantile(0.99),
+        .max_ms = maxMs,
+    };
+}
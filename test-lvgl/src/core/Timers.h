@@ -1,21 +1,48 @@
 #pragma once
 
+#include "AllocationTracker.h"
+#include "HardwareCounters.h"
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <nlohmann/json_fwd.hpp>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 class Timers {
 public:
-    Timers() = default;
+    // Process-wide interned timer name. Hot paths intern once and time by ID.
+    using TimerId = uint32_t;
+
+    // Latency percentiles from the per-timer histogram, in milliseconds.
+    struct Percentiles {
+        double p50_ms = 0.0;
+        double p90_ms = 0.0;
+        double p99_ms = 0.0;
+        double max_ms = 0.0;
+    };
+
+    // Sizes the ID index for every name interned so far, so timing an already-interned ID
+    // never grows it on the hot path.
+    Timers();
     ~Timers() = default;
 
-    // Start a timer with the given name
+    // Map a name to its stable ID (registers it on first use, thread-safe).
+    static TimerId intern(std::string_view name);
+
+    // Name registered for an interned ID.
+    static const std::string& nameOf(TimerId id);
+
+    // Start a timer. The name overload interns on every call (global lock + hash lookup),
+    // so per-frame code should intern once into a static TimerId; keep names for cold paths.
     void startTimer(const std::string& name);
+    void startTimer(TimerId id);
 
-    // Stop a timer with the given name and return elapsed time in milliseconds
+    // Stop a timer and return its accumulated time in milliseconds (-1 if unknown).
     double stopTimer(const std::string& name);
+    double stopTimer(TimerId id);
 
     // Check if a timer exists
     bool hasTimer(const std::string& name) const;
@@ -23,6 +50,9 @@ public:
     // Get the total accumulated time for a timer in milliseconds
     double getAccumulatedTime(const std::string& name) const;
 
+    // Completed-call total in nanoseconds by ID (0 for unknown timers; no lookup).
+    int64_t getAccumulatedNs(TimerId id) const;
+
     // Reset a timer's accumulated time to 0
     void resetTimer(const std::string& name);
 
@@ -32,6 +62,26 @@ public:
     // Reset a timer's call count to 0
     void resetCallCount(const std::string& name);
 
+    // Per-call latency percentiles (zeros for unknown timers).
+    Percentiles getPercentiles(const std::string& name) const;
+
+    // Completed calls at or below each upper bound (ascending, ms) for Prometheus-style
+    // histograms. Calls are placed by histogram bucket midpoint, so a call within 12.5% of a
+    // bound may land on either side. Returns the total call count (0 for unknown timers).
+    uint64_t getCumulativeCounts(
+        TimerId id, std::span<const double> upperBoundsMs, std::span<uint64_t> counts) const;
+
+    // Sample HardwareCounters at scope edges (off by default). Only for timers that run on
+    // the thread owning the counters, i.e. the physics stages; elsewhere reads are zero.
+    void setHardwareCountersEnabled(bool enabled) { countHardware = enabled; }
+
+    // Hardware counter totals over completed calls, while HardwareCounters was enabled.
+    HardwareCounters::Values getHardwareCounters(const std::string& name) const;
+
+    // Heap allocations by this thread over completed calls (zeros unless built with
+    // allocation tracking).
+    AllocationTracker::Counts getAllocations(const std::string& name) const;
+
     void dumpTimerStats() const;
     std::vector<std::string> getAllTimerNames() const;
 
@@ -40,12 +90,46 @@ public:
 private:
     using TimePoint = std::chrono::steady_clock::time_point;
 
+    // Log-linear histogram: exact below 8ns, then 8 sub-buckets per power of two
+    // (<= 12.5% relative error) up to 2^MAX_HISTOGRAM_EXPONENT ns (~73 minutes). Longer
+    // calls land in a separate overflow bucket whose upper bound is +Inf.
+    static constexpr int HISTOGRAM_SUB_BUCKETS = 8;
+    static constexpr int MAX_HISTOGRAM_EXPONENT = 42;
+    static constexpr int OVERFLOW_BUCKET = (MAX_HISTOGRAM_EXPONENT - 2) * HISTOGRAM_SUB_BUCKETS;
+    static constexpr int HISTOGRAM_BUCKETS = OVERFLOW_BUCKET + 1;
+
     struct TimerData {
+        TimerId id = 0;
         TimePoint startTime;
-        double accumulatedTime = 0.0;
-        bool isRunning = false;
+        int64_t accumulatedNs = 0;
+        int64_t maxNs = 0;
         uint32_t callCount = 0; // Track number of times timer has been called
+        bool isRunning = false;
+        std::array<uint32_t, HISTOGRAM_BUCKETS> histogram = {};
+        HardwareCounters::Values countersAtStart = {};
+        HardwareCounters::Values counters = {};
+        bool countersRunning = false; // countersAtStart is valid for this call.
+        AllocationTracker::Counts allocationsAtStart = {};
+        AllocationTracker::Counts allocations = {};
     };
 
-    std::unordered_map<std::string, TimerData> timers;
+    static int bucketFor(int64_t ns);
+    static double bucketMidpointNs(int bucket); // +Inf for OVERFLOW_BUCKET.
+
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    const TimerData* find(TimerId id) const;
+    TimerData* find(TimerId id);
+    const TimerData* find(const std::string& name) const;
+    TimerData* find(const std::string& name);
+    TimerData& slot(TimerId id);
+    double accumulatedMs(const TimerData& timer) const;
+    Percentiles percentiles(const TimerData& timer) const;
+
+    // Sparse: slots maps TimerId -> index into timers (NO_SLOT if unused here), so each
+    // instance pays 4 bytes per interned name and a full TimerData (with histogram) only
+    // for the timers it actually runs, in first-use order.
+    std::vector<uint32_t> slots;
+    std::vector<TimerData> timers;
+    bool countHardware = false;    // See setHardwareCountersEnabled().
 };
@@ -0,0 +1,295 @@
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <pthread.h>
+#include <spdlog/spdlog.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::recording_{ false };
+
+namespace {
+
+// Slot::sequence while a writer owns the slot.
+constexpr uint64_t WRITING = std::numeric_limits<uint64_t>::max();
+
+struct Slot {
+    std::atomic<uint64_t> sequence{ 0 }; // Ring index + 1 once written, WRITING while filling.
+    int64_t timestampNs = 0;
+    uint32_t tid = 0;
+    Timers::TimerId id = 0;
+    uint8_t phase = 0;
+};
+
+// Per-thread in-flight flag. stop() waits on each one, so writers never share a counter.
+struct alignas(64) Writer {
+    std::atomic<bool> active{ false };
+    uint32_t tid = 0;
+};
+
+struct TraceState {
+    std::unique_ptr<Slot[]> slots;
+    uint64_t mask = 0;
+    std::atomic<uint64_t> writeIndex{ 0 };
+    int64_t startNs = 0;
+
+    // Serializes start/stop/export (never taken on the record path).
+    std::mutex controlMutex;
+
+    // Writers and thread labels, registered once per thread on its first event.
+    std::mutex namesMutex;
+    std::vector<std::shared_ptr<Writer>> writers;
+    std::unordered_map<uint32_t, std::string> threadNames;
+};
+
+TraceState& state()
+{
+    static TraceState instance;
+    return instance;
+}
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+std::shared_ptr<Writer> registerCurrentThread()
+{
+    auto writer = std::make_shared<Writer>();
+    writer->tid = static_cast<uint32_t>(::gettid());
+
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.namesMutex);
+    s.writers.push_back(writer);
+    s.threadNames.try_emplace(writer->tid, name);
+    return writer;
+}
+
+Writer& currentWriter()
+{
+    thread_local const std::shared_ptr<Writer> writer = registerCurrentThread();
+    return *writer;
+}
+
+} // namespace
+
+bool TraceRecorder::start(size_t capacity)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+    if (recording_.load()) {
+        return false;
+    }
+
+    // Recording is off and stop() drained the writers, so nobody touches the ring.
+    capacity = std::bit_ceil(std::clamp<size_t>(capacity, 2, MAX_CAPACITY));
+    if (s.mask + 1 != capacity || !s.slots) {
+        s.slots = std::make_unique<Slot[]>(capacity);
+        s.mask = capacity - 1;
+    }
+    else {
+        for (uint64_t i = 0; i <= s.mask; ++i) {
+            s.slots[i].sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+    s.writeIndex.store(0, std::memory_order_relaxed);
+    s.startNs = nowNs();
+
+    {
+        // Forget threads that have exited (only this list still holds their writer).
+        std::lock_guard<std::mutex> namesLock(s.namesMutex);
+        std::erase_if(s.writers, [](const auto& writer) { return writer.use_count() == 1; });
+    }
+
+    recording_.store(true);
+    spdlog::info("TraceRecorder: Recording started ({} event ring)", capacity);
+    return true;
+}
+
+size_t TraceRecorder::capacity()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+    return s.slots ? s.mask + 1 : 0;
+}
+
+TraceRecorder::Summary TraceRecorder::stop()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+    recording_.store(false);
+
+    // Writers that saw recording_ == true may still be filling their slot.
+    std::vector<std::shared_ptr<Writer>> writers;
+    {
+        std::lock_guard<std::mutex> namesLock(s.namesMutex);
+        writers = s.writers;
+    }
+    for (const auto& writer : writers) {
+        while (writer->active.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+    const uint64_t recorded = s.writeIndex.load();
+    const uint64_t capacity = s.slots ? s.mask + 1 : 0;
+    const Summary summary{
+        .recorded = recorded,
+        .dropped = recorded > capacity ? recorded - capacity : 0,
+    };
+    spdlog::info(
+        "TraceRecorder: Recording stopped ({} events, {} dropped)",
+        summary.recorded,
+        summary.dropped);
+    return summary;
+}
+
+void TraceRecorder::record(Timers::TimerId id, Phase phase)
+{
+    // begin()/end() already skipped this call if recording looked off.
+    Writer& writer = currentWriter();
+
+    // Flag the write before re-checking, so stop() either sees the flag or we see it stopped.
+    // The flag is this thread's own cache line, so the store never contends.
+    writer.active.store(true);
+    if (!recording_.load()) {
+        writer.active.store(false, std::memory_order_release);
+        return;
+    }
+
+    auto& s = state();
+    const uint64_t index = s.writeIndex.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t sequence = index + 1;
+    Slot& slot = s.slots[index & s.mask];
+
+    // Own the slot before filling it. A writer one lap behind may still be filling it (wait
+    // it out); one a lap ahead may already have replaced it, making this event older than
+    // the ring keeps (drop it, as wrap-around would have).
+    uint64_t current = slot.sequence.load(std::memory_order_relaxed);
+    bool owned = false;
+    while (!owned && (current == WRITING || current < sequence)) {
+        if (current == WRITING) {
+            std::this_thread::yield();
+            current = slot.sequence.load(std::memory_order_relaxed);
+            continue;
+        }
+        owned = slot.sequence.compare_exchange_weak(
+            current, WRITING, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    if (owned) {
+        slot.timestampNs = nowNs();
+        slot.tid = writer.tid;
+        slot.id = id;
+        slot.phase = static_cast<uint8_t>(phase);
+        slot.sequence.store(sequence, std::memory_order_release);
+    }
+
+    writer.active.store(false, std::memory_order_release);
+}
+
+void TraceRecorder::setThreadName(std::string_view name)
+{
+    const uint32_t tid = currentWriter().tid;
+
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.namesMutex);
+    s.threadNames[tid] = std::string(name);
+}
+
+std::string TraceRecorder::threadName(uint32_t tid)
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.namesMutex);
+    const auto it = s.threadNames.find(tid);
+    return it != s.threadNames.end() ? it->second : std::string();
+}
+
+nlohmann::json TraceRecorder::exportChromeTrace()
+{
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.controlMutex);
+
+    nlohmann::json events = nlohmann::json::array();
+    const int pid = static_cast<int>(::getpid());
+
+    // Slots are only stable once recording has stopped.
+    if (!recording_.load() && s.slots) {
+        const uint64_t end = s.writeIndex.load();
+        const uint64_t capacity = s.mask + 1;
+        const uint64_t first = end > capacity ? end - capacity : 0;
+
+        // Per-thread nesting depth, to drop end events whose begin fell off the ring.
+        std::unordered_map<uint32_t, uint32_t> depth;
+
+        for (uint64_t i = first; i < end; ++i) {
+            const Slot& slot = s.slots[i & s.mask];
+            if (slot.sequence.load(std::memory_order_acquire) != i + 1) {
+                continue;
+            }
+
+            uint32_t& threadDepth = depth[slot.tid];
+            const bool isBegin = slot.phase == static_cast<uint8_t>(Phase::Begin);
+            if (isBegin) {
+                threadDepth++;
+            }
+            else if (threadDepth == 0) {
+                continue;
+            }
+            else {
+                threadDepth--;
+            }
+
+            events.push_back({
+                { "name", Timers::nameOf(slot.id) },
+                { "cat", "sim" },
+                { "ph", isBegin ? "B" : "E" },
+                { "ts", (slot.timestampNs - s.startNs) / 1000.0 },
+                { "pid", pid },
+                { "tid", slot.tid },
+            });
+        }
+    }
+
+    events.push_back({ { "name", "process_name" },
+                       { "ph", "M" },
+                       { "pid", pid },
+                       { "args", { { "name", "sparkle-duck" } } } });
+    {
+        std::lock_guard<std::mutex> namesLock(s.namesMutex);
+        for (const auto& [tid, name] : s.threadNames) {
+            events.push_back({ { "name", "thread_name" },
+                               { "ph", "M" },
+                               { "pid", pid },
+                               { "tid", tid },
+                               { "args", { { "name", name } } } });
+        }
+    }
+
+    return { { "traceEvents", std::move(events) }, { "displayTimeUnit", "ms" } };
+}
+
+bool TraceRecorder::writeChromeTrace(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file) {
+        spdlog::error("TraceRecorder: Failed to open {}", path);
+        return false;
+    }
+
+    file << exportChromeTrace().dump();
+    return file.good();
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Timers.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <string_view>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Process-wide recorder of timer begin/end events for Chrome/Perfetto traces.
+ *
+ * Timers::startTimer()/stopTimer() report every scope here, from any thread. While
+ * recording is off the hook is a single relaxed atomic load. While on, each event claims
+ * a slot in a fixed power-of-two ring with fetch_add and takes it over with a CAS on the
+ * slot's sequence (no locks), so writers a lap apart never interleave fields; once full,
+ * the oldest are overwritten so a long capture keeps the most recent window. In-flight
+ * writes are tracked by a per-thread flag that stop() drains.
+ *
+ * Timers instances are single-threaded, so OpenMP workers use TraceScope directly.
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = size_t{ 1 } << 18;
+    static constexpr size_t MAX_CAPACITY = size_t{ 1 } << 24;
+
+    struct Summary {
+        uint64_t recorded = 0; // Events written since start().
+        uint64_t dropped = 0;  // Oldest events overwritten by ring wrap-around.
+    };
+
+    static bool isRecording() { return recording_.load(std::memory_order_relaxed); }
+
+    // Begin a capture (capacity is rounded up to a power of two, clamped to MAX_CAPACITY).
+    // False if already recording.
+    static bool start(size_t capacity = DEFAULT_CAPACITY);
+
+    // Ring size of the current or last capture, in events.
+    static size_t capacity();
+
+    // End the capture. Events stay readable until the next start().
+    static Summary stop();
+
+    static void begin(Timers::TimerId id)
+    {
+        if (isRecording()) {
+            record(id, Phase::Begin);
+        }
+    }
+
+    static void end(Timers::TimerId id)
+    {
+        if (isRecording()) {
+            record(id, Phase::End);
+        }
+    }
+
+    // Label the calling thread in exported traces (defaults to the OS thread name).
+    static void setThreadName(std::string_view name);
+
+    // Label recorded for an OS thread id, or empty if the thread never reported.
+    static std::string threadName(uint32_t tid);
+
+    // Chrome trace-event JSON ({"traceEvents": [...]}) of the last capture.
+    static nlohmann::json exportChromeTrace();
+
+    // Write exportChromeTrace() to a file. False on I/O failure.
+    static bool writeChromeTrace(const std::string& path);
+
+private:
+    enum class Phase : uint8_t { Begin, End };
+
+    static void record(Timers::TimerId id, Phase phase);
+
+    static std::atomic<bool> recording_;
+};
+
+/**
+ * @brief Trace-only scope for code that must not touch a Timers instance (OpenMP workers).
+ *
+ * Meant for the body of a parallel region enclosed by a ScopeTimer with the same ID. That
+ * timer already emits the slice on the team's primary thread, so only the other workers
+ * record here; otherwise the primary thread would show the slice nested inside itself.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(Timers::TimerId id) : m_id(id), m_active(!isPrimaryThread())
+    {
+        if (m_active) {
+            TraceRecorder::begin(m_id);
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_active) {
+            TraceRecorder::end(m_id);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    static bool isPrimaryThread()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num() == 0;
+#else
+        return true;
+#endif
+    }
+
+    Timers::TimerId m_id;
+    bool m_active;
+};
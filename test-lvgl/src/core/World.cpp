@@ -6,6 +6,7 @@
 #include "ReflectSerializer.h"
 #include "ScopeTimer.h"
 #include "Timers.h"
+#include "TraceRecorder.h"
 #include "Vector2i.h"
 #include "WorldAdhesionCalculator.h"
 #include "WorldAirResistanceCalculator.h"
@@ -32,6 +33,70 @@
 
 namespace DirtSim {
 
+namespace {
+
+// Interned once at startup so per-frame scopes skip the name lookup.
+const Timers::TimerId TIMER_ADHESION_CALCULATION = Timers::intern("adhesion_calculation");
+const Timers::TimerId TIMER_ADVANCE_TIME = Timers::intern("advance_time");
+const Timers::TimerId TIMER_APPLY_CELL_EDITS = Timers::intern("apply_cell_edits");
+const Timers::TimerId TIMER_APPLY_VISCOUS_FORCES = Timers::intern("apply_viscous_forces");
+const Timers::TimerId TIMER_COHESION_CALCULATION = Timers::intern("cohesion_calculation");
+const Timers::TimerId TIMER_COMPUTE_SUPPORT_MAP = Timers::intern("compute_support_map");
+const Timers::TimerId TIMER_DYNAMIC_PRESSURE = Timers::intern("dynamic_pressure");
+const Timers::TimerId TIMER_GRID_CACHE_REBUILD = Timers::intern("grid_cache_rebuild");
+const Timers::TimerId TIMER_HYDROSTATIC_PRESSURE = Timers::intern("hydrostatic_pressure");
+const Timers::TimerId TIMER_ORGANISM_SUPPORT = Timers::intern("organism_support");
+const Timers::TimerId TIMER_PRESSURE_DECAY = Timers::intern("pressure_decay");
+const Timers::TimerId TIMER_PRESSURE_DIFFUSION = Timers::intern("pressure_diffusion");
+const Timers::TimerId TIMER_PROCESS_MOVES = Timers::intern("process_moves");
+const Timers::TimerId TIMER_PROCESS_MOVES_SHUFFLE = Timers::intern("process_moves_shuffle");
+const Timers::TimerId TIMER_RESOLVE_FORCES = Timers::intern("resolve_forces");
+const Timers::TimerId TIMER_RESOLVE_FORCES_APPLY_AIR_RESISTANCE =
+    Timers::intern("resolve_forces_apply_air_resistance");
+const Timers::TimerId TIMER_RESOLVE_FORCES_APPLY_COHESION =
+    Timers::intern("resolve_forces_apply_cohesion");
+const Timers::TimerId TIMER_RESOLVE_FORCES_APPLY_FRICTION =
+    Timers::intern("resolve_forces_apply_friction");
+const Timers::TimerId TIMER_RESOLVE_FORCES_APPLY_GRAVITY =
+    Timers::intern("resolve_forces_apply_gravity");
+const Timers::TimerId TIMER_RESOLVE_FORCES_APPLY_PRESSURE =
+    Timers::intern("resolve_forces_apply_pressure");
+const Timers::TimerId TIMER_RESOLVE_FORCES_CLEAR_PENDING =
+    Timers::intern("resolve_forces_clear_pending");
+const Timers::TimerId TIMER_RESOLVE_FORCES_RESOLUTION_LOOP =
+    Timers::intern("resolve_forces_resolution_loop");
+const Timers::TimerId TIMER_TREE_ORGANISMS = Timers::intern("tree_organisms");
+const Timers::TimerId TIMER_UPDATE_TRANSFERS = Timers::intern("update_transfers");
+const Timers::TimerId TIMER_VELOCITY_LIMITING = Timers::intern("velocity_limiting");
+
+// Runs body(x, y) over every cell, split across OpenMP workers when parallel is set. Callers
+// hold a ScopeTimer with traceId; each worker's share shows up as its own trace slice.
+template <typename Body>
+void forEachCell(
+    uint32_t width,
+    uint32_t height,
+    [[maybe_unused]] bool parallel,
+    Timers::TimerId traceId,
+    Body&& body)
+{
+#ifdef _OPENMP
+#pragma omp parallel if (parallel)
+#endif
+    {
+        TraceScope workerTrace(traceId);
+#ifdef _OPENMP
+#pragma omp for collapse(2) schedule(static)
+#endif
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                body(x, y);
+            }
+        }
+    }
+}
+
+} // namespace
+
 // =================================================================
 // PIMPL IMPLEMENTATION STRUCT
 // =================================================================
@@ -62,9 +127,14 @@ struct World::Impl {
 
     // Performance timing.
     mutable Timers timers_;
+    StepStats last_step_stats_;
 
-    // Constructor.
-    Impl() { timers_.startTimer("total_simulation"); }
+    // Constructor. Physics stages run on the thread that owns the hardware counters.
+    Impl()
+    {
+        timers_.setHardwareCountersEnabled(true);
+        timers_.startTimer("total_simulation");
+    }
 
     // Destructor.
     ~Impl() { timers_.stopTimer("total_simulation"); }
@@ -178,6 +248,29 @@ const Timers& World::getTimers() const
     return pImpl->timers_;
 }
 
+const World::StepStats& World::getLastStepStats() const
+{
+    return pImpl->last_step_stats_;
+}
+
+World::MemoryUsage World::getMemoryUsage() const
+{
+    const WorldData& data = pImpl->data_;
+    MemoryUsage usage;
+    usage.cells = data.cells.capacity() * sizeof(Cell);
+    usage.debug_info = data.debug_info.capacity() * sizeof(CellDebug);
+    if (pImpl->grid_) {
+        usage.bitmaps = pImpl->grid_->bitmapBytes();
+        usage.neighborhoods = pImpl->grid_->neighborhoodBytes();
+    }
+    if (tree_manager_) {
+        usage.tree_maps = tree_manager_->memoryBytes();
+    }
+    usage.move_queues = pImpl->pending_moves_.capacity() * sizeof(MaterialMove)
+        + pImpl->organism_transfers_.capacity() * sizeof(OrganismTransfer);
+    return usage;
+}
+
 void World::dumpTimerStats() const
 {
     pImpl->timers_.dumpTimerStats();
@@ -452,7 +545,7 @@ std::string World::toAsciiDiagram() const
 
 void World::advanceTime(double deltaTimeSeconds)
 {
-    ScopeTimer timer(pImpl->timers_, "advance_time");
+    ScopeTimer timer(pImpl->timers_, TIMER_ADVANCE_TIME);
 
     const double scaledDeltaTime = deltaTimeSeconds * pImpl->physicsSettings_.timescale;
     spdlog::debug(
@@ -465,29 +558,41 @@ void World::advanceTime(double deltaTimeSeconds)
 
     // Rebuild grid cache for current frame (maps may have changed from previous step).
     {
-        ScopeTimer timer(pImpl->timers_, "grid_cache_rebuild");
-        pImpl->grid_.emplace(
-            pImpl->data_.cells, pImpl->data_.debug_info, pImpl->data_.width, pImpl->data_.height);
+        ScopeTimer timer(pImpl->timers_, TIMER_GRID_CACHE_REBUILD);
+        if (pImpl->grid_) {
+            pImpl->grid_->rebuild(pImpl->data_.width, pImpl->data_.height);
+        }
+        else {
+            pImpl->grid_.emplace(
+                pImpl->data_.cells,
+                pImpl->data_.debug_info,
+                pImpl->data_.width,
+                pImpl->data_.height);
+        }
     }
     GridOfCells& grid = *pImpl->grid_;
 
+    StepStats& stats = pImpl->last_step_stats_;
+    stats.active_cells = pImpl->data_.width * pImpl->data_.height
+        - grid.emptyCells().countSet() - grid.wallCells().countSet();
+
     // Pre-compute support map for all cells (bottom-up pass).
     {
-        ScopeTimer supportMapTimer(pImpl->timers_, "compute_support_map");
+        ScopeTimer supportMapTimer(pImpl->timers_, TIMER_COMPUTE_SUPPORT_MAP);
         WorldSupportCalculator support_calc{ grid };
         support_calc.computeSupportMapBottomUp(*this);
     }
 
     // Compute organism-specific support (root-based anchoring).
     if (tree_manager_) {
-        ScopeTimer organismTimer(pImpl->timers_, "organism_support");
+        ScopeTimer organismTimer(pImpl->timers_, TIMER_ORGANISM_SUPPORT);
         tree_manager_->computeOrganismSupport(*this);
     }
 
     // Calculate hydrostatic pressure based on current material positions.
     // This must happen before force resolution so buoyancy forces are immediate.
     if (pImpl->physicsSettings_.pressure_hydrostatic_strength > 0.0) {
-        ScopeTimer hydroTimer(pImpl->timers_, "hydrostatic_pressure");
+        ScopeTimer hydroTimer(pImpl->timers_, TIMER_HYDROSTATIC_PRESSURE);
         pImpl->pressure_calculator_.calculateHydrostaticPressure(*this);
     }
 
@@ -496,22 +601,25 @@ void World::advanceTime(double deltaTimeSeconds)
     resolveForces(scaledDeltaTime, grid);
 
     {
-        ScopeTimer velocityTimer(pImpl->timers_, "velocity_limiting");
+        ScopeTimer velocityTimer(pImpl->timers_, TIMER_VELOCITY_LIMITING);
         processVelocityLimiting(scaledDeltaTime);
     }
 
     {
-        ScopeTimer transfersTimer(pImpl->timers_, "update_transfers");
+        ScopeTimer transfersTimer(pImpl->timers_, TIMER_UPDATE_TRANSFERS);
         updateTransfers(scaledDeltaTime);
     }
+    stats.pending_moves = static_cast<uint32_t>(pImpl->pending_moves_.size());
 
     // Process queued material moves - this detects NEW blocked transfers.
     processMaterialMoves();
+    stats.blocked_transfers =
+        static_cast<uint32_t>(pImpl->pressure_calculator_.blocked_transfers_.size());
 
     // Process any blocked transfers that were queued during processMaterialMoves.
     // This generates dynamic pressure from collisions.
     if (pImpl->physicsSettings_.pressure_dynamic_strength > 0.0) {
-        ScopeTimer dynamicTimer(pImpl->timers_, "dynamic_pressure");
+        ScopeTimer dynamicTimer(pImpl->timers_, TIMER_DYNAMIC_PRESSURE);
         // Generate virtual gravity transfers to create pressure from gravity forces.
         // This allows dynamic pressure to model hydrostatic-like behavior.
         //        pImpl->pressure_calculator_.generateVirtualGravityTransfers(scaledDeltaTime);
@@ -523,19 +631,19 @@ void World::advanceTime(double deltaTimeSeconds)
 
     // Apply pressure diffusion before decay.
     if (pImpl->physicsSettings_.pressure_diffusion_strength > 0.0) {
-        ScopeTimer diffusionTimer(pImpl->timers_, "pressure_diffusion");
+        ScopeTimer diffusionTimer(pImpl->timers_, TIMER_PRESSURE_DIFFUSION);
         pImpl->pressure_calculator_.applyPressureDiffusion(*this, scaledDeltaTime);
     }
 
     // Apply pressure decay after material moves.
     {
-        ScopeTimer decayTimer(pImpl->timers_, "pressure_decay");
+        ScopeTimer decayTimer(pImpl->timers_, TIMER_PRESSURE_DECAY);
         pImpl->pressure_calculator_.applyPressureDecay(*this, scaledDeltaTime);
     }
 
     // Update tree organisms after physics is complete.
     if (tree_manager_) {
-        ScopeTimer treeTimer(pImpl->timers_, "tree_organisms");
+        ScopeTimer treeTimer(pImpl->timers_, TIMER_TREE_ORGANISMS);
         tree_manager_->update(*this, scaledDeltaTime);
     }
 
@@ -582,6 +690,37 @@ void World::addMaterialAtCell(uint32_t x, uint32_t y, MaterialType type, double
     }
 }
 
+uint32_t World::applyCellEdits(const std::vector<CellEdit>& edits)
+{
+    ScopeTimer timer(pImpl->timers_, TIMER_APPLY_CELL_EDITS);
+
+    // The GridOfCells cache needs no update: advanceTime() rebuilds it before every step.
+    WorldData& data = pImpl->data_;
+
+    uint32_t changed = 0;
+    for (const CellEdit& edit : edits) {
+        if (edit.x >= data.width || edit.y >= data.height) {
+            continue;
+        }
+
+        Cell& cell = data.at(edit.x, edit.y);
+        if (cell.organism_id != 0) {
+            continue;
+        }
+
+        if (edit.material == MaterialType::AIR || edit.fill < MIN_MATTER_THRESHOLD) {
+            cell.clear();
+        }
+        else {
+            cell.replaceMaterial(edit.material, edit.fill);
+        }
+        changed++;
+    }
+
+    spdlog::debug("World: Applied {} of {} cell edits", changed, edits.size());
+    return changed;
+}
+
 // =================================================================.
 // GRID MANAGEMENT.
 // =================================================================.
@@ -707,19 +846,19 @@ void World::applyCohesionForces(const GridOfCells& grid)
     WorldCohesionCalculator cohesion_calc{};
 
     {
-        ScopeTimer cohesionTimer(timers, "cohesion_calculation");
+        ScopeTimer cohesionTimer(timers, TIMER_COHESION_CALCULATION);
 
         // Parallelize when both cache and OpenMP are enabled.
-#ifdef _OPENMP
-#pragma omp parallel for collapse(2) schedule(static) if ( \
-        GridOfCells::USE_CACHE && GridOfCells::USE_OPENMP && data.height * data.width >= 2500)
-#endif
-        for (uint32_t y = 0; y < data.height; ++y) {
-            for (uint32_t x = 0; x < data.width; ++x) {
+        forEachCell(
+            data.width,
+            data.height,
+            GridOfCells::USE_CACHE && GridOfCells::USE_OPENMP && data.height * data.width >= 2500,
+            TIMER_COHESION_CALCULATION,
+            [&](uint32_t x, uint32_t y) {
                 Cell& cell = data.at(x, y);
 
                 if (cell.isEmpty() || cell.isWall()) {
-                    continue;
+                    return;
                 }
 
                 // Calculate COM cohesion force (passes grid for cache optimization).
@@ -747,25 +886,24 @@ void World::applyCohesionForces(const GridOfCells& grid)
                 // Store for visualization in GridOfCells debug info.
                 const_cast<GridOfCells&>(grid).debugAt(x, y).accumulated_com_cohesion_force =
                     com_cohesion_force;
-            }
-        }
+            });
     }
 
     // Adhesion force accumulation (only if enabled).
     if (settings.adhesion_strength > 0.0) {
-        ScopeTimer adhesionTimer(timers, "adhesion_calculation");
+        ScopeTimer adhesionTimer(timers, TIMER_ADHESION_CALCULATION);
 
         // Parallelize when both cache and OpenMP are enabled.
-#ifdef _OPENMP
-#pragma omp parallel for collapse(2) schedule(static) if ( \
-        GridOfCells::USE_CACHE && GridOfCells::USE_OPENMP && data.height * data.width >= 2500)
-#endif
-        for (uint32_t y = 0; y < data.height; ++y) {
-            for (uint32_t x = 0; x < data.width; ++x) {
+        forEachCell(
+            data.width,
+            data.height,
+            GridOfCells::USE_CACHE && GridOfCells::USE_OPENMP && data.height * data.width >= 2500,
+            TIMER_ADHESION_CALCULATION,
+            [&](uint32_t x, uint32_t y) {
                 Cell& cell = data.at(x, y);
 
                 if (cell.isEmpty() || cell.isWall()) {
-                    continue;
+                    return;
                 }
 
                 // Use cache-optimized version with MaterialNeighborhood.
@@ -778,8 +916,7 @@ void World::applyCohesionForces(const GridOfCells& grid)
                 // Store for visualization in GridOfCells debug info.
                 const_cast<GridOfCells&>(grid).debugAt(x, y).accumulated_adhesion_force =
                     adhesion_force;
-            }
-        }
+            });
     }
 }
 
@@ -797,30 +934,30 @@ void World::applyPressureForces()
 
     // Apply pressure forces through the pending force system.
     // Parallelize when both cache and OpenMP are enabled.
-#ifdef _OPENMP
-#pragma omp parallel for collapse(2) schedule(static) if ( \
-        GridOfCells::USE_CACHE && GridOfCells::USE_OPENMP && data.height * data.width >= 2500)
-#endif
-    for (uint32_t y = 0; y < data.height; ++y) {
-        for (uint32_t x = 0; x < data.width; ++x) {
+    forEachCell(
+        data.width,
+        data.height,
+        GridOfCells::USE_CACHE && GridOfCells::USE_OPENMP && data.height * data.width >= 2500,
+        TIMER_RESOLVE_FORCES_APPLY_PRESSURE,
+        [&](uint32_t x, uint32_t y) {
             Cell& cell = data.at(x, y);
 
             // Skip empty cells and walls.
             if (cell.isEmpty() || cell.isWall()) {
-                continue;
+                return;
             }
 
             // Rigid materials don't flow from pressure - they transmit stress instead.
             // Only fluids and granular materials respond to pressure gradients.
             const MaterialProperties& props = getMaterialProperties(cell.material_type);
             if (props.is_rigid) {
-                continue;
+                return;
             }
 
             // Get total pressure for this cell.
             double total_pressure = cell.pressure;
             if (total_pressure < MIN_MATTER_THRESHOLD) {
-                continue;
+                return;
             }
 
             // Calculate pressure gradient to determine force direction.
@@ -847,8 +984,7 @@ void World::applyPressureForces()
                     pressure_force.x,
                     pressure_force.y);
             }
-        }
-    }
+        });
 }
 
 void World::resolveForces(double deltaTime, const GridOfCells& grid)
@@ -861,11 +997,11 @@ void World::resolveForces(double deltaTime, const GridOfCells& grid)
     WorldData& data = pImpl->data_;
     std::vector<Cell>& cells = data.cells;
 
-    ScopeTimer timer(timers, "resolve_forces");
+    ScopeTimer timer(timers, TIMER_RESOLVE_FORCES);
 
     // Clear pending forces at the start of each physics frame.
     {
-        ScopeTimer clearTimer(timers, "resolve_forces_clear_pending");
+        ScopeTimer clearTimer(timers, TIMER_RESOLVE_FORCES_CLEAR_PENDING);
         for (auto& cell : cells) {
             cell.clearPendingForce();
         }
@@ -873,31 +1009,31 @@ void World::resolveForces(double deltaTime, const GridOfCells& grid)
 
     // Apply gravity forces.
     {
-        ScopeTimer gravityTimer(timers, "resolve_forces_apply_gravity");
+        ScopeTimer gravityTimer(timers, TIMER_RESOLVE_FORCES_APPLY_GRAVITY);
         applyGravity();
     }
 
     // Apply air resistance forces.
     {
-        ScopeTimer airResistanceTimer(timers, "resolve_forces_apply_air_resistance");
+        ScopeTimer airResistanceTimer(timers, TIMER_RESOLVE_FORCES_APPLY_AIR_RESISTANCE);
         applyAirResistance();
     }
 
     // Apply pressure forces from previous frame.
     {
-        ScopeTimer pressureTimer(timers, "resolve_forces_apply_pressure");
+        ScopeTimer pressureTimer(timers, TIMER_RESOLVE_FORCES_APPLY_PRESSURE);
         applyPressureForces();
     }
 
     // Apply cohesion and adhesion forces.
     {
-        ScopeTimer cohesionTimer(timers, "resolve_forces_apply_cohesion");
+        ScopeTimer cohesionTimer(timers, TIMER_RESOLVE_FORCES_APPLY_COHESION);
         applyCohesionForces(grid);
     }
 
     // Apply contact-based friction forces.
     {
-        ScopeTimer frictionTimer(timers, "resolve_forces_apply_friction");
+        ScopeTimer frictionTimer(timers, TIMER_RESOLVE_FORCES_APPLY_FRICTION);
         // Construct friction calculator with grid reference (like WorldSupportCalculator pattern).
         // Cast away const for debug writes (safe - doesn't affect physics state).
         WorldFrictionCalculator friction_calc{ const_cast<GridOfCells&>(grid) };
@@ -907,20 +1043,20 @@ void World::resolveForces(double deltaTime, const GridOfCells& grid)
 
     // Apply viscous forces (momentum diffusion between same-material neighbors).
     if (settings.viscosity_strength > 0.0) {
-        ScopeTimer viscosityTimer(timers, "apply_viscous_forces");
+        ScopeTimer viscosityTimer(timers, TIMER_APPLY_VISCOUS_FORCES);
         double visc_strength = settings.viscosity_strength; // Cache once for entire loop.
 
         // Parallelize when cache is enabled (use sequential for reference path).
-#ifdef _OPENMP
-#pragma omp parallel for collapse(2) \
-    schedule(static) if (GridOfCells::USE_CACHE && data.height * data.width >= 2500)
-#endif
-        for (uint32_t y = 0; y < data.height; ++y) {
-            for (uint32_t x = 0; x < data.width; ++x) {
+        forEachCell(
+            data.width,
+            data.height,
+            GridOfCells::USE_CACHE && data.height * data.width >= 2500,
+            TIMER_APPLY_VISCOUS_FORCES,
+            [&](uint32_t x, uint32_t y) {
                 Cell& cell = data.at(x, y);
 
                 if (cell.isEmpty() || cell.isWall()) {
-                    continue;
+                    return;
                 }
 
                 // Calculate viscous force from neighbor velocity averaging.
@@ -931,13 +1067,12 @@ void World::resolveForces(double deltaTime, const GridOfCells& grid)
                 // Store for visualization in GridOfCells debug info.
                 const_cast<GridOfCells&>(grid).debugAt(x, y).accumulated_viscous_force =
                     viscous_result.force;
-            }
-        }
+            });
     }
 
     // Now resolve all accumulated forces directly (no damping).
     {
-        ScopeTimer resolutionLoopTimer(timers, "resolve_forces_resolution_loop");
+        ScopeTimer resolutionLoopTimer(timers, TIMER_RESOLVE_FORCES_RESOLUTION_LOOP);
 
         // Use bitmaps to skip empty/wall cells before dereferencing Cell object.
         const CellBitmap& empty_bitmap = grid.emptyCells();
@@ -1017,25 +1152,20 @@ void World::processVelocityLimiting(double deltaTime)
 
 void World::updateTransfers(double deltaTime)
 {
-    ScopeTimer timer(pImpl->timers_, "update_transfers");
+    ScopeTimer timer(pImpl->timers_, TIMER_UPDATE_TRANSFERS);
 
-    // Clear previous moves.
-    pImpl->pending_moves_.clear();
-
-    // Compute material moves based on COM positions and velocities.
-    pImpl->pending_moves_ = computeMaterialMoves(deltaTime);
+    // Compute material moves based on COM positions and velocities, refilling the queue in
+    // place so its capacity carries over between steps.
+    computeMaterialMoves(deltaTime, pImpl->pending_moves_);
 }
 
-std::vector<MaterialMove> World::computeMaterialMoves(double deltaTime)
+void World::computeMaterialMoves(double deltaTime, std::vector<MaterialMove>& moves)
 {
     // Cache pImpl members as local references.
     WorldCollisionCalculator& collision_calc = pImpl->collision_calculator_;
     WorldData& data = pImpl->data_;
 
-    // Pre-allocate moves vector based on previous frame's count.
-    static size_t last_move_count = 0;
-    std::vector<MaterialMove> moves;
-    moves.reserve(last_move_count + last_move_count / 10); // +10% buffer
+    moves.clear();
 
     // Counters for move generation analysis.
     size_t num_cells_with_velocity = 0;
@@ -1189,11 +1319,6 @@ std::vector<MaterialMove> World::computeMaterialMoves(double deltaTime)
         num_moves_generated,
         num_transfers_generated,
         num_collisions_generated);
-
-    // Update last move count for next frame's pre-allocation.
-    last_move_count = moves.size();
-
-    return moves;
 }
 
 void World::processMaterialMoves()
@@ -1206,7 +1331,7 @@ void World::processMaterialMoves()
     std::vector<MaterialMove>& pending_moves = pImpl->pending_moves_;
     std::vector<OrganismTransfer>& organism_transfers = pImpl->organism_transfers_;
 
-    ScopeTimer timer(timers, "process_moves");
+    ScopeTimer timer(timers, TIMER_PROCESS_MOVES);
 
     // Counters for analysis.
     size_t num_moves = pending_moves.size();
@@ -1219,7 +1344,7 @@ void World::processMaterialMoves()
 
     // Shuffle moves to handle conflicts randomly.
     {
-        ScopeTimer shuffleTimer(timers, "process_moves_shuffle");
+        ScopeTimer shuffleTimer(timers, TIMER_PROCESS_MOVES_SHUFFLE);
         std::shuffle(pending_moves.begin(), pending_moves.end(), *rng_);
     }
 
@@ -1352,7 +1477,7 @@ void World::processMaterialMoves()
 
     // Notify TreeManager of all organism transfers for efficient tracking updates.
     if (!organism_transfers.empty() && tree_manager_) {
-        tree_manager_->notifyTransfers(organism_transfers);
+        tree_manager_->notifyTransfers(*this, organism_transfers);
         organism_transfers.clear();
     }
 }
@@ -173,6 +173,25 @@ public:
     Timers& getTimers();
     const Timers& getTimers() const;
 
+    // Work counters from the most recent advanceTime() (for the server flight recorder).
+    struct StepStats {
+        uint32_t active_cells = 0; // Non-empty, non-wall cells at the start of the step.
+        uint32_t pending_moves = 0;
+        uint32_t blocked_transfers = 0;
+    };
+    const StepStats& getLastStepStats() const;
+
+    // Bytes held (container capacity) by each subsystem, for memory_stats_get.
+    struct MemoryUsage {
+        size_t cells = 0;
+        size_t debug_info = 0;
+        size_t bitmaps = 0;       // GridOfCells empty/wall/support bitmaps.
+        size_t neighborhoods = 0; // GridOfCells precomputed 3x3 neighborhoods.
+        size_t tree_maps = 0;     // TreeManager trees and cell ownership.
+        size_t move_queues = 0;   // Pending material and organism transfers.
+    };
+    MemoryUsage getMemoryUsage() const;
+
     // =================================================================
     // WORLD-SPECIFIC METHODS
     // =================================================================
@@ -180,6 +199,21 @@ public:
     // Add material at specific cell coordinates.
     void addMaterialAtCell(uint32_t x, uint32_t y, MaterialType type, double amount = 1.0);
 
+    // One cell overwrite for applyCellEdits (AIR or zero fill clears the cell).
+    struct CellEdit {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        MaterialType material = MaterialType::AIR;
+        double fill = 1.0;
+    };
+
+    /**
+     * Overwrite many cells in one pass between steps. Edits apply in order, so later
+     * edits win. Organism-owned cells are left to TreeManager and skipped. Returns the
+     * cells written.
+     */
+    uint32_t applyCellEdits(const std::vector<CellEdit>& edits);
+
     /**
      * Record an organism material transfer for efficient TreeManager tracking.
      * Called during physics transfers to maintain organism ownership consistency.
@@ -215,7 +249,8 @@ public:
     // =================================================================
 
     // Material transfer computation - computes moves without processing them.
-    std::vector<MaterialMove> computeMaterialMoves(double deltaTime);
+    // Replaces the contents of moves, reusing its capacity.
+    void computeMaterialMoves(double deltaTime, std::vector<MaterialMove>& moves);
 
     // =================================================================
     // JSON SERIALIZATION
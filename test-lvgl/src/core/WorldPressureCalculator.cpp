@@ -598,7 +598,8 @@ void WorldPressureCalculator::applyPressureDiffusion(World& world, double deltaT
     const PhysicsSettings& settings = world.getPhysicsSettings();
     const uint32_t width = data.width;
     const uint32_t height = data.height;
-    std::vector<double> new_pressure(width * height);
+    std::vector<double>& new_pressure = diffusion_scratch_;
+    new_pressure.resize(static_cast<size_t>(width) * height);
 
     // Copy current pressure values.
     for (uint32_t y = 0; y < height; ++y) {
@@ -147,6 +147,9 @@ private:
     // Configuration for pressure gradient calculation.
     PressureGradientDirections gradient_directions_ = PressureGradientDirections::Eight;
 
+    // Next-step pressures for applyPressureDiffusion, kept to avoid a per-step allocation.
+    std::vector<double> diffusion_scratch_;
+
     // Constants for pressure-driven flow.
     static constexpr double PRESSURE_FLOW_RATE = 1.0;     // Flow rate multiplier.
     static constexpr double BACKGROUND_DECAY_RATE = 0.02; // 2% decay per timestep.
@@ -1,14 +1,17 @@
 #pragma once
 
-#include "core/WorldData.h"
+#include "core/RenderFrame.h"
 #include <chrono>
 #include <cstdint>
+#include <memory>
 
 namespace DirtSim {
 
 struct UiUpdateEvent {
     uint64_t sequenceNum = 0;
-    WorldData worldData; // Just the data, no physics calculators needed for rendering.
+    // Received frame, rendered straight from its wire payload. Shared so queueing, frame
+    // dropping and state transitions never copy cell data.
+    std::shared_ptr<const RenderFrame> frame;
     uint32_t fps = 0;
     uint64_t stepCount = 0;
     bool isPaused = false;
@@ -1,5 +1,7 @@
 #include "CellBitmap.h"
 
+#include <bit>
+
 namespace DirtSim {
 
 CellBitmap::CellBitmap(uint32_t width, uint32_t height) : grid_width_(width), grid_height_(height)
@@ -12,6 +14,15 @@ CellBitmap::CellBitmap(uint32_t width, uint32_t height) : grid_width_(width), gr
     blocks_.resize(blocks_x_ * blocks_y_, 0);
 }
 
+void CellBitmap::reset(uint32_t width, uint32_t height)
+{
+    grid_width_ = width;
+    grid_height_ = height;
+    blocks_x_ = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    blocks_y_ = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    blocks_.assign(blocks_x_ * blocks_y_, 0);
+}
+
 inline void CellBitmap::cellToBlockAndBit(
     uint32_t x, uint32_t y, uint32_t& block_idx, int& bit_idx) const
 {
@@ -68,6 +79,55 @@ bool CellBitmap::isBlockAllClear(uint32_t block_x, uint32_t block_y) const
     return getBlock(block_x, block_y) == 0;
 }
 
+uint32_t CellBitmap::countSet() const
+{
+    uint32_t count = 0;
+    for (const uint64_t block : blocks_) {
+        count += std::popcount(block);
+    }
+    return count;
+}
+
+bool CellBitmap::dilateWithin(const CellBitmap& mask)
+{
+    // Bit columns 0 and 7 of every row in a block.
+    constexpr uint64_t COLUMN_0 = 0x0101010101010101ULL;
+    constexpr uint64_t COLUMN_7 = COLUMN_0 << 7;
+
+    bool changed = false;
+    for (uint32_t block_y = 0; block_y < blocks_y_; ++block_y) {
+        for (uint32_t block_x = 0; block_x < blocks_x_; ++block_x) {
+            const uint32_t idx = block_y * blocks_x_ + block_x;
+            const uint64_t block = blocks_[idx];
+
+            // Within the block: left/right shifts drop bits that would wrap across rows.
+            uint64_t spread = ((block << 1) & ~COLUMN_0) | ((block >> 1) & ~COLUMN_7)
+                | (block << 8) | (block >> 8);
+
+            // Edge carries from neighbouring blocks.
+            if (block_x > 0) {
+                spread |= (blocks_[idx - 1] & COLUMN_7) >> 7;
+            }
+            if (block_x + 1 < blocks_x_) {
+                spread |= (blocks_[idx + 1] & COLUMN_0) << 7;
+            }
+            if (block_y > 0) {
+                spread |= blocks_[idx - blocks_x_] >> 56;
+            }
+            if (block_y + 1 < blocks_y_) {
+                spread |= blocks_[idx + blocks_x_] << 56;
+            }
+
+            const uint64_t grown = block | (spread & mask.blocks_[idx]);
+            if (grown != block) {
+                blocks_[idx] = grown;
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
 Neighborhood3x3 CellBitmap::getNeighborhood3x3(uint32_t x, uint32_t y) const
 {
     uint32_t block_x = x >> 3;
@@ -2,6 +2,7 @@
 
 #include "Neighborhood3x3.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -35,6 +36,9 @@ private:
 public:
     CellBitmap(uint32_t width, uint32_t height);
 
+    // Resize to width × height with every bit clear, reusing the block storage.
+    void reset(uint32_t width, uint32_t height);
+
     // Core bit operations.
     void set(uint32_t x, uint32_t y);
     void clear(uint32_t x, uint32_t y);
@@ -45,6 +49,20 @@ public:
     bool isBlockAllSet(uint32_t block_x, uint32_t block_y) const;   // All bits = 1.
     bool isBlockAllClear(uint32_t block_x, uint32_t block_y) const; // All bits = 0.
 
+    // Number of set cells (popcount over all blocks).
+    uint32_t countSet() const;
+
+    /**
+     * One step of 4-connected dilation constrained to mask (same dimensions): set cells
+     * spread to their cardinal neighbours that are set in mask. Works on whole blocks with
+     * shifts (within a block) and edge carries (between blocks), updating in place.
+     * Returns true if any bit was added; repeat until false to flood fill.
+     */
+    bool dilateWithin(const CellBitmap& mask);
+
+    // Heap bytes held by the block storage.
+    size_t memoryBytes() const { return blocks_.capacity() * sizeof(uint64_t); }
+
     // Neighborhood extraction.
     Neighborhood3x3 getNeighborhood3x3(uint32_t x, uint32_t y) const;
 
@@ -133,3 +133,48 @@ TEST(CellBitmapTest, Dimensions)
     EXPECT_EQ(bitmap.getWidth(), 123);
     EXPECT_EQ(bitmap.getHeight(), 456);
 }
+
+// Test flood fill by repeated dilation stays inside the mask and crosses block edges.
+TEST(CellBitmapTest, DilateWithinFloodFillsConnectedMaskCells)
+{
+    CellBitmap mask(20, 20);
+    CellBitmap filled(20, 20);
+
+    // An L-shaped path spanning several blocks, plus an island that is not connected.
+    for (uint32_t y = 2; y < 18; ++y) {
+        mask.set(7, y);
+    }
+    for (uint32_t x = 7; x < 19; ++x) {
+        mask.set(x, 17);
+    }
+    mask.set(15, 5);
+    mask.set(16, 5);
+
+    filled.set(7, 2);
+    int steps = 0;
+    while (filled.dilateWithin(mask)) {
+        ++steps;
+    }
+
+    EXPECT_GT(steps, 0);
+    EXPECT_EQ(filled.countSet(), 16u + 11u);
+    EXPECT_TRUE(filled.isSet(7, 17));
+    EXPECT_TRUE(filled.isSet(18, 17));
+    EXPECT_FALSE(filled.isSet(15, 5));
+    EXPECT_FALSE(filled.isSet(16, 5));
+
+    // Bits must not wrap between rows at block column edges.
+    CellBitmap row_mask(16, 8);
+    CellBitmap row(16, 8);
+    row_mask.set(0, 1);
+    row.set(7, 0);
+    row_mask.set(7, 0);
+    while (row.dilateWithin(row_mask)) {}
+    EXPECT_FALSE(row.isSet(0, 1));
+
+    // Reset clears and resizes, reusing storage.
+    filled.reset(9, 3);
+    EXPECT_EQ(filled.getWidth(), 9u);
+    EXPECT_EQ(filled.getBlocksX(), 2u);
+    EXPECT_EQ(filled.countSet(), 0u);
+}
@@ -0,0 +1,72 @@
+#include "MaterialSumTable.h"
+#include "core/Cell.h"
+#include "core/WorldData.h"
+#include <algorithm>
+
+namespace DirtSim {
+
+void MaterialSumTable::build(const WorldData& data, const Vector2i& min, const Vector2i& max)
+{
+    const int x0 = std::max(0, min.x);
+    const int y0 = std::max(0, min.y);
+    const int x1 = std::min(static_cast<int>(data.width) - 1, max.x);
+    const int y1 = std::min(static_cast<int>(data.height) - 1, max.y);
+    if (x1 < x0 || y1 < y0) {
+        clear();
+        return;
+    }
+
+    origin_ = Vector2i{ x0, y0 };
+    width_ = x1 - x0 + 1;
+    height_ = y1 - y0 + 1;
+
+    const size_t stride = static_cast<size_t>(width_ + 1) * NUM_MATERIALS;
+    sums_.assign(stride * (height_ + 1), 0);
+
+    for (int y = 0; y < height_; ++y) {
+        // Running per-material counts along this row, added to the row above.
+        Counts row = {};
+        const uint32_t* above = &sums_[y * stride + NUM_MATERIALS];
+        uint32_t* out = &sums_[(y + 1) * stride + NUM_MATERIALS];
+        for (int x = 0; x < width_; ++x) {
+            const int material = static_cast<int>(data.at(x0 + x, y0 + y).material_type);
+            if (material < NUM_MATERIALS) {
+                row[material]++;
+            }
+            for (int m = 0; m < NUM_MATERIALS; ++m) {
+                out[m] = above[m] + row[m];
+            }
+            above += NUM_MATERIALS;
+            out += NUM_MATERIALS;
+        }
+    }
+}
+
+void MaterialSumTable::clear()
+{
+    width_ = 0;
+    height_ = 0;
+    sums_.clear();
+}
+
+bool MaterialSumTable::covers(int x0, int y0, int x1, int y1) const
+{
+    return x0 >= origin_.x && y0 >= origin_.y && x1 <= origin_.x + width_
+        && y1 <= origin_.y + height_ && width_ > 0;
+}
+
+MaterialSumTable::Counts MaterialSumTable::count(int x0, int y0, int x1, int y1) const
+{
+    const uint32_t* bottom_right = at(x1 - origin_.x, y1 - origin_.y);
+    const uint32_t* bottom_left = at(x0 - origin_.x, y1 - origin_.y);
+    const uint32_t* top_right = at(x1 - origin_.x, y0 - origin_.y);
+    const uint32_t* top_left = at(x0 - origin_.x, y0 - origin_.y);
+
+    Counts counts;
+    for (int m = 0; m < NUM_MATERIALS; ++m) {
+        counts[m] = bottom_right[m] - bottom_left[m] - top_right[m] + top_left[m];
+    }
+    return counts;
+}
+
+} // namespace DirtSim
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "TreeSensoryData.h"
+#include "core/Vector2i.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DirtSim {
+
+struct WorldData;
+
+/**
+ * Per-material summed-area tables over a world rectangle.
+ *
+ * Built once per step (after organisms have mutated the world) over the union of the
+ * regions that large trees sense, then shared read-only by every tree, so counting the
+ * materials in any rectangle is four lookups per material regardless of its size.
+ */
+class MaterialSumTable {
+public:
+    static constexpr int NUM_MATERIALS = TreeSensoryData::NUM_MATERIALS;
+    using Counts = std::array<uint32_t, NUM_MATERIALS>;
+
+    // Build over the inclusive rectangle [min, max], clipped to the world.
+    void build(const WorldData& data, const Vector2i& min, const Vector2i& max);
+    void clear();
+
+    // True when the half-open rectangle [x0, x1) × [y0, y1) lies inside the built region.
+    bool covers(int x0, int y0, int x1, int y1) const;
+
+    // Cells of each material in the half-open rectangle (which must be covered).
+    Counts count(int x0, int y0, int x1, int y1) const;
+
+    size_t memoryBytes() const { return sums_.capacity() * sizeof(uint32_t); }
+
+private:
+    Vector2i origin_{ 0, 0 };
+    int width_ = 0;
+    int height_ = 0;
+
+    // (width_ + 1) × (height_ + 1) entries with a zero first row and column, each holding
+    // NUM_MATERIALS interleaved counts of the cells above and to the left.
+    std::vector<uint32_t> sums_;
+
+    const uint32_t* at(int x, int y) const
+    {
+        return &sums_[(static_cast<size_t>(y) * (width_ + 1) + x) * NUM_MATERIALS];
+    }
+};
+
+} // namespace DirtSim
@@ -13,6 +13,14 @@ Tree::Tree(TreeId id, std::unique_ptr<TreeBrain> brain) : id(id), brain_(std::mo
 {}
 
 void Tree::update(World& world, double deltaTime)
+{
+    advance(world, deltaTime);
+    if (needsDecision()) {
+        setCommand(decide(world));
+    }
+}
+
+void Tree::advance(World& world, double deltaTime)
 {
     age_seconds += deltaTime;
 
@@ -24,10 +32,6 @@ void Tree::update(World& world, double deltaTime)
         }
     }
 
-    if (!current_command.has_value()) {
-        decideNextAction(world);
-    }
-
     updateResources(world);
 }
 
@@ -40,13 +44,15 @@ void Tree::executeCommand(World& world)
     }
 }
 
-void Tree::decideNextAction(const World& world)
+TreeCommand Tree::decide(const World& world, const MaterialSumTable* sums)
 {
     // Gather sensory data and ask brain for next command.
-    TreeSensoryData sensory = gatherSensoryData(world);
-    TreeCommand command = brain_->decide(sensory);
+    TreeSensoryData sensory = gatherSensoryData(world, sums);
+    return brain_->decide(sensory);
+}
 
-    // Enqueue command.
+void Tree::setCommand(const TreeCommand& command)
+{
     current_command = command;
 
     std::visit(
@@ -88,30 +94,60 @@ void Tree::updateResources(const World& world)
     // - Deduct maintenance costs.
 }
 
-TreeSensoryData Tree::gatherSensoryData(const World& world) const
+void Tree::onCellAdded(const Vector2i& pos)
 {
-    TreeSensoryData data;
+    if (boundsStale_) {
+        return;
+    }
 
-    // Find actual current cell positions by scanning world for organism_id.
-    // This handles cells that have moved due to physics (falling seeds).
-    int min_x = INT32_MAX, min_y = INT32_MAX;
-    int max_x = INT32_MIN, max_y = INT32_MIN;
-    int cell_count = 0;
-
-    for (uint32_t y = 0; y < world.getData().height; y++) {
-        for (uint32_t x = 0; x < world.getData().width; x++) {
-            if (world.getData().at(x, y).organism_id == id) {
-                min_x = std::min(min_x, static_cast<int>(x));
-                min_y = std::min(min_y, static_cast<int>(y));
-                max_x = std::max(max_x, static_cast<int>(x));
-                max_y = std::max(max_y, static_cast<int>(y));
-                cell_count++;
-            }
+    if (cells.size() == 1) {
+        bounds_ = Bounds{ pos, pos };
+        return;
+    }
+    bounds_.min.x = std::min(bounds_.min.x, pos.x);
+    bounds_.min.y = std::min(bounds_.min.y, pos.y);
+    bounds_.max.x = std::max(bounds_.max.x, pos.x);
+    bounds_.max.y = std::max(bounds_.max.y, pos.y);
+}
+
+void Tree::onCellRemoved(const Vector2i& pos)
+{
+    // Interior removals cannot shrink the box.
+    if (pos.x == bounds_.min.x || pos.x == bounds_.max.x || pos.y == bounds_.min.y
+        || pos.y == bounds_.max.y) {
+        boundsStale_ = true;
+    }
+}
+
+std::optional<Tree::Bounds> Tree::getBounds() const
+{
+    if (cells.empty()) {
+        return std::nullopt;
+    }
+
+    if (boundsStale_) {
+        bounds_ = Bounds{ cells.front(), cells.front() };
+        for (const auto& pos : cells) {
+            bounds_.min.x = std::min(bounds_.min.x, pos.x);
+            bounds_.min.y = std::min(bounds_.min.y, pos.y);
+            bounds_.max.x = std::max(bounds_.max.x, pos.x);
+            bounds_.max.y = std::max(bounds_.max.y, pos.y);
         }
+        boundsStale_ = false;
     }
+    return bounds_;
+}
 
-    // No cells found - tree might have been destroyed.
-    if (cell_count == 0) {
+TreeSensoryData Tree::gatherSensoryData(const World& world, const MaterialSumTable* sums) const
+{
+    TreeSensoryData data;
+
+    // Current extent from the incrementally tracked cells (TreeManager follows cells that
+    // move due to physics, e.g. falling seeds), so no world scan is needed.
+    const std::optional<Bounds> bounds = getBounds();
+
+    // No cells - tree might have been destroyed.
+    if (!bounds) {
         data.actual_width = TreeSensoryData::GRID_SIZE;
         data.actual_height = TreeSensoryData::GRID_SIZE;
         data.scale_factor = 1.0;
@@ -119,6 +155,10 @@ TreeSensoryData Tree::gatherSensoryData(const World& world) const
         return data;
     }
 
+    int min_x = bounds->min.x;
+    int min_y = bounds->min.y;
+    int max_x = bounds->max.x;
+    int max_y = bounds->max.y;
     int bbox_width = max_x - min_x + 1;
     int bbox_height = max_y - min_y + 1;
 
@@ -196,17 +236,26 @@ TreeSensoryData Tree::gatherSensoryData(const World& world) const
             wx_end = std::max(0, std::min(static_cast<int>(world.getData().width), wx_end));
             wy_end = std::max(0, std::min(static_cast<int>(world.getData().height), wy_end));
 
-            // Count materials in this region.
-            std::array<int, TreeSensoryData::NUM_MATERIALS> counts = {};
-            int total_cells = 0;
-
-            for (int wy = wy_start; wy < wy_end; wy++) {
-                for (int wx = wx_start; wx < wx_end; wx++) {
-                    const auto& cell = world.getData().at(wx, wy);
-                    int mat_idx = static_cast<int>(cell.material_type);
-                    if (mat_idx >= 0 && mat_idx < TreeSensoryData::NUM_MATERIALS) {
-                        counts[mat_idx]++;
-                        total_cells++;
+            // Count materials in this region: a rectangle query when the shared tables
+            // cover it, otherwise cell by cell.
+            MaterialSumTable::Counts counts = {};
+            uint32_t total_cells = 0;
+
+            if (sums && sums->covers(wx_start, wy_start, wx_end, wy_end)) {
+                counts = sums->count(wx_start, wy_start, wx_end, wy_end);
+                for (const uint32_t count : counts) {
+                    total_cells += count;
+                }
+            }
+            else {
+                for (int wy = wy_start; wy < wy_end; wy++) {
+                    for (int wx = wx_start; wx < wx_end; wx++) {
+                        const auto& cell = world.getData().at(wx, wy);
+                        int mat_idx = static_cast<int>(cell.material_type);
+                        if (mat_idx >= 0 && mat_idx < TreeSensoryData::NUM_MATERIALS) {
+                            counts[mat_idx]++;
+                            total_cells++;
+                        }
                     }
                 }
             }
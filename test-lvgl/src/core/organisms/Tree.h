@@ -1,12 +1,13 @@
 #pragma once
 
+#include "MaterialSumTable.h"
 #include "TreeBrain.h"
 #include "TreeCommands.h"
 #include "TreeSensoryData.h"
 #include <cstdint>
 #include <memory>
 #include <optional>
-#include <unordered_set>
+#include <vector>
 
 namespace DirtSim {
 
@@ -41,28 +42,68 @@ public:
     Tree(const Tree&) = delete;
     Tree& operator=(const Tree&) = delete;
 
+    /**
+     * One organism step for this tree alone. TreeManager runs the same phases across all
+     * trees so brains can decide concurrently:
+     *  1. advance: age, count down and execute a finished command (mutates the world).
+     *  2. decide: gather sensory data and ask the brain, for trees needing a decision
+     *     (reads the world only; safe to run concurrently for different trees).
+     *  3. setCommand: queue the decision.
+     */
     void update(World& world, double deltaTime);
 
+    void advance(World& world, double deltaTime);
+    bool needsDecision() const { return !current_command.has_value(); }
+    TreeCommand decide(const World& world, const MaterialSumTable* sums = nullptr);
+    void setCommand(const TreeCommand& command);
+
+    TreeBrain& getBrain() { return *brain_; }
+    void setBrain(std::unique_ptr<TreeBrain> brain) { brain_ = std::move(brain); }
+
     TreeId id;
     Vector2i seed_position;
     double age_seconds = 0.0;
     GrowthStage stage = GrowthStage::SEED;
-    std::unordered_set<Vector2i> cells;
+    // Owned cell positions, unordered and duplicate-free. Maintained by TreeManager's
+    // ownership index (assignCell/releaseCell); do not modify directly.
+    std::vector<Vector2i> cells;
     double total_energy = 0.0;
     double total_water = 0.0;
     std::optional<TreeCommand> current_command;
     double time_remaining_seconds = 0.0;
 
+    // Inclusive bounding box of the tree's cells.
+    struct Bounds {
+        Vector2i min;
+        Vector2i max;
+    };
+
+    /**
+     * Bounding box of cells, or nullopt when the tree owns none. Grown in place as cells are
+     * assigned; only releasing a cell on the edge forces a rescan, of this tree's cells.
+     */
+    std::optional<Bounds> getBounds() const;
+
     /**
      * Gather scale-invariant sensory data for brain input and UI visualization.
+     * Downsampled histogram buckets are rectangle queries on sums where it covers them.
      */
-    TreeSensoryData gatherSensoryData(const World& world) const;
+    TreeSensoryData gatherSensoryData(
+        const World& world, const MaterialSumTable* sums = nullptr) const;
 
 private:
+    friend class TreeManager;
+
+    mutable Bounds bounds_{};
+    mutable bool boundsStale_ = false;
+
+    // Bounds bookkeeping, called by TreeManager after it edits cells.
+    void onCellAdded(const Vector2i& pos);
+    void onCellRemoved(const Vector2i& pos);
+
     std::unique_ptr<TreeBrain> brain_;
 
     void executeCommand(World& world);
-    void decideNextAction(const World& world);
     void updateResources(const World& world);
 };
 
@@ -1,5 +1,6 @@
 #include "TreeCommandProcessor.h"
 #include "Tree.h"
+#include "TreeManager.h"
 #include "core/Cell.h"
 #include "core/MaterialType.h"
 #include "core/World.h"
@@ -63,7 +64,7 @@ CommandExecutionResult TreeCommandProcessor::execute(
                 world.getData().at(command.target_pos.x, command.target_pos.y).organism_id =
                     tree.id;
 
-                tree.cells.insert(command.target_pos);
+                world.getTreeManager().assignCell(tree, command.target_pos);
                 tree.total_energy -= ENERGY_COST_WOOD;
 
                 spdlog::info(
@@ -119,7 +120,7 @@ CommandExecutionResult TreeCommandProcessor::execute(
                 world.getData().at(command.target_pos.x, command.target_pos.y).organism_id =
                     tree.id;
 
-                tree.cells.insert(command.target_pos);
+                world.getTreeManager().assignCell(tree, command.target_pos);
                 tree.total_energy -= ENERGY_COST_LEAF;
 
                 spdlog::info(
@@ -171,7 +172,7 @@ CommandExecutionResult TreeCommandProcessor::execute(
                 world.getData().at(command.target_pos.x, command.target_pos.y).organism_id =
                     tree.id;
 
-                tree.cells.insert(command.target_pos);
+                world.getTreeManager().assignCell(tree, command.target_pos);
                 tree.total_energy -= ENERGY_COST_ROOT;
 
                 spdlog::info(
@@ -1,4 +1,5 @@
 #include "TreeManager.h"
+#include "brains/NeuralBrain.h"
 #include "brains/RuleBasedBrain.h"
 #include "core/Cell.h"
 #include "core/GridOfCells.h"
@@ -7,24 +8,142 @@
 #include "core/World.h"
 #include "core/WorldData.h"
 #include <algorithm>
-#include <queue>
+#include <functional>
 #include <random>
-#include <unordered_set>
 
 namespace DirtSim {
 
 void TreeManager::update(World& world, double deltaTime)
 {
+    syncIndexSize(world);
+
+    // Deterministic order for everything that mutates the world.
+    update_order_.clear();
     for (auto& [id, tree] : trees_) {
-        tree.update(world, deltaTime);
+        update_order_.push_back(&tree);
+    }
+    std::sort(update_order_.begin(), update_order_.end(), [](const Tree* a, const Tree* b) {
+        return a->id < b->id;
+    });
+
+    // Phase 1 (serial): age trees and execute commands that finished this step.
+    deciding_.clear();
+    for (Tree* tree : update_order_) {
+        tree->advance(world, deltaTime);
+        if (tree->needsDecision()) {
+            deciding_.push_back(tree);
+        }
+    }
+
+    // Phase 2 (parallel): sense and decide against the read-only world. Each tree only
+    // touches its own brain and cached bounds; downsampling trees share material sums
+    // built once over the union of their padded bounding boxes. Neural brains only sense
+    // here and are decided afterwards, batched per network.
+    buildSensorySums(world);
+    decisions_.resize(deciding_.size());
+    sensory_.resize(deciding_.size());
+    const World& view = world;
+    const int count = static_cast<int>(deciding_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if ( \
+        GridOfCells::USE_OPENMP && deciding_.size() >= PARALLEL_DECIDE_MIN_TREES)
+#endif
+    for (int i = 0; i < count; ++i) {
+        sensory_[i] = deciding_[i]->gatherSensoryData(view, &sensory_sums_);
+        if (!dynamic_cast<NeuralBrain*>(&deciding_[i]->getBrain())) {
+            decisions_[i] = deciding_[i]->getBrain().decide(sensory_[i]);
+        }
+    }
+
+    batch_members_.clear();
+    for (size_t i = 0; i < deciding_.size(); ++i) {
+        if (auto* brain = dynamic_cast<NeuralBrain*>(&deciding_[i]->getBrain())) {
+            batch_members_.emplace_back(brain->getNetwork().get(), i);
+        }
+    }
+    std::stable_sort(
+        batch_members_.begin(), batch_members_.end(), [](const auto& a, const auto& b) {
+            return std::less<const NeuralNetwork*>()(a.first, b.first);
+        });
+    for (size_t begin = 0; begin < batch_members_.size();) {
+        size_t end = begin + 1;
+        while (end < batch_members_.size()
+               && batch_members_[end].first == batch_members_[begin].first) {
+            ++end;
+        }
+        decideBatched(begin, end);
+        begin = end;
+    }
+
+    // Phase 3 (serial): queue decisions in ID order.
+    for (size_t i = 0; i < deciding_.size(); ++i) {
+        deciding_[i]->setCommand(decisions_[i]);
     }
 }
 
-TreeId TreeManager::plantSeed(World& world, uint32_t x, uint32_t y)
+void TreeManager::decideBatched(size_t begin, size_t end)
 {
+    const NeuralNetwork& network = *batch_members_[begin].first;
+    const size_t batch = end - begin;
+
+    // Pack the batch into contiguous rows, run one forward pass, then decode each row.
+    batch_inputs_.resize(batch * NeuralBrain::INPUT_SIZE);
+    batch_outputs_.resize(batch * NeuralBrain::OUTPUT_SIZE);
+    for (size_t row = 0; row < batch; ++row) {
+        const size_t i = batch_members_[begin + row].second;
+        NeuralBrain::encode(sensory_[i], &batch_inputs_[row * NeuralBrain::INPUT_SIZE]);
+    }
+
+    network.forward(batch_inputs_.data(), batch, batch_outputs_.data(), batch_scratch_);
+
+    for (size_t row = 0; row < batch; ++row) {
+        const size_t i = batch_members_[begin + row].second;
+        const auto& brain = static_cast<const NeuralBrain&>(deciding_[i]->getBrain());
+        decisions_[i] = brain.decideFromOutput(
+            sensory_[i], &batch_outputs_[row * NeuralBrain::OUTPUT_SIZE]);
+    }
+}
+
+void TreeManager::buildSensorySums(const World& world)
+{
+    bool any = false;
+    Vector2i min{ 0, 0 };
+    Vector2i max{ 0, 0 };
+    for (const Tree* tree : deciding_) {
+        const auto bounds = tree->getBounds();
+        if (!bounds) continue;
+
+        // Trees that fit the sensory grid sample 1:1 and gain nothing from the tables.
+        if (bounds->max.x - bounds->min.x + 1 <= TreeSensoryData::GRID_SIZE
+            && bounds->max.y - bounds->min.y + 1 <= TreeSensoryData::GRID_SIZE) {
+            continue;
+        }
+
+        // Same 1-cell padding as the downsampled sensory window.
+        const Vector2i lo{ bounds->min.x - 1, bounds->min.y - 1 };
+        const Vector2i hi{ bounds->max.x + 1, bounds->max.y + 1 };
+        min = any ? Vector2i{ std::min(min.x, lo.x), std::min(min.y, lo.y) } : lo;
+        max = any ? Vector2i{ std::max(max.x, hi.x), std::max(max.y, hi.y) } : hi;
+        any = true;
+    }
+
+    if (any) {
+        sensory_sums_.build(world.getData(), min, max);
+    }
+    else {
+        sensory_sums_.clear();
+    }
+}
+
+TreeId TreeManager::plantSeed(
+    World& world, uint32_t x, uint32_t y, std::unique_ptr<TreeBrain> brain)
+{
+    syncIndexSize(world);
     TreeId id = next_tree_id_++;
 
-    auto brain = std::make_unique<RuleBasedBrain>();
+    if (!brain) {
+        brain = std::make_unique<RuleBasedBrain>();
+    }
     Tree tree(id, std::move(brain));
 
     Vector2i pos{ static_cast<int>(x), static_cast<int>(y) };
@@ -32,15 +151,12 @@ TreeId TreeManager::plantSeed(World& world, uint32_t x, uint32_t y)
     tree.total_energy = 500.0; // Boosted for testing growth patterns.
 
     world.addMaterialAtCell(x, y, MaterialType::SEED, 1.0);
-
-    tree.cells.insert(pos);
-    cell_to_tree_[pos] = id;
-
     world.getData().at(x, y).organism_id = id;
 
     LoggingChannels::tree()->info("TreeManager: Planted seed for tree {} at ({}, {})", id, x, y);
 
-    trees_.emplace(id, std::move(tree));
+    auto [it, inserted] = trees_.emplace(id, std::move(tree));
+    assignCell(it->second, pos);
 
     return id;
 }
@@ -55,7 +171,9 @@ void TreeManager::removeTree(TreeId id)
 
     // Remove cell ownership tracking.
     for (const auto& pos : it->second.cells) {
-        cell_to_tree_.erase(pos);
+        if (inIndex(pos)) {
+            cell_owner_[indexOf(pos)] = INVALID_TREE_ID;
+        }
     }
 
     // Remove tree.
@@ -78,57 +196,166 @@ const Tree* TreeManager::getTree(TreeId id) const
 
 TreeId TreeManager::getTreeAtCell(const Vector2i& pos) const
 {
-    auto it = cell_to_tree_.find(pos);
-    return it != cell_to_tree_.end() ? it->second : INVALID_TREE_ID;
+    return inIndex(pos) ? cell_owner_[indexOf(pos)] : INVALID_TREE_ID;
 }
 
-void TreeManager::notifyTransfers(const std::vector<OrganismTransfer>& transfers)
+bool TreeManager::inIndex(const Vector2i& pos) const
 {
-    // Batch transfers by tree ID for efficient processing.
-    std::unordered_map<TreeId, std::vector<const OrganismTransfer*>> transfers_by_tree;
+    return pos.x >= 0 && pos.y >= 0 && static_cast<uint32_t>(pos.x) < index_width_
+        && static_cast<uint32_t>(pos.y) < index_height_;
+}
 
-    for (const auto& transfer : transfers) {
-        transfers_by_tree[transfer.organism_id].push_back(&transfer);
+void TreeManager::syncIndexSize(const World& world)
+{
+    const WorldData& data = world.getData();
+    if (index_width_ == data.width && index_height_ == data.height) {
+        return;
     }
 
-    // Update each affected tree's cell tracking.
-    for (const auto& [tree_id, tree_transfers] : transfers_by_tree) {
-        auto tree_it = trees_.find(tree_id);
-        if (tree_it == trees_.end()) {
-            LoggingChannels::tree()->warn(
-                "TreeManager: Received transfers for non-existent tree {}", tree_id);
-            continue;
+    index_width_ = data.width;
+    index_height_ = data.height;
+    cell_owner_.assign(static_cast<size_t>(index_width_) * index_height_, INVALID_TREE_ID);
+    cell_slot_.assign(cell_owner_.size(), 0);
+
+    // Re-index every tree, dropping cells that are now outside the world.
+    for (auto& [id, tree] : trees_) {
+        std::vector<Vector2i> previous;
+        previous.swap(tree.cells);
+        for (const auto& pos : previous) {
+            assignCell(tree, pos);
         }
+        tree.boundsStale_ = true;
+    }
+}
+
+void TreeManager::assignCell(Tree& tree, const Vector2i& pos)
+{
+    if (!inIndex(pos)) {
+        return;
+    }
+
+    const size_t index = indexOf(pos);
+    if (cell_owner_[index] == tree.id) {
+        return;
+    }
+    if (cell_owner_[index] != INVALID_TREE_ID) {
+        releaseCell(pos);
+    }
+
+    cell_owner_[index] = tree.id;
+    cell_slot_[index] = static_cast<uint32_t>(tree.cells.size());
+    tree.cells.push_back(pos);
+    tree.onCellAdded(pos);
+}
+
+void TreeManager::releaseCell(const Vector2i& pos)
+{
+    if (!inIndex(pos)) {
+        return;
+    }
+
+    const size_t index = indexOf(pos);
+    const TreeId owner = cell_owner_[index];
+    if (owner == INVALID_TREE_ID) {
+        return;
+    }
+    cell_owner_[index] = INVALID_TREE_ID;
+
+    Tree* tree = getTree(owner);
+    if (!tree) {
+        return;
+    }
+
+    // Swap-remove, moving the last cell into the freed slot.
+    const uint32_t slot = cell_slot_[index];
+    const Vector2i last = tree->cells.back();
+    tree->cells[slot] = last;
+    cell_slot_[indexOf(last)] = slot;
+    tree->cells.pop_back();
+    tree->onCellRemoved(pos);
+}
 
-        Tree& tree = tree_it->second;
-
-        for (const OrganismTransfer* transfer : tree_transfers) {
-            // Add destination to tree's cell set.
-            tree.cells.insert(transfer->to_pos);
-            cell_to_tree_[transfer->to_pos] = tree_id;
-
-            // If the seed cell is moving, update seed_position to track it.
-            if (transfer->from_pos == tree.seed_position) {
-                tree.seed_position = transfer->to_pos;
-                LoggingChannels::tree()->debug(
-                    "TreeManager: Tree {} seed moved from ({}, {}) to ({}, {})",
-                    tree_id,
-                    transfer->from_pos.x,
-                    transfer->from_pos.y,
-                    transfer->to_pos.x,
-                    transfer->to_pos.y);
+void TreeManager::notifyTransfers(
+    const World& world, const std::vector<OrganismTransfer>& transfers)
+{
+    syncIndexSize(world);
+
+    const WorldData& data = world.getData();
+    auto ownerAt = [&data](const Vector2i& pos) -> TreeId {
+        if (pos.x < 0 || pos.y < 0 || static_cast<uint32_t>(pos.x) >= data.width
+            || static_cast<uint32_t>(pos.y) >= data.height) {
+            return INVALID_TREE_ID;
+        }
+        return data.at(pos.x, pos.y).organism_id;
+    };
+
+    // Consecutive transfers usually belong to the same tree, so keep the last lookup.
+    Tree* tree = nullptr;
+    for (const auto& transfer : transfers) {
+        if (!tree || tree->id != transfer.organism_id) {
+            tree = getTree(transfer.organism_id);
+            if (!tree) {
+                LoggingChannels::tree()->warn(
+                    "TreeManager: Received transfers for non-existent tree {}",
+                    transfer.organism_id);
+                continue;
             }
+        }
+
+        if (ownerAt(transfer.to_pos) == tree->id) {
+            assignCell(*tree, transfer.to_pos);
+        }
+
+        // Source emptied (or swapped away): it no longer belongs to this tree.
+        if (ownerAt(transfer.from_pos) != tree->id
+            && getTreeAtCell(transfer.from_pos) == tree->id) {
+            releaseCell(transfer.from_pos);
+        }
 
-            // Note: We don't remove from_pos yet - source cell might still have material.
-            // The cleanup will happen in a separate pass or when cell becomes fully empty.
+        // If the seed cell is moving, update seed_position to track it.
+        if (transfer.from_pos == tree->seed_position) {
+            tree->seed_position = transfer.to_pos;
+            LoggingChannels::tree()->debug(
+                "TreeManager: Tree {} seed moved from ({}, {}) to ({}, {})",
+                tree->id,
+                transfer.from_pos.x,
+                transfer.from_pos.y,
+                transfer.to_pos.x,
+                transfer.to_pos.y);
         }
+    }
+
+    LoggingChannels::tree()->trace("TreeManager: Processed {} transfers", transfers.size());
+}
+
+namespace {
 
-        LoggingChannels::tree()->trace(
-            "TreeManager: Processed {} transfers for tree {} (now {} cells tracked)",
-            tree_transfers.size(),
-            tree_id,
-            tree.cells.size());
+// libstdc++ unordered containers: one heap node per element (next pointer, value, cached
+// hash) plus the bucket array.
+template <typename Container>
+size_t unorderedBytes(const Container& container)
+{
+    const size_t nodeBytes =
+        sizeof(void*) + sizeof(typename Container::value_type) + sizeof(size_t);
+    return container.size() * nodeBytes + container.bucket_count() * sizeof(void*);
+}
+
+} // namespace
+
+size_t TreeManager::memoryBytes() const
+{
+    size_t bytes = unorderedBytes(trees_) + cell_owner_.capacity() * sizeof(TreeId)
+        + cell_slot_.capacity() * sizeof(uint32_t) + support_owned_.memoryBytes()
+        + support_connected_.memoryBytes()
+        + (support_grip_.capacity() + support_grip_rows_.capacity()) * sizeof(double)
+        + (support_roots_.capacity() + support_unsupported_.capacity()) * sizeof(Vector2i)
+        + sensory_sums_.memoryBytes() + sensory_.capacity() * sizeof(TreeSensoryData)
+        + (batch_inputs_.capacity() + batch_outputs_.capacity() + batch_scratch_.capacity())
+            * sizeof(float);
+    for (const auto& [id, tree] : trees_) {
+        bytes += tree.cells.capacity() * sizeof(Vector2i);
     }
+    return bytes;
 }
 
 void TreeManager::computeOrganismSupport(World& world)
@@ -136,191 +363,182 @@ void TreeManager::computeOrganismSupport(World& world)
     WorldData& data = world.getData();
     GridOfCells& grid = world.getGrid();
 
-    for (auto& [tree_id, tree] : trees_) {
-        // Step 1: Calculate root anchoring budget.
-        double support_budget = 0.0;
-        int root_count = 0;
+    // Fetch the channel once; per-tree details are only formatted when trace is enabled.
+    const auto logger = LoggingChannels::tree();
+    const bool trace = logger->should_log(spdlog::level::trace);
+
+    const int world_width = static_cast<int>(data.width);
+    const int world_height = static_cast<int>(data.height);
+    const auto in_world = [&](const Vector2i& pos) {
+        return pos.x >= 0 && pos.y >= 0 && pos.x < world_width && pos.y < world_height;
+    };
 
+    for (auto& [tree_id, tree] : trees_) {
+        const auto bounds = tree.getBounds();
+        if (!bounds) continue;
+
+        // Step 1: Rasterize owned cells into a tree-local bitmap and seed the connected set
+        // with the anchors (roots and the seed cell).
+        const Vector2i origin = bounds->min;
+        const uint32_t local_width = bounds->max.x - origin.x + 1;
+        const uint32_t local_height = bounds->max.y - origin.y + 1;
+        support_owned_.reset(local_width, local_height);
+        support_connected_.reset(local_width, local_height);
+        support_roots_.clear();
+
+        Vector2i root_min{ world_width, world_height };
+        Vector2i root_max{ -1, -1 };
         for (const auto& pos : tree.cells) {
-            if (static_cast<uint32_t>(pos.x) >= data.width
-                || static_cast<uint32_t>(pos.y) >= data.height)
-                continue;
+            if (!in_world(pos)) continue;
 
             const Cell& cell = data.at(pos.x, pos.y);
-            if (cell.organism_id != tree_id || cell.material_type != MaterialType::ROOT) {
-                continue;
+            if (cell.organism_id != tree_id) continue;
+
+            const uint32_t local_x = pos.x - origin.x;
+            const uint32_t local_y = pos.y - origin.y;
+            support_owned_.set(local_x, local_y);
+
+            if (cell.material_type == MaterialType::ROOT) {
+                support_connected_.set(local_x, local_y);
+                support_roots_.push_back(pos);
+                root_min.x = std::min(root_min.x, pos.x);
+                root_min.y = std::min(root_min.y, pos.y);
+                root_max.x = std::max(root_max.x, pos.x);
+                root_max.y = std::max(root_max.y, pos.y);
+            }
+            else if (pos == tree.seed_position) {
+                support_connected_.set(local_x, local_y);
             }
+        }
+
+        // Step 2: Flood fill from the anchors through owned cells, a block at a time.
+        while (support_connected_.dilateWithin(support_owned_)) {}
 
-            root_count++;
-            double root_anchoring = 0.0;
-            int dirt_neighbors = 0;
-
-            // Check all 8 neighbors for non-tree material to grip.
-            for (int dy = -1; dy <= 1; dy++) {
-                for (int dx = -1; dx <= 1; dx++) {
-                    if (dx == 0 && dy == 0) continue;
-
-                    int nx = pos.x + dx;
-                    int ny = pos.y + dy;
-
-                    if (nx < 0 || ny < 0 || nx >= static_cast<int>(data.width)
-                        || ny >= static_cast<int>(data.height)) {
-                        continue;
-                    }
-
-                    const Cell& neighbor = data.at(nx, ny);
-
-                    // Only count non-tree cells (dirt, sand, etc. that roots grip).
-                    if (neighbor.organism_id != tree_id && !neighbor.isEmpty()) {
-                        const MaterialProperties& neighbor_props =
-                            getMaterialProperties(neighbor.material_type);
-                        double neighbor_mass = neighbor.fill_ratio * neighbor_props.density;
-
-                        // Use neighbor's adhesion (how well material sticks to roots).
-                        double contribution = neighbor_mass * neighbor_props.adhesion;
-                        root_anchoring += contribution;
-
-                        if (neighbor.material_type == MaterialType::DIRT) {
-                            dirt_neighbors++;
-                        }
-
-                        LoggingChannels::tree()->info(
-                            "  ROOT({},{}) neighbor({},{}) {} mass={:.2f} adhesion={:.2f} "
-                            "contrib={:.2f}",
-                            pos.x,
-                            pos.y,
-                            nx,
-                            ny,
-                            getMaterialName(neighbor.material_type),
-                            neighbor_mass,
-                            neighbor_props.adhesion,
-                            contribution);
-                    }
+        // Step 3: Root anchoring budget. Each root grips the non-tree material in its 3x3
+        // neighbourhood (mass * adhesion). Grip is laid out over the roots' bounding box plus
+        // a zero border, so the neighbour sums are separable row/column passes without edge
+        // checks. The root itself is tree material and contributes nothing.
+        double support_budget = 0.0;
+        if (!support_roots_.empty()) {
+            const Vector2i grip_origin{ root_min.x - 1, root_min.y - 1 };
+            const int grip_width = root_max.x - root_min.x + 3;
+            const int grip_height = root_max.y - root_min.y + 3;
+            support_grip_.assign(grip_width * grip_height, 0.0);
+            support_grip_rows_.assign(grip_width * grip_height, 0.0);
+
+            for (int y = 0; y < grip_height; ++y) {
+                for (int x = 0; x < grip_width; ++x) {
+                    const Vector2i pos{ grip_origin.x + x, grip_origin.y + y };
+                    if (!in_world(pos)) continue;
+
+                    const Cell& cell = data.at(pos.x, pos.y);
+                    if (cell.organism_id == tree_id || cell.isEmpty()) continue;
+
+                    const MaterialProperties& props = getMaterialProperties(cell.material_type);
+                    support_grip_[y * grip_width + x] =
+                        cell.fill_ratio * props.density * props.adhesion;
                 }
             }
 
-            LoggingChannels::tree()->info(
-                "ROOT at ({},{}) has {} dirt neighbors, anchoring={:.2f}",
-                pos.x,
-                pos.y,
-                dirt_neighbors,
-                root_anchoring);
+            for (int y = 0; y < grip_height; ++y) {
+                const double* grip = &support_grip_[y * grip_width];
+                double* rows = &support_grip_rows_[y * grip_width];
+                for (int x = 1; x < grip_width - 1; ++x) {
+                    rows[x] = grip[x - 1] + grip[x] + grip[x + 1];
+                }
+            }
 
-            support_budget += root_anchoring;
+            for (const auto& pos : support_roots_) {
+                const int x = pos.x - grip_origin.x;
+                const int y = pos.y - grip_origin.y;
+                support_budget += support_grip_rows_[(y - 1) * grip_width + x]
+                    + support_grip_rows_[y * grip_width + x]
+                    + support_grip_rows_[(y + 1) * grip_width + x];
+            }
         }
 
         // Divide by 2 as specified.
         support_budget /= 2.0;
 
-        LoggingChannels::tree()->info(
-            "Tree {} support calculation: {} roots, total_budget={:.2f}",
-            tree_id,
-            root_count,
-            support_budget);
-
-        // Step 2: Calculate upper structure mass (everything except ROOTs).
-        std::vector<Vector2i> upper_cells;
+        // Step 4: Upper structure mass (connected cells other than ROOTs). Disconnected
+        // cells get no organism support and fall under normal physics.
+        support_unsupported_.clear();
         double upper_mass = 0.0;
+        int disconnected = 0;
 
         for (const auto& pos : tree.cells) {
-            if (static_cast<uint32_t>(pos.x) >= data.width
-                || static_cast<uint32_t>(pos.y) >= data.height)
-                continue;
+            if (!in_world(pos)) continue;
 
-            const Cell& cell = data.at(pos.x, pos.y);
+            Cell& cell = data.at(pos.x, pos.y);
             if (cell.organism_id != tree_id) continue;
 
+            if (!support_connected_.isSet(pos.x - origin.x, pos.y - origin.y)) {
+                disconnected++;
+                continue;
+            }
+
             // Skip ROOT cells - they provide support, don't consume it.
             if (cell.material_type == MaterialType::ROOT) continue;
 
-            upper_cells.push_back(pos);
             const MaterialProperties& props = getMaterialProperties(cell.material_type);
-            double cell_mass = cell.fill_ratio * props.density;
-            upper_mass += cell_mass;
+            upper_mass += cell.fill_ratio * props.density;
+            if (!cell.has_any_support) {
+                support_unsupported_.push_back(pos);
+            }
         }
 
-        // Step 3: Distribute support.
+        // Step 5: Distribute support.
         // NOTE: Organism support only GRANTS additional support to cells that lack it.
         // We never remove support that cells already have from main physics (ground, cohesion).
+        const auto grant = [&](const Vector2i& pos, Cell& cell) {
+            // Grant organism support (update both cell flag and bitmap).
+            cell.has_any_support = true;
+            if (GridOfCells::USE_CACHE) {
+                grid.supportBitmap().set(pos.x, pos.y);
+            }
+        };
 
+        double mass_supported = 0.0;
         if (support_budget >= upper_mass) {
-            // Roots can support entire tree - grant organism support to all unsupported cells.
+            // Roots can support the whole connected tree, roots included.
             for (const auto& pos : tree.cells) {
-                if (static_cast<uint32_t>(pos.x) >= data.width
-                    || static_cast<uint32_t>(pos.y) >= data.height)
+                if (!in_world(pos)
+                    || !support_connected_.isSet(pos.x - origin.x, pos.y - origin.y)) {
                     continue;
+                }
                 Cell& cell = data.at(pos.x, pos.y);
                 if (cell.organism_id == tree_id && !cell.has_any_support) {
-                    // Grant organism support (update both cell flag and bitmap).
-                    cell.has_any_support = true;
-                    if (GridOfCells::USE_CACHE) {
-                        grid.supportBitmap().set(pos.x, pos.y);
-                    }
+                    grant(pos, cell);
                 }
             }
-
-            LoggingChannels::tree()->debug(
-                "TreeManager: Tree {} fully supported (budget={:.2f} >= mass={:.2f}, roots={})",
-                tree_id,
-                support_budget,
-                upper_mass,
-                root_count);
+            mass_supported = upper_mass;
         }
         else {
-            // Insufficient support - only grant organism support up to budget.
-            double mass_to_support = support_budget; // How much we CAN support.
-
-            LoggingChannels::tree()->warn(
-                "TreeManager: Tree {} INSUFFICIENT support (budget={:.2f} < mass={:.2f})",
-                tree_id,
-                support_budget,
-                upper_mass);
-
-            // Grant organism support to random unsupported cells up to our budget.
-            double mass_supported = 0.0;
-
-            // Only consider cells that DON'T already have support.
-            std::vector<Vector2i> unsupported_cells;
-            for (const auto& pos : upper_cells) {
-                Cell& cell = data.at(pos.x, pos.y);
-                if (!cell.has_any_support) {
-                    unsupported_cells.push_back(pos);
-                }
-            }
-
-            // Shuffle for random selection.
+            // Insufficient support - grant random unsupported cells up to the budget.
             std::random_device rd;
             std::mt19937 rng(rd());
-            std::shuffle(unsupported_cells.begin(), unsupported_cells.end(), rng);
+            std::shuffle(support_unsupported_.begin(), support_unsupported_.end(), rng);
 
-            for (const auto& pos : unsupported_cells) {
-                if (mass_supported >= mass_to_support) break;
+            for (const auto& pos : support_unsupported_) {
+                if (mass_supported >= support_budget) break;
 
                 Cell& cell = data.at(pos.x, pos.y);
                 const MaterialProperties& props = getMaterialProperties(cell.material_type);
-                double cell_mass = cell.fill_ratio * props.density;
-
-                // Grant organism support to this cell (update both cell flag and bitmap).
-                cell.has_any_support = true;
-                if (GridOfCells::USE_CACHE) {
-                    grid.supportBitmap().set(pos.x, pos.y);
-                }
-                mass_supported += cell_mass;
-
-                LoggingChannels::tree()->debug(
-                    "TreeManager: Tree {} granting support to {} at ({}, {}) - mass={:.2f}",
-                    tree_id,
-                    getMaterialName(cell.material_type),
-                    pos.x,
-                    pos.y,
-                    cell_mass);
+                grant(pos, cell);
+                mass_supported += cell.fill_ratio * props.density;
             }
+        }
 
-            LoggingChannels::tree()->info(
-                "TreeManager: Tree {} partial support - {:.2f}/{:.2f} mass supported by roots",
+        if (trace) {
+            logger->trace(
+                "TreeManager: Tree {} support: {} roots, budget={:.2f}, mass={:.2f}, "
+                "supported={:.2f}, disconnected={}",
                 tree_id,
+                support_roots_.size(),
+                support_budget,
+                upper_mass,
                 mass_supported,
-                upper_mass);
+                disconnected);
         }
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Tree.h"
+#include "core/bitmaps/CellBitmap.h"
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -14,39 +15,106 @@ struct OrganismTransfer {
     double amount;
 };
 
+class NeuralNetwork;
 class World;
 
 class TreeManager {
 public:
     TreeManager() = default;
 
+    /**
+     * Two-phase organism step. Finished commands are executed serially in tree ID order,
+     * then every idle tree gathers sensory data and runs its brain in parallel against the
+     * settled world, and the decisions are queued serially (again in ID order). Neural
+     * brains sharing a network are evaluated together as one batched forward pass.
+     */
     void update(World& world, double deltaTime);
-    TreeId plantSeed(World& world, uint32_t x, uint32_t y);
+
+    // Fewer idle trees than this decide on the calling thread.
+    static constexpr size_t PARALLEL_DECIDE_MIN_TREES = 8;
+
+    // Plant a seed driven by brain (a RuleBasedBrain when null).
+    TreeId plantSeed(
+        World& world, uint32_t x, uint32_t y, std::unique_ptr<TreeBrain> brain = nullptr);
     void removeTree(TreeId id);
 
     Tree* getTree(TreeId id);
     const Tree* getTree(TreeId id) const;
     TreeId getTreeAtCell(const Vector2i& pos) const;
 
+    /**
+     * Give a cell to a tree, taking it from its previous owner. Positions outside the world
+     * the index was last sized for are ignored.
+     */
+    void assignCell(Tree& tree, const Vector2i& pos);
+
+    // Drop a cell from whichever tree owns it.
+    void releaseCell(const Vector2i& pos);
+
     const std::unordered_map<TreeId, Tree>& getTrees() const { return trees_; }
 
-    void notifyTransfers(const std::vector<OrganismTransfer>& transfers);
+    /**
+     * Follow organism material moved by physics. Ownership is read back from the world after
+     * the moves, so a partially emptied source cell stays with its tree and a fully emptied
+     * one is dropped (keeping Tree::cells and its bounds exact without world scans).
+     */
+    void notifyTransfers(const World& world, const std::vector<OrganismTransfer>& transfers);
 
     /**
      * Compute realistic organism support for all trees.
      *
-     * Trees are supported if connected to anchor points (ground, seed).
-     * Uses flood-fill to mark reachable cells as supported.
-     * Disconnected branches will lose support and fall.
+     * Roots grip the non-tree material around them; half of that grip is the budget for the
+     * rest of the tree. Only cells connected to an anchor (root or seed) can be granted
+     * support: connectivity is a flood fill over per-tree CellBitmap blocks, so
+     * disconnected branches lose support and fall.
      *
      * Should be called after main support calculation.
      */
     void computeOrganismSupport(World& world);
 
+    // Approximate heap bytes held by the tree map, ownership index and cell lists.
+    size_t memoryBytes() const;
+
 private:
     std::unordered_map<TreeId, Tree> trees_;
-    std::unordered_map<Vector2i, TreeId> cell_to_tree_;
     uint32_t next_tree_id_ = 1;
+
+    // Dense ownership index over the world: owning tree per cell, and the cell's slot in
+    // that tree's cells list (for O(1) swap-removal). Resized, and rebuilt from the cell
+    // lists, whenever the world dimensions change.
+    uint32_t index_width_ = 0;
+    uint32_t index_height_ = 0;
+    std::vector<TreeId> cell_owner_;
+    std::vector<uint32_t> cell_slot_;
+
+    void syncIndexSize(const World& world);
+    bool inIndex(const Vector2i& pos) const;
+    size_t indexOf(const Vector2i& pos) const { return pos.y * index_width_ + pos.x; }
+
+    // Per-step scratch, kept to reuse capacity.
+    std::vector<Tree*> update_order_;
+    std::vector<Tree*> deciding_;
+    std::vector<TreeCommand> decisions_;
+    std::vector<TreeSensoryData> sensory_;
+
+    // Neural batch scratch: deciding_ indices grouped by network, packed inputs/outputs.
+    std::vector<std::pair<const NeuralNetwork*, size_t>> batch_members_;
+    std::vector<float> batch_inputs_;
+    std::vector<float> batch_outputs_;
+    std::vector<float> batch_scratch_;
+    void decideBatched(size_t begin, size_t end);
+
+    // Material sums shared by trees whose sensing is downsampled (rebuilt each update).
+    MaterialSumTable sensory_sums_;
+    void buildSensorySums(const World& world);
+
+    // Organism support scratch (tree-local bitmaps, root grip plane).
+    CellBitmap support_owned_{ 0, 0 };
+    CellBitmap support_connected_{ 0, 0 };
+    std::vector<double> support_grip_;
+    std::vector<double> support_grip_rows_;
+    std::vector<Vector2i> support_roots_;
+    std::vector<Vector2i> support_unsupported_;
 };
 
 } // namespace DirtSim
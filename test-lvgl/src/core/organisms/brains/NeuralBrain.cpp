@@ -0,0 +1,113 @@
+#include "NeuralBrain.h"
+#include "core/LoggingChannels.h"
+
+namespace DirtSim {
+
+NeuralBrain::NeuralBrain(std::shared_ptr<const NeuralNetwork> network)
+    : network_(std::move(network))
+{}
+
+Result<std::unique_ptr<NeuralBrain>, std::string> NeuralBrain::create(
+    std::shared_ptr<const NeuralNetwork> network)
+{
+    using ResultType = Result<std::unique_ptr<NeuralBrain>, std::string>;
+
+    std::string error;
+    if (!network) {
+        error = "No network";
+    }
+    else if (!isCompatible(*network)) {
+        error = "Network maps " + std::to_string(network->inputSize()) + " inputs to "
+            + std::to_string(network->outputSize()) + " outputs, expected "
+            + std::to_string(INPUT_SIZE) + " to " + std::to_string(OUTPUT_SIZE);
+    }
+    if (!error.empty()) {
+        LoggingChannels::tree()->error("NeuralBrain: {}", error);
+        return ResultType::error(std::move(error));
+    }
+
+    return ResultType::okay(std::unique_ptr<NeuralBrain>(new NeuralBrain(std::move(network))));
+}
+
+bool NeuralBrain::isCompatible(const NeuralNetwork& network)
+{
+    return network.inputSize() == INPUT_SIZE && network.outputSize() == OUTPUT_SIZE;
+}
+
+TreeCommand NeuralBrain::decide(const TreeSensoryData& sensory)
+{
+    input_.resize(INPUT_SIZE);
+    output_.resize(OUTPUT_SIZE);
+    encode(sensory, input_.data());
+    network_->forward(input_.data(), 1, output_.data(), scratch_);
+    return decideFromOutput(sensory, output_.data());
+}
+
+void NeuralBrain::encode(const TreeSensoryData& sensory, float* input)
+{
+    for (int y = 0; y < TreeSensoryData::GRID_SIZE; ++y) {
+        for (int x = 0; x < TreeSensoryData::GRID_SIZE; ++x) {
+            const auto& histogram = sensory.material_histograms[y][x];
+            for (int m = 0; m < TreeSensoryData::NUM_MATERIALS; ++m) {
+                *input++ = static_cast<float>(histogram[m]);
+            }
+        }
+    }
+
+    // Rough unit scaling so scalars sit in the same range as histogram entries.
+    *input++ = static_cast<float>(sensory.total_energy / 1000.0);
+    *input++ = static_cast<float>(sensory.total_water / 100.0);
+    *input++ = static_cast<float>(sensory.age_seconds / 60.0);
+    *input++ = static_cast<float>(sensory.stage) / 4.0f;
+}
+
+TreeCommand NeuralBrain::decideFromOutput(
+    const TreeSensoryData& sensory, const float* output) const
+{
+    const float* wait_score = output + GRID_CELLS * GROW_CHANNELS;
+    float best = *wait_score;
+    int best_index = -1;
+
+    for (int cell = 0; cell < GRID_CELLS; ++cell) {
+        // Buckets outside the world have empty histograms; nothing can grow there.
+        const auto& histogram =
+            sensory.material_histograms[cell / TreeSensoryData::GRID_SIZE]
+                                       [cell % TreeSensoryData::GRID_SIZE];
+        double occupancy = 0.0;
+        for (const double share : histogram) {
+            occupancy += share;
+        }
+        if (occupancy <= 0.0) continue;
+
+        for (int channel = 0; channel < GROW_CHANNELS; ++channel) {
+            const float score = output[cell * GROW_CHANNELS + channel];
+            if (score > best) {
+                best = score;
+                best_index = cell * GROW_CHANNELS + channel;
+            }
+        }
+    }
+
+    if (best_index < 0) {
+        return WaitCommand{};
+    }
+
+    const int cell = best_index / GROW_CHANNELS;
+    const int nx = cell % TreeSensoryData::GRID_SIZE;
+    const int ny = cell / TreeSensoryData::GRID_SIZE;
+    const Vector2i target{
+        sensory.world_offset.x + static_cast<int>((nx + 0.5) * sensory.scale_factor),
+        sensory.world_offset.y + static_cast<int>((ny + 0.5) * sensory.scale_factor),
+    };
+
+    switch (best_index % GROW_CHANNELS) {
+        case 0:
+            return GrowWoodCommand{ .target_pos = target };
+        case 1:
+            return GrowLeafCommand{ .target_pos = target };
+        default:
+            return GrowRootCommand{ .target_pos = target };
+    }
+}
+
+} // namespace DirtSim
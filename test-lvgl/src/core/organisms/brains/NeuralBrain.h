@@ -0,0 +1,60 @@
+#pragma once
+
+#include "NeuralNetwork.h"
+#include "core/Result.h"
+#include "core/organisms/TreeBrain.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DirtSim {
+
+/**
+ * Tree brain driven by a NeuralNetwork over the sensory grid.
+ *
+ * Input: the GRID_SIZE² × NUM_MATERIALS material histograms followed by energy, water, age
+ * and growth stage. Output: one score per grid cell for each of WOOD, LEAF and ROOT, then
+ * WAIT. The best score wins; grow targets map to the centre of their sensory bucket.
+ *
+ * TreeManager evaluates all trees that share a network as one batch (encode, a single
+ * forward pass, decideFromOutput); decide() runs a batch of one for standalone use.
+ */
+class NeuralBrain : public TreeBrain {
+public:
+    static constexpr int GRID_CELLS = TreeSensoryData::GRID_SIZE * TreeSensoryData::GRID_SIZE;
+    static constexpr int SCALAR_INPUTS = 4;
+    static constexpr int INPUT_SIZE = GRID_CELLS * TreeSensoryData::NUM_MATERIALS
+        + SCALAR_INPUTS;
+    static constexpr int GROW_CHANNELS = 3; // WOOD, LEAF, ROOT.
+    static constexpr int OUTPUT_SIZE = GRID_CELLS * GROW_CHANNELS + 1;
+
+    /**
+     * Brain driven by network, or an error (also logged) when the network is missing or its
+     * shape does not match the sensory encoding. Callers can fall back to RuleBasedBrain.
+     */
+    static Result<std::unique_ptr<NeuralBrain>, std::string> create(
+        std::shared_ptr<const NeuralNetwork> network);
+
+    TreeCommand decide(const TreeSensoryData& sensory) override;
+
+    const std::shared_ptr<const NeuralNetwork>& getNetwork() const { return network_; }
+
+    // Write INPUT_SIZE floats describing sensory.
+    static void encode(const TreeSensoryData& sensory, float* input);
+
+    // Pick a command from OUTPUT_SIZE network outputs.
+    TreeCommand decideFromOutput(const TreeSensoryData& sensory, const float* output) const;
+
+    // True when a network's shape matches the sensory encoding.
+    static bool isCompatible(const NeuralNetwork& network);
+
+private:
+    explicit NeuralBrain(std::shared_ptr<const NeuralNetwork> network);
+
+    std::shared_ptr<const NeuralNetwork> network_;
+    std::vector<float> input_;
+    std::vector<float> output_;
+    std::vector<float> scratch_;
+};
+
+} // namespace DirtSim
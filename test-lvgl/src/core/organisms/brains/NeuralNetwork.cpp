@@ -0,0 +1,284 @@
+#include "NeuralNetwork.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+namespace DirtSim {
+
+namespace {
+
+constexpr char MAGIC[4] = { 'S', 'D', 'N', 'N' };
+constexpr uint32_t VERSION = 1;
+
+// Upper bound on any layer width, to reject corrupt headers before allocating.
+constexpr uint32_t MAX_WIDTH = 1u << 16;
+
+// Batch rows sharing each streamed weight row.
+constexpr size_t PANEL = 4;
+
+/**
+ * out = in × W + bias for a batch, PANEL rows at a time: each weight row is loaded once per
+ * panel and applied to every row's outputs in one contiguous, vectorized pass. Zero inputs
+ * (most histogram entries) skip their weight row entirely.
+ */
+void denseLayer(const NeuralNetwork::Layer& layer, const float* in, size_t batch, float* out)
+{
+    const size_t n_in = layer.inputs;
+    const size_t n_out = layer.outputs;
+    const float* bias = layer.biases.data();
+
+    for (size_t b = 0; b < batch; b += PANEL) {
+        const size_t rows = std::min(PANEL, batch - b);
+        for (size_t r = 0; r < rows; ++r) {
+            std::copy(bias, bias + n_out, out + (b + r) * n_out);
+        }
+
+        float* c0 = out + b * n_out;
+        float* c1 = c0 + n_out;
+        float* c2 = c1 + n_out;
+        float* c3 = c2 + n_out;
+        for (size_t i = 0; i < n_in; ++i) {
+            const float* w = layer.weights.data() + i * n_out;
+            float a[PANEL] = {};
+            bool any = false;
+            for (size_t r = 0; r < rows; ++r) {
+                a[r] = in[(b + r) * n_in + i];
+                any |= a[r] != 0.0f;
+            }
+            if (!any) continue;
+
+            if (rows == PANEL) {
+                const float a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                for (size_t o = 0; o < n_out; ++o) {
+                    const float w_o = w[o];
+                    c0[o] += a0 * w_o;
+                    c1[o] += a1 * w_o;
+                    c2[o] += a2 * w_o;
+                    c3[o] += a3 * w_o;
+                }
+            }
+            else {
+                for (size_t r = 0; r < rows; ++r) {
+                    float* c = c0 + r * n_out;
+                    const float a_r = a[r];
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+                    for (size_t o = 0; o < n_out; ++o) {
+                        c[o] += a_r * w[o];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void relu(float* values, size_t count)
+{
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = std::max(values[i], 0.0f);
+    }
+}
+
+// Files are little-endian. Swapping is its own inverse, so this converts either way on
+// big-endian hosts and compiles away on little-endian ones.
+template <typename T>
+void swapFileOrder(T* values, size_t count)
+{
+    static_assert(sizeof(T) == 1 || sizeof(T) == sizeof(uint32_t));
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) == sizeof(uint32_t)) {
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = std::bit_cast<T>(std::byteswap(std::bit_cast<uint32_t>(values[i])));
+        }
+    }
+}
+
+template <typename T>
+bool readValues(std::ifstream& in, T* values, size_t count)
+{
+    in.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+    swapFileOrder(values, count);
+    return static_cast<bool>(in);
+}
+
+template <typename T>
+void writeValues(std::ofstream& out, const T* values, size_t count)
+{
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+        std::vector<T> swapped(values, values + count);
+        swapFileOrder(swapped.data(), count);
+        out.write(
+            reinterpret_cast<const char*>(swapped.data()),
+            static_cast<std::streamsize>(count * sizeof(T)));
+    }
+    else {
+        out.write(
+            reinterpret_cast<const char*>(values),
+            static_cast<std::streamsize>(count * sizeof(T)));
+    }
+}
+
+} // namespace
+
+NeuralNetwork::NeuralNetwork(std::vector<Layer> layers) : layers_(std::move(layers))
+{
+    for (size_t i = 0; i + 1 < layers_.size(); ++i) {
+        widest_hidden_ = std::max<size_t>(widest_hidden_, layers_[i].outputs);
+    }
+}
+
+Result<std::shared_ptr<const NeuralNetwork>, std::string> NeuralNetwork::fromLayers(
+    std::vector<Layer> layers)
+{
+    using ResultType = Result<std::shared_ptr<const NeuralNetwork>, std::string>;
+
+    if (layers.empty()) {
+        return ResultType::error("Network has no layers");
+    }
+    for (size_t i = 0; i < layers.size(); ++i) {
+        const Layer& layer = layers[i];
+        if (layer.inputs == 0 || layer.outputs == 0) {
+            return ResultType::error("Layer " + std::to_string(i) + " has zero width");
+        }
+        if (i > 0 && layer.inputs != layers[i - 1].outputs) {
+            return ResultType::error(
+                "Layer " + std::to_string(i) + " expects " + std::to_string(layer.inputs)
+                + " inputs but the previous layer has " + std::to_string(layers[i - 1].outputs)
+                + " outputs");
+        }
+        if (layer.weights.size() != static_cast<size_t>(layer.inputs) * layer.outputs
+            || layer.biases.size() != layer.outputs) {
+            return ResultType::error(
+                "Layer " + std::to_string(i) + " weight or bias count does not match its shape");
+        }
+    }
+
+    return ResultType::okay(
+        std::shared_ptr<const NeuralNetwork>(new NeuralNetwork(std::move(layers))));
+}
+
+Result<std::shared_ptr<const NeuralNetwork>, std::string> NeuralNetwork::loadFromFile(
+    const std::string& path)
+{
+    using ResultType = Result<std::shared_ptr<const NeuralNetwork>, std::string>;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return ResultType::error("Cannot open weights file: " + path);
+    }
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint32_t layer_count = 0;
+    if (!readValues(in, magic, 4) || std::memcmp(magic, MAGIC, 4) != 0) {
+        return ResultType::error("Not a weights file: " + path);
+    }
+    if (!readValues(in, &version, 1) || version != VERSION) {
+        return ResultType::error("Unsupported weights file version: " + std::to_string(version));
+    }
+    if (!readValues(in, &layer_count, 1) || layer_count == 0 || layer_count > 64) {
+        return ResultType::error("Invalid layer count in " + path);
+    }
+
+    std::vector<uint32_t> widths(layer_count + 1);
+    if (!readValues(in, widths.data(), widths.size())) {
+        return ResultType::error("Truncated weights file: " + path);
+    }
+    for (const uint32_t width : widths) {
+        if (width == 0 || width > MAX_WIDTH) {
+            return ResultType::error("Invalid layer width in " + path);
+        }
+    }
+
+    // The header alone could ask for gigabytes; check it against the file size before
+    // allocating anything it describes.
+    uint64_t payload_bytes = 0;
+    for (uint32_t i = 0; i < layer_count; ++i) {
+        const uint64_t floats = static_cast<uint64_t>(widths[i]) * widths[i + 1] + widths[i + 1];
+        payload_bytes += floats * sizeof(float);
+    }
+    const std::streampos payload_start = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::streampos file_end = in.tellg();
+    in.seekg(payload_start);
+    if (!in || static_cast<uint64_t>(file_end - payload_start) != payload_bytes) {
+        return ResultType::error("Weights file size does not match its header: " + path);
+    }
+
+    std::vector<Layer> layers(layer_count);
+    for (uint32_t i = 0; i < layer_count; ++i) {
+        Layer& layer = layers[i];
+        layer.inputs = widths[i];
+        layer.outputs = widths[i + 1];
+        layer.weights.resize(static_cast<size_t>(layer.inputs) * layer.outputs);
+        layer.biases.resize(layer.outputs);
+        if (!readValues(in, layer.weights.data(), layer.weights.size())
+            || !readValues(in, layer.biases.data(), layer.biases.size())) {
+            return ResultType::error("Truncated weights file: " + path);
+        }
+    }
+
+    return fromLayers(std::move(layers));
+}
+
+Result<std::monostate, std::string> NeuralNetwork::saveToFile(const std::string& path) const
+{
+    using ResultType = Result<std::monostate, std::string>;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return ResultType::error("Cannot write weights file: " + path);
+    }
+
+    const uint32_t layer_count = static_cast<uint32_t>(layers_.size());
+    writeValues(out, MAGIC, 4);
+    writeValues(out, &VERSION, 1);
+    writeValues(out, &layer_count, 1);
+    writeValues(out, &layers_.front().inputs, 1);
+    for (const Layer& layer : layers_) {
+        writeValues(out, &layer.outputs, 1);
+    }
+    for (const Layer& layer : layers_) {
+        writeValues(out, layer.weights.data(), layer.weights.size());
+        writeValues(out, layer.biases.data(), layer.biases.size());
+    }
+
+    if (!out) {
+        return ResultType::error("Failed writing weights file: " + path);
+    }
+    return ResultType::okay(std::monostate{});
+}
+
+void NeuralNetwork::forward(
+    const float* inputs, size_t batch, float* outputs, std::vector<float>& scratch) const
+{
+    if (batch == 0) return;
+
+    // Hidden activations ping-pong between the two halves of scratch.
+    const size_t half = batch * widest_hidden_;
+    if (scratch.size() < 2 * half) {
+        scratch.resize(2 * half);
+    }
+
+    const float* in = inputs;
+    for (size_t i = 0; i < layers_.size(); ++i) {
+        const Layer& layer = layers_[i];
+        const bool last = i + 1 == layers_.size();
+        float* out = last ? outputs : scratch.data() + (i % 2) * half;
+
+        denseLayer(layer, in, batch, out);
+        if (!last) {
+            relu(out, batch * layer.outputs);
+        }
+        in = out;
+    }
+}
+
+} // namespace DirtSim
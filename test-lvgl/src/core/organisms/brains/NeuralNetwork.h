@@ -0,0 +1,59 @@
+#pragma once
+
+#include "core/Result.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace DirtSim {
+
+/**
+ * Small fully connected network (MLP) for tree brains, evaluated a batch at a time.
+ *
+ * Hidden layers use ReLU; the last layer is linear. Weights are stored inputs × outputs
+ * (row-major) so each input's weight row streams contiguously across the outputs.
+ *
+ * Weights file (little-endian, swapped on big-endian hosts): "SDNN", uint32 version (1),
+ * uint32 layer count L, L + 1 uint32 layer widths, then per layer the float32 weight matrix
+ * followed by float32 biases. The payload size must match the widths exactly.
+ */
+class NeuralNetwork {
+public:
+    struct Layer {
+        uint32_t inputs = 0;
+        uint32_t outputs = 0;
+        std::vector<float> weights; // inputs × outputs.
+        std::vector<float> biases;  // outputs.
+    };
+
+    // Validate layer shapes (each layer's inputs must match the previous layer's outputs).
+    static Result<std::shared_ptr<const NeuralNetwork>, std::string> fromLayers(
+        std::vector<Layer> layers);
+
+    static Result<std::shared_ptr<const NeuralNetwork>, std::string> loadFromFile(
+        const std::string& path);
+    Result<std::monostate, std::string> saveToFile(const std::string& path) const;
+
+    uint32_t inputSize() const { return layers_.front().inputs; }
+    uint32_t outputSize() const { return layers_.back().outputs; }
+    const std::vector<Layer>& getLayers() const { return layers_; }
+
+    /**
+     * Evaluate batch rows of inputSize() floats into batch rows of outputSize() floats.
+     * scratch holds the hidden activations and is reused across calls; the network itself
+     * is immutable, so threads may evaluate concurrently with their own scratch.
+     */
+    void forward(
+        const float* inputs, size_t batch, float* outputs, std::vector<float>& scratch) const;
+
+private:
+    explicit NeuralNetwork(std::vector<Layer> layers);
+
+    std::vector<Layer> layers_;
+    size_t widest_hidden_ = 0;
+};
+
+} // namespace DirtSim
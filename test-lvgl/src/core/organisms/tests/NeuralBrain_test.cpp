@@ -0,0 +1,213 @@
+#include "core/Cell.h"
+#include "core/MaterialType.h"
+#include "core/World.h"
+#include "core/WorldData.h"
+#include "core/organisms/TreeManager.h"
+#include "core/organisms/brains/NeuralBrain.h"
+#include "core/organisms/brains/NeuralNetwork.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace DirtSim;
+
+namespace {
+
+std::vector<NeuralNetwork::Layer> randomLayers(
+    const std::vector<uint32_t>& widths, uint32_t seed, double zero_fraction = 0.0)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<NeuralNetwork::Layer> layers;
+    for (size_t i = 0; i + 1 < widths.size(); ++i) {
+        NeuralNetwork::Layer layer;
+        layer.inputs = widths[i];
+        layer.outputs = widths[i + 1];
+        for (size_t w = 0; w < static_cast<size_t>(layer.inputs) * layer.outputs; ++w) {
+            layer.weights.push_back(unit(rng) < zero_fraction ? 0.0f : value(rng));
+        }
+        for (uint32_t b = 0; b < layer.outputs; ++b) {
+            layer.biases.push_back(value(rng));
+        }
+        layers.push_back(std::move(layer));
+    }
+    return layers;
+}
+
+// Straightforward per-row evaluation in double precision.
+std::vector<double> referenceForward(
+    const std::vector<NeuralNetwork::Layer>& layers, const float* input)
+{
+    std::vector<double> activations(input, input + layers.front().inputs);
+    for (size_t l = 0; l < layers.size(); ++l) {
+        const auto& layer = layers[l];
+        std::vector<double> next(layer.outputs);
+        for (uint32_t o = 0; o < layer.outputs; ++o) {
+            double sum = layer.biases[o];
+            for (uint32_t i = 0; i < layer.inputs; ++i) {
+                sum += activations[i] * layer.weights[i * layer.outputs + o];
+            }
+            next[o] = (l + 1 < layers.size()) ? std::max(sum, 0.0) : sum;
+        }
+        activations = std::move(next);
+    }
+    return activations;
+}
+
+bool sameCommand(const TreeCommand& a, const TreeCommand& b)
+{
+    if (a.index() != b.index()) return false;
+    return std::visit(
+        [&](const auto& cmd) {
+            using T = std::decay_t<decltype(cmd)>;
+            if constexpr (requires { cmd.target_pos; }) {
+                return cmd.target_pos == std::get<T>(b).target_pos;
+            }
+            return true;
+        },
+        a);
+}
+
+} // namespace
+
+TEST(NeuralBrainTest, BatchedForwardMatchesReference)
+{
+    const auto layers = randomLayers({ 37, 19, 11, 6 }, 7);
+    auto network = NeuralNetwork::fromLayers(layers);
+    ASSERT_TRUE(network.isValue()) << network.errorValue();
+
+    // Six rows: one full panel of four plus a partial one. Some inputs are zero.
+    constexpr size_t BATCH = 6;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+    std::vector<float> inputs(BATCH * 37);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = (i % 3 == 0) ? 0.0f : value(rng);
+    }
+
+    std::vector<float> outputs(BATCH * 6);
+    std::vector<float> scratch;
+    network.value()->forward(inputs.data(), BATCH, outputs.data(), scratch);
+
+    for (size_t row = 0; row < BATCH; ++row) {
+        const auto expected = referenceForward(layers, &inputs[row * 37]);
+        for (size_t o = 0; o < 6; ++o) {
+            EXPECT_NEAR(outputs[row * 6 + o], expected[o], 1e-4) << "row " << row << " out " << o;
+        }
+    }
+}
+
+TEST(NeuralBrainTest, WeightsFileRoundTrip)
+{
+    auto network = NeuralNetwork::fromLayers(randomLayers({ 5, 4, 3 }, 11));
+    ASSERT_TRUE(network.isValue());
+
+    const std::string path = ::testing::TempDir() + "neural_brain_test.sdnn";
+    ASSERT_TRUE(network.value()->saveToFile(path).isValue());
+
+    auto loaded = NeuralNetwork::loadFromFile(path);
+    ASSERT_TRUE(loaded.isValue()) << loaded.errorValue();
+    ASSERT_EQ(loaded.value()->getLayers().size(), 2u);
+    EXPECT_EQ(loaded.value()->getLayers()[0].weights, network.value()->getLayers()[0].weights);
+    EXPECT_EQ(loaded.value()->getLayers()[1].biases, network.value()->getLayers()[1].biases);
+
+    // Truncated and foreign files are rejected.
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "SDNN";
+    }
+    EXPECT_TRUE(NeuralNetwork::loadFromFile(path).isError());
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "not a network";
+    }
+    EXPECT_TRUE(NeuralNetwork::loadFromFile(path).isError());
+    std::remove(path.c_str());
+
+    // A header describing more data than the file holds is rejected before allocating:
+    // 64 layers of 65536 × 65536 would be over a terabyte.
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const uint32_t header[2] = { 1, 64 }; // Version, layer count.
+        out.write("SDNN", 4);
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        const uint32_t width = 1u << 16;
+        for (int i = 0; i < 65; ++i) {
+            out.write(reinterpret_cast<const char*>(&width), sizeof(width));
+        }
+        const float payload[16] = {};
+        out.write(reinterpret_cast<const char*>(payload), sizeof(payload));
+    }
+    auto oversized = NeuralNetwork::loadFromFile(path);
+    ASSERT_TRUE(oversized.isError());
+    EXPECT_NE(oversized.errorValue().find("size does not match"), std::string::npos);
+
+    // Trailing bytes after the payload are rejected too.
+    ASSERT_TRUE(network.value()->saveToFile(path).isValue());
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out << "extra";
+    }
+    EXPECT_TRUE(NeuralNetwork::loadFromFile(path).isError());
+    std::remove(path.c_str());
+
+    // Mismatched layer shapes are rejected.
+    auto layers = randomLayers({ 5, 4, 3 }, 11);
+    layers[1].inputs = 7;
+    EXPECT_TRUE(NeuralNetwork::fromLayers(std::move(layers)).isError());
+}
+
+TEST(NeuralBrainTest, TreeManagerBatchMatchesStandaloneDecide)
+{
+    auto world = std::make_unique<World>(40, 20);
+    for (uint32_t y = 12; y < 20; y++) {
+        for (uint32_t x = 0; x < 40; x++) {
+            world->addMaterialAtCell(x, y, MaterialType::DIRT, 1.0);
+        }
+    }
+
+    // Sparse weights keep the 2254 → 16 → 676 network small and the argmax varied.
+    auto network = NeuralNetwork::fromLayers(randomLayers(
+        { NeuralBrain::INPUT_SIZE, 16, NeuralBrain::OUTPUT_SIZE }, 21, 0.5));
+    ASSERT_TRUE(network.isValue());
+    ASSERT_TRUE(NeuralBrain::isCompatible(*network.value()));
+
+    TreeManager& manager = world->getTreeManager();
+    std::vector<TreeId> ids;
+    for (uint32_t x = 3; x < 40; x += 6) {
+        auto brain = NeuralBrain::create(network.value());
+        ASSERT_TRUE(brain.isValue()) << brain.errorValue();
+        ids.push_back(manager.plantSeed(*world, x, 11, std::move(brain).value()));
+    }
+    // A rule-based tree in the same step is decided on its own.
+    const TreeId rule_based = manager.plantSeed(*world, 36, 11);
+
+    manager.update(*world, 0.016);
+
+    for (const TreeId id : ids) {
+        Tree* tree = manager.getTree(id);
+        ASSERT_NE(tree, nullptr);
+        ASSERT_TRUE(tree->current_command.has_value());
+
+        auto standalone = NeuralBrain::create(network.value());
+        ASSERT_TRUE(standalone.isValue());
+        const TreeCommand expected =
+            std::move(standalone).value()->decide(tree->gatherSensoryData(*world));
+        EXPECT_TRUE(sameCommand(*tree->current_command, expected)) << "tree " << id;
+    }
+    EXPECT_TRUE(manager.getTree(rule_based)->current_command.has_value());
+}
+
+TEST(NeuralBrainTest, CreateRejectsMissingOrIncompatibleNetwork)
+{
+    EXPECT_TRUE(NeuralBrain::create(nullptr).isError());
+
+    auto small = NeuralNetwork::fromLayers(randomLayers({ 5, 4, 3 }, 11));
+    ASSERT_TRUE(small.isValue());
+    auto brain = NeuralBrain::create(small.value());
+    ASSERT_TRUE(brain.isError());
+    EXPECT_NE(brain.errorValue().find("expected"), std::string::npos);
+}
@@ -3,7 +3,11 @@
 #include "core/WorldData.h"
 #include "core/WorldDiagramGeneratorEmoji.h"
 #include "core/organisms/TreeManager.h"
+#include "core/organisms/brains/NeuralBrain.h"
+#include "core/organisms/brains/NeuralNetwork.h"
+#include "core/organisms/brains/RuleBasedBrain.h"
 #include "server/scenarios/ScenarioRegistry.h"
+#include <cstdio>
 #include <gtest/gtest.h>
 #include <spdlog/spdlog.h>
 
@@ -86,6 +90,41 @@ TEST_F(TreeGerminationTest, SeedGerminates)
     EXPECT_EQ(tree->stage, GrowthStage::SAPLING);
 }
 
+TEST_F(TreeGerminationTest, ConfiguredWeightsDriveNeuralBrain)
+{
+    NeuralNetwork::Layer layer;
+    layer.inputs = NeuralBrain::INPUT_SIZE;
+    layer.outputs = NeuralBrain::OUTPUT_SIZE;
+    layer.weights.assign(static_cast<size_t>(layer.inputs) * layer.outputs, 0.0f);
+    layer.biases.assign(layer.outputs, 0.0f);
+    auto network = NeuralNetwork::fromLayers({ std::move(layer) });
+    ASSERT_TRUE(network.isValue()) << network.errorValue();
+
+    const std::string path = ::testing::TempDir() + "tree_germination_brain.sdnn";
+    ASSERT_TRUE(network.value()->saveToFile(path).isValue());
+
+    scenario->setConfig(TreeGerminationConfig{ .brain_weights_path = path }, *world);
+    scenario->setup(*world);
+
+    Tree* tree = world->getTreeManager().getTree(1);
+    ASSERT_NE(tree, nullptr);
+    EXPECT_NE(dynamic_cast<NeuralBrain*>(&tree->getBrain()), nullptr);
+
+    std::remove(path.c_str());
+}
+
+TEST_F(TreeGerminationTest, UnusableWeightsFallBackToRuleBasedBrain)
+{
+    scenario->setConfig(
+        TreeGerminationConfig{ .brain_weights_path = ::testing::TempDir() + "missing.sdnn" },
+        *world);
+    scenario->setup(*world);
+
+    Tree* tree = world->getTreeManager().getTree(1);
+    ASSERT_NE(tree, nullptr);
+    EXPECT_NE(dynamic_cast<RuleBasedBrain*>(&tree->getBrain()), nullptr);
+}
+
 TEST_F(TreeGerminationTest, SeedBlockedByWall)
 {
     for (uint32_t y = 0; y < 9; ++y) {
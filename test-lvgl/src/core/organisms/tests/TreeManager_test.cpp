@@ -1,8 +1,14 @@
+#include "core/GridOfCells.h"
+#include "core/MaterialType.h"
 #include "core/PhysicsSettings.h"
 #include "core/World.h"
 #include "core/WorldData.h"
 #include "core/organisms/TreeManager.h"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <map>
+#include <set>
+#include <utility>
 
 using namespace DirtSim;
 
@@ -25,3 +31,184 @@ TEST_F(TreeManagerTest, PlantSeedCreatesTree)
     EXPECT_NE(id, INVALID_TREE_ID);
     EXPECT_NE(manager->getTree(id), nullptr);
 }
+
+TEST_F(TreeManagerTest, BoundsFollowAddedAndRemovedCells)
+{
+    TreeId id = manager->plantSeed(*world, 5, 5);
+    Tree* tree = manager->getTree(id);
+    ASSERT_NE(tree, nullptr);
+
+    manager->assignCell(*tree, Vector2i{ 3, 5 });
+    manager->assignCell(*tree, Vector2i{ 5, 8 });
+    auto bounds = tree->getBounds();
+    ASSERT_TRUE(bounds.has_value());
+    EXPECT_EQ(bounds->min, (Vector2i{ 3, 5 }));
+    EXPECT_EQ(bounds->max, (Vector2i{ 5, 8 }));
+
+    // Removing an edge cell shrinks the box.
+    manager->releaseCell(Vector2i{ 5, 8 });
+    bounds = tree->getBounds();
+    ASSERT_TRUE(bounds.has_value());
+    EXPECT_EQ(bounds->max, (Vector2i{ 5, 5 }));
+
+    manager->releaseCell(Vector2i{ 3, 5 });
+    manager->releaseCell(Vector2i{ 5, 5 });
+    EXPECT_TRUE(tree->cells.empty());
+    EXPECT_FALSE(tree->getBounds().has_value());
+}
+
+TEST_F(TreeManagerTest, AssigningOwnedCellMovesItBetweenTrees)
+{
+    TreeId first_id = manager->plantSeed(*world, 2, 5);
+    TreeId second_id = manager->plantSeed(*world, 7, 5);
+    Tree* first = manager->getTree(first_id);
+    Tree* second = manager->getTree(second_id);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    manager->assignCell(*first, Vector2i{ 3, 5 });
+    manager->assignCell(*first, Vector2i{ 4, 5 });
+    manager->assignCell(*second, Vector2i{ 3, 5 });
+
+    EXPECT_EQ(manager->getTreeAtCell(Vector2i{ 3, 5 }), second_id);
+    EXPECT_EQ(first->cells.size(), 2u);
+    EXPECT_EQ(second->cells.size(), 2u);
+    EXPECT_EQ(std::count(first->cells.begin(), first->cells.end(), Vector2i{ 3, 5 }), 0);
+
+    // Assigning again is a no-op, and out-of-world cells are ignored.
+    manager->assignCell(*second, Vector2i{ 3, 5 });
+    manager->assignCell(*second, Vector2i{ 30, 5 });
+    EXPECT_EQ(second->cells.size(), 2u);
+    EXPECT_EQ(manager->getTreeAtCell(Vector2i{ 30, 5 }), INVALID_TREE_ID);
+}
+
+TEST_F(TreeManagerTest, FallingSeedKeepsExactCellSet)
+{
+    TreeManager& trees = world->getTreeManager();
+    TreeId id = trees.plantSeed(*world, 5, 2);
+    const Tree* tree = trees.getTree(id);
+    ASSERT_NE(tree, nullptr);
+
+    for (int i = 0; i < 100; i++) {
+        world->advanceTime(0.016);
+    }
+
+    // Cells left behind by the falling seed are dropped, so the tree still owns one cell
+    // and its bounds match the cells the world marks as belonging to it.
+    std::vector<Vector2i> owned;
+    for (uint32_t y = 0; y < world->getData().height; y++) {
+        for (uint32_t x = 0; x < world->getData().width; x++) {
+            if (world->getData().at(x, y).organism_id == id) {
+                owned.push_back(Vector2i{ static_cast<int>(x), static_cast<int>(y) });
+            }
+        }
+    }
+    ASSERT_FALSE(owned.empty());
+    EXPECT_EQ(tree->cells.size(), owned.size());
+    for (const auto& pos : owned) {
+        EXPECT_EQ(trees.getTreeAtCell(pos), id);
+    }
+
+    const auto bounds = tree->getBounds();
+    ASSERT_TRUE(bounds.has_value());
+    EXPECT_GT(bounds->max.y, 2);
+}
+
+namespace {
+
+// Row of seeds resting on dirt, stepped with or without parallel brain evaluation.
+std::map<TreeId, std::set<std::pair<int, int>>> growForest(bool parallel)
+{
+    const bool savedOpenMp = GridOfCells::USE_OPENMP;
+    GridOfCells::USE_OPENMP = parallel;
+
+    World world(40, 12);
+    for (uint32_t y = 8; y < 12; ++y) {
+        for (uint32_t x = 0; x < 40; ++x) {
+            world.addMaterialAtCell(x, y, MaterialType::DIRT, 1.0);
+        }
+    }
+    for (uint32_t x = 2; x < 38; x += 3) {
+        world.getTreeManager().plantSeed(world, x, 7);
+    }
+    for (int i = 0; i < 300; ++i) {
+        world.advanceTime(0.016);
+    }
+
+    std::map<TreeId, std::set<std::pair<int, int>>> result;
+    for (const auto& [id, tree] : world.getTreeManager().getTrees()) {
+        for (const auto& pos : tree.cells) {
+            result[id].insert({ pos.x, pos.y });
+        }
+    }
+
+    GridOfCells::USE_OPENMP = savedOpenMp;
+    return result;
+}
+
+} // namespace
+
+TEST_F(TreeManagerTest, ParallelDecisionsMatchSerial)
+{
+    const auto serial = growForest(false);
+    const auto parallel = growForest(true);
+
+    ASSERT_GE(serial.size(), TreeManager::PARALLEL_DECIDE_MIN_TREES);
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST(TreeManagerSupportTest, DisconnectedBranchLosesSupport)
+{
+    World world(30, 30);
+    TreeManager& trees = world.getTreeManager();
+    const TreeId id = trees.plantSeed(world, 4, 20);
+    Tree* tree = trees.getTree(id);
+    ASSERT_NE(tree, nullptr);
+
+    const auto grow = [&](int x, int y, MaterialType material) {
+        world.addMaterialAtCell(x, y, material, 1.0);
+        world.getData().at(x, y).organism_id = id;
+        trees.assignCell(*tree, Vector2i{ x, y });
+    };
+
+    // Roots below the seed, gripping walls on both sides: the budget covers the whole tree.
+    for (int y = 21; y <= 22; ++y) {
+        grow(4, y, MaterialType::ROOT);
+        world.addMaterialAtCell(3, y, MaterialType::WALL, 1.0);
+        world.addMaterialAtCell(5, y, MaterialType::WALL, 1.0);
+    }
+
+    // Trunk up from the seed, then a branch to the right. The tree-local bitmap starts at
+    // (4, 8), so the trunk crosses a block row edge (y 15/16) and the branch a block column
+    // edge (x 11/12).
+    std::vector<Vector2i> connected = { { 4, 20 }, { 4, 21 }, { 4, 22 } };
+    for (int y = 8; y <= 19; ++y) {
+        grow(4, y, MaterialType::WOOD);
+        connected.push_back({ 4, y });
+    }
+    for (int x = 5; x <= 16; ++x) {
+        grow(x, 8, MaterialType::LEAF);
+        connected.push_back({ x, 8 });
+    }
+
+    // Broken-off pieces: one straddles the block column edge without touching the tree, one
+    // only touches the branch tip diagonally.
+    const std::vector<Vector2i> disconnected = { { 11, 11 }, { 12, 11 }, { 12, 12 }, { 17, 9 } };
+    for (const auto& pos : disconnected) {
+        grow(pos.x, pos.y, MaterialType::LEAF);
+    }
+
+    for (const auto& pos : tree->cells) {
+        world.getData().at(pos.x, pos.y).has_any_support = false;
+    }
+    trees.computeOrganismSupport(world);
+
+    for (const auto& pos : connected) {
+        EXPECT_TRUE(world.getData().at(pos.x, pos.y).has_any_support)
+            << "(" << pos.x << ", " << pos.y << ")";
+    }
+    for (const auto& pos : disconnected) {
+        EXPECT_FALSE(world.getData().at(pos.x, pos.y).has_any_support)
+            << "(" << pos.x << ", " << pos.y << ")";
+    }
+}
@@ -136,12 +136,12 @@ TEST(TreeSensoryTest, MassCalculationNoDuplicates)
     // Force grow ROOT at (4,6).
     world->getData().at(4, 6).replaceMaterial(MaterialType::ROOT, 1.0);
     world->getData().at(4, 6).organism_id = tree_id;
-    tree->cells.insert(Vector2i{ 4, 6 });
+    world->getTreeManager().assignCell(*tree, Vector2i{ 4, 6 });
 
     // Force grow WOOD at (4,4).
     world->getData().at(4, 4).replaceMaterial(MaterialType::WOOD, 1.0);
     world->getData().at(4, 4).organism_id = tree_id;
-    tree->cells.insert(Vector2i{ 4, 4 });
+    world->getTreeManager().assignCell(*tree, Vector2i{ 4, 4 });
 
     // Update seed position (it fell).
     tree->seed_position = Vector2i{ 4, 5 };
@@ -168,3 +168,71 @@ TEST(TreeSensoryTest, MassCalculationNoDuplicates)
     EXPECT_EQ(root_count, 1) << "Should find exactly 1 ROOT in histograms";
     EXPECT_EQ(wood_count, 1) << "Should find exactly 1 WOOD in histograms";
 }
+
+/**
+ * Test that downsampled histograms from the shared summed-area tables match the
+ * cell-by-cell count for a tree larger than the sensory grid.
+ */
+TEST(TreeSensoryTest, SummedAreaHistogramsMatchDirectCount)
+{
+    auto world = std::make_unique<World>(48, 48);
+
+    // Mixed terrain so every bucket sees several materials.
+    for (uint32_t y = 0; y < 48; y++) {
+        for (uint32_t x = 0; x < 48; x++) {
+            world->getData().at(x, y) = Cell();
+            if (y >= 30) {
+                const MaterialType material = (x + y) % 3 ? MaterialType::DIRT : MaterialType::SAND;
+                world->addMaterialAtCell(x, y, material, 1.0);
+            }
+            else if ((x * 7 + y) % 11 == 0) {
+                world->addMaterialAtCell(x, y, MaterialType::WATER, 1.0);
+            }
+        }
+    }
+
+    TreeId tree_id = world->getTreeManager().plantSeed(*world, 20, 29);
+    Tree* tree = world->getTreeManager().getTree(tree_id);
+    ASSERT_NE(tree, nullptr);
+
+    // A 23×27 tree: trunk up, roots down, a wide canopy.
+    auto grow = [&](int x, int y, MaterialType material) {
+        world->getData().at(x, y).replaceMaterial(material, 1.0);
+        world->getData().at(x, y).organism_id = tree_id;
+        world->getTreeManager().assignCell(*tree, Vector2i{ x, y });
+    };
+    for (int y = 8; y < 29; y++) {
+        grow(20, y, MaterialType::WOOD);
+    }
+    for (int y = 30; y < 35; y++) {
+        grow(20, y, MaterialType::ROOT);
+    }
+    for (int x = 9; x < 32; x++) {
+        grow(x, 8, MaterialType::LEAF);
+    }
+
+    const TreeSensoryData direct = tree->gatherSensoryData(*world);
+    ASSERT_GT(direct.scale_factor, 1.0);
+
+    MaterialSumTable sums;
+    sums.build(world->getData(), Vector2i{ 0, 0 }, Vector2i{ 47, 47 });
+    const TreeSensoryData fast = tree->gatherSensoryData(*world, &sums);
+
+    EXPECT_EQ(fast.world_offset.x, direct.world_offset.x);
+    EXPECT_EQ(fast.world_offset.y, direct.world_offset.y);
+    for (int y = 0; y < TreeSensoryData::GRID_SIZE; y++) {
+        for (int x = 0; x < TreeSensoryData::GRID_SIZE; x++) {
+            for (int m = 0; m < TreeSensoryData::NUM_MATERIALS; m++) {
+                EXPECT_DOUBLE_EQ(
+                    fast.material_histograms[y][x][m], direct.material_histograms[y][x][m])
+                    << "Bucket (" << x << "," << y << ") material " << m;
+            }
+        }
+    }
+
+    // A table that does not cover the window falls back to direct counting.
+    MaterialSumTable partial;
+    partial.build(world->getData(), Vector2i{ 0, 0 }, Vector2i{ 10, 10 });
+    const TreeSensoryData fallback = tree->gatherSensoryData(*world, &partial);
+    EXPECT_EQ(fallback.material_histograms, direct.material_histograms);
+}
@@ -2,21 +2,28 @@
 
 #include "api/CellGet.h"
 #include "api/CellSet.h"
+#include "api/CellsSetBulk.h"
 #include "api/DiagramGet.h"
 #include "api/Exit.h"
 #include "api/GravitySet.h"
+#include "api/MemoryStatsGet.h"
 #include "api/PerfStatsGet.h"
 #include "api/PhysicsSettingsGet.h"
 #include "api/PhysicsSettingsSet.h"
+#include "api/ProfileStart.h"
+#include "api/ProfileStop.h"
 #include "api/RenderFormatSet.h"
 #include "api/Reset.h"
 #include "api/ScenarioConfigSet.h"
 #include "api/SeedAdd.h"
 #include "api/SimRun.h"
+#include "api/SlowFramesGet.h"
 #include "api/SpawnDirtBall.h"
 #include "api/StateGet.h"
 #include "api/StatusGet.h"
 #include "api/TimerStatsGet.h"
+#include "api/TraceStart.h"
+#include "api/TraceStop.h"
 #include "api/WorldResize.h"
 #include "core/MaterialType.h"
 #include "core/SimulationStats.h"
@@ -463,21 +470,28 @@ public:
         // API commands (network/remote control).
         DirtSim::Api::CellGet::Cwc,
         DirtSim::Api::CellSet::Cwc,
+        DirtSim::Api::CellsSetBulk::Cwc,
         DirtSim::Api::DiagramGet::Cwc,
         DirtSim::Api::Exit::Cwc,
         DirtSim::Api::GravitySet::Cwc,
+        DirtSim::Api::MemoryStatsGet::Cwc,
         DirtSim::Api::PerfStatsGet::Cwc,
         DirtSim::Api::PhysicsSettingsGet::Cwc,
         DirtSim::Api::PhysicsSettingsSet::Cwc,
+        DirtSim::Api::ProfileStart::Cwc,
+        DirtSim::Api::ProfileStop::Cwc,
         DirtSim::Api::RenderFormatSet::Cwc,
         DirtSim::Api::Reset::Cwc,
         DirtSim::Api::ScenarioConfigSet::Cwc,
         DirtSim::Api::SeedAdd::Cwc,
         DirtSim::Api::SimRun::Cwc,
+        DirtSim::Api::SlowFramesGet::Cwc,
         DirtSim::Api::SpawnDirtBall::Cwc,
         DirtSim::Api::StateGet::Cwc,
         DirtSim::Api::StatusGet::Cwc,
         DirtSim::Api::TimerStatsGet::Cwc,
+        DirtSim::Api::TraceStart::Cwc,
+        DirtSim::Api::TraceStop::Cwc,
         DirtSim::Api::WorldResize::Cwc,
 
         // State transitions.
@@ -0,0 +1,143 @@
+#include "FlightRecorder.h"
+#include "core/ReflectSerializer.h"
+#include <filesystem>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace DirtSim {
+namespace Server {
+
+FlightRecorder::FlightRecorder()
+{
+    size_t index = 0;
+    for (const auto name : WORLD_STAGES) {
+        stageIds_[index++] = Timers::intern(name);
+    }
+    for (const auto name : SERVER_STAGES) {
+        stageIds_[index++] = Timers::intern(name);
+    }
+    resizeRing();
+}
+
+void FlightRecorder::setConfig(const Config& config)
+{
+    config_ = config;
+    pending_.reset();
+    resizeRing();
+
+    if (config_.thresholdMs > 0.0) {
+        spdlog::info(
+            "FlightRecorder: Capturing frames over {:.1f}ms ({} before, {} after){}",
+            config_.thresholdMs,
+            config_.framesBefore,
+            config_.framesAfter,
+            config_.dumpDirectory.empty() ? "" : ", dumping to " + config_.dumpDirectory);
+    }
+}
+
+void FlightRecorder::recordFrame(
+    const FrameCounters& counters, const Timers& worldTimers, const Timers& serverTimers)
+{
+    FrameRecord& record = ring_[framesRecorded_ % ring_.size()];
+    record.counters = counters;
+
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Timers& timers = i < WORLD_STAGES.size() ? worldTimers : serverTimers;
+        const int64_t accumulated = timers.getAccumulatedNs(stageIds_[i]);
+
+        // A smaller total means the Timers were replaced (new World), so count from zero.
+        int64_t delta = accumulated - lastAccumulatedNs_[i];
+        if (delta < 0) {
+            delta = accumulated;
+        }
+        lastAccumulatedNs_[i] = accumulated;
+        record.stageMs[i] = static_cast<float>(delta / 1e6);
+    }
+
+    const uint64_t frame = framesRecorded_++;
+
+    // Slow frames inside an open capture window are already covered by it.
+    if (!pending_ && config_.thresholdMs > 0.0 && counters.frameMs > config_.thresholdMs) {
+        pending_ = PendingCapture{
+            .triggerTimestep = counters.timestep,
+            .triggerFrameMs = counters.frameMs,
+            .firstFrame = frame >= config_.framesBefore ? frame - config_.framesBefore : 0,
+            .lastFrame = frame + config_.framesAfter,
+        };
+    }
+
+    if (pending_ && frame >= pending_->lastFrame) {
+        finishCapture(*pending_);
+        pending_.reset();
+    }
+}
+
+void FlightRecorder::clearCaptures()
+{
+    captures_.clear();
+}
+
+void FlightRecorder::resizeRing()
+{
+    ring_.assign(config_.framesBefore + config_.framesAfter + 1, FrameRecord{});
+    framesRecorded_ = 0;
+}
+
+void FlightRecorder::finishCapture(const PendingCapture& pending)
+{
+    Api::SlowFramesGet::Capture capture;
+    capture.trigger_timestep = pending.triggerTimestep;
+    capture.trigger_frame_ms = pending.triggerFrameMs;
+
+    for (uint64_t frame = pending.firstFrame; frame <= pending.lastFrame; ++frame) {
+        capture.frames.push_back(toEntry(ring_[frame % ring_.size()]));
+    }
+
+    spdlog::warn(
+        "FlightRecorder: Slow frame at timestep {} ({:.1f}ms > {:.1f}ms)",
+        capture.trigger_timestep,
+        capture.trigger_frame_ms,
+        config_.thresholdMs);
+
+    if (!config_.dumpDirectory.empty()) {
+        const std::filesystem::path path = std::filesystem::path(config_.dumpDirectory)
+            / ("slow-frame-" + std::to_string(capture.trigger_timestep) + ".json");
+        std::ofstream file(path);
+        file << ReflectSerializer::to_json(capture).dump(2);
+        if (file.good()) {
+            capture.file = path.string();
+            spdlog::info("FlightRecorder: Wrote {}", capture.file);
+        }
+        else {
+            spdlog::error("FlightRecorder: Failed to write {}", path.string());
+        }
+    }
+
+    captures_.push_back(std::move(capture));
+    if (captures_.size() > MAX_CAPTURES) {
+        captures_.pop_front();
+    }
+}
+
+Api::SlowFramesGet::FrameEntry FlightRecorder::toEntry(const FrameRecord& record) const
+{
+    Api::SlowFramesGet::FrameEntry entry{
+        .timestep = record.counters.timestep,
+        .frame_ms = record.counters.frameMs,
+        .active_cells = record.counters.activeCells,
+        .pending_moves = record.counters.pendingMoves,
+        .blocked_transfers = record.counters.blockedTransfers,
+        .client_count = record.counters.clientCount,
+        .stage_ms = {},
+    };
+
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const std::string_view name =
+            i < WORLD_STAGES.size() ? WORLD_STAGES[i] : SERVER_STAGES[i - WORLD_STAGES.size()];
+        entry.stage_ms.emplace(std::string(name), record.stageMs[i]);
+    }
+    return entry;
+}
+
+} // namespace Server
+} // namespace DirtSim
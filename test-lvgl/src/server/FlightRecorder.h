@@ -0,0 +1,105 @@
+#pragma once
+
+#include "core/Timers.h"
+#include "server/api/SlowFramesGet.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DirtSim {
+namespace Server {
+
+/**
+ * @brief Always-on ring of per-tick records that captures context around slow frames.
+ *
+ * Each tick records its wall time, per-stage durations (deltas of the World and server
+ * Timers), and the World's work counters. When a tick exceeds the threshold, the frames
+ * before it plus the next framesAfter frames are assembled into a capture, kept for
+ * slow_frames_get and optionally dumped as JSON. Runs on the physics thread only.
+ */
+class FlightRecorder {
+public:
+    struct Config {
+        double thresholdMs = 0.0; // 0 = never capture.
+        uint32_t framesBefore = 30;
+        uint32_t framesAfter = 10;
+        std::string dumpDirectory; // Empty = keep captures in memory only.
+    };
+
+    // Counters supplied by the caller for each tick.
+    struct FrameCounters {
+        uint64_t timestep = 0;
+        double frameMs = 0.0;
+        uint32_t activeCells = 0;
+        uint32_t pendingMoves = 0;
+        uint32_t blockedTransfers = 0;
+        uint32_t clientCount = 0;
+    };
+
+    static constexpr size_t MAX_CAPTURES = 16;
+
+    // Stages taken from the World's Timers, then from the server StateMachine's Timers.
+    static constexpr std::array<std::string_view, 12> WORLD_STAGES = {
+        "grid_cache_rebuild", "compute_support_map", "organism_support",
+        "hydrostatic_pressure", "resolve_forces",     "velocity_limiting",
+        "update_transfers",   "process_moves",       "dynamic_pressure",
+        "pressure_diffusion", "pressure_decay",      "tree_organisms",
+    };
+    static constexpr std::array<std::string_view, 3> SERVER_STAGES = {
+        "scenario_tick",
+        "cache_update",
+        "broadcast_render_message",
+    };
+    static constexpr size_t STAGE_COUNT = WORLD_STAGES.size() + SERVER_STAGES.size();
+
+    FlightRecorder();
+
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Record one finished tick.
+     * @param worldTimers Timers of the World that was stepped.
+     * @param serverTimers Timers of the server StateMachine.
+     */
+    void recordFrame(
+        const FrameCounters& counters, const Timers& worldTimers, const Timers& serverTimers);
+
+    const std::deque<Api::SlowFramesGet::Capture>& getCaptures() const { return captures_; }
+    void clearCaptures();
+
+private:
+    struct FrameRecord {
+        FrameCounters counters;
+        std::array<float, STAGE_COUNT> stageMs{};
+    };
+
+    struct PendingCapture {
+        uint64_t triggerTimestep = 0;
+        double triggerFrameMs = 0.0;
+        uint64_t firstFrame = 0; // Absolute frame number of the first frame to include.
+        uint64_t lastFrame = 0;
+    };
+
+    Config config_;
+    std::array<Timers::TimerId, STAGE_COUNT> stageIds_{};
+    std::array<int64_t, STAGE_COUNT> lastAccumulatedNs_{};
+
+    std::vector<FrameRecord> ring_;
+    uint64_t framesRecorded_ = 0;
+
+    std::optional<PendingCapture> pending_;
+    std::deque<Api::SlowFramesGet::Capture> captures_;
+
+    void resizeRing();
+    void finishCapture(const PendingCapture& pending);
+    Api::SlowFramesGet::FrameEntry toEntry(const FrameRecord& record) const;
+};
+
+} // namespace Server
+} // namespace DirtSim
@@ -0,0 +1,193 @@
+#include "MetricsExporter.h"
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+
+namespace DirtSim {
+namespace Server {
+
+static_assert(std::is_trivially_copyable_v<MetricsExporter::Snapshot>);
+
+MetricsExporter::MetricsExporter()
+{
+    size_t index = 0;
+    for (const auto name : FlightRecorder::WORLD_STAGES) {
+        stageIds_[index++] = Timers::intern(name);
+    }
+    for (const auto name : SERVER_STAGES) {
+        stageIds_[index++] = Timers::intern(name);
+    }
+}
+
+std::string_view MetricsExporter::stageName(size_t index)
+{
+    if (index < FlightRecorder::WORLD_STAGES.size()) {
+        return FlightRecorder::WORLD_STAGES[index];
+    }
+    return SERVER_STAGES[index - FlightRecorder::WORLD_STAGES.size()];
+}
+
+bool MetricsExporter::publishDue(std::chrono::steady_clock::time_point now) const
+{
+    return enabled_ && now - lastPublish_ >= PUBLISH_INTERVAL;
+}
+
+void MetricsExporter::publish(
+    const Sample& sample,
+    const Timers& worldTimers,
+    const Timers& serverTimers,
+    std::chrono::steady_clock::time_point now)
+{
+    lastPublish_ = now;
+
+    Snapshot snapshot;
+    snapshot.sample = sample;
+    snapshot.paused = false;
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Timers& timers =
+            i < FlightRecorder::WORLD_STAGES.size() ? worldTimers : serverTimers;
+        StageSnapshot& stage = snapshot.stages[i];
+        stage.count = timers.getCumulativeCounts(stageIds_[i], BUCKET_BOUNDS_MS, stage.buckets);
+        stage.sumSeconds = timers.getAccumulatedNs(stageIds_[i]) / 1e9;
+    }
+    store(snapshot);
+}
+
+void MetricsExporter::publishPaused(bool paused)
+{
+    Snapshot snapshot = last_;
+    snapshot.paused = paused;
+    if (paused) {
+        snapshot.sample.stepRate = 0.0;
+    }
+    store(snapshot);
+}
+
+void MetricsExporter::store(Snapshot& snapshot)
+{
+    snapshot.publishedUnixSeconds =
+        std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    last_ = snapshot;
+
+    std::array<uint64_t, WORDS> buffer{};
+    std::memcpy(buffer.data(), &snapshot, sizeof(Snapshot));
+
+    const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i) {
+        words_[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence_.store(seq + 2, std::memory_order_release);
+}
+
+MetricsExporter::Snapshot MetricsExporter::read() const
+{
+    std::array<uint64_t, WORDS> buffer{};
+    while (true) {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        for (size_t i = 0; i < WORDS; ++i) {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    Snapshot snapshot;
+    std::memcpy(static_cast<void*>(&snapshot), buffer.data(), sizeof(Snapshot));
+    return snapshot;
+}
+
+namespace {
+
+void header(std::ostringstream& out, const char* name, const char* type, const char* help)
+{
+    out << "# HELP " << name << ' ' << help << '\n';
+    out << "# TYPE " << name << ' ' << type << '\n';
+}
+
+} // namespace
+
+std::string MetricsExporter::renderPrometheus() const
+{
+    const Snapshot snapshot = read();
+    const Sample& s = snapshot.sample;
+
+    std::ostringstream out;
+    out.precision(9);
+
+    header(out, "sparkle_duck_paused", "gauge", "1 while no physics steps run (paused or idle).");
+    out << "sparkle_duck_paused " << (snapshot.paused ? 1 : 0) << '\n';
+    header(
+        out,
+        "sparkle_duck_last_update_timestamp_seconds",
+        "gauge",
+        "Unix time these values were published (0 = never).");
+    out << "sparkle_duck_last_update_timestamp_seconds " << std::fixed
+        << snapshot.publishedUnixSeconds << std::defaultfloat << '\n';
+    header(out, "sparkle_duck_steps_total", "counter", "Physics steps since the run started.");
+    out << "sparkle_duck_steps_total " << s.stepsTotal << '\n';
+    header(out, "sparkle_duck_step_rate", "gauge", "Physics steps per second.");
+    out << "sparkle_duck_step_rate " << s.stepRate << '\n';
+    header(out, "sparkle_duck_timestep", "gauge", "Current world timestep.");
+    out << "sparkle_duck_timestep " << s.timestep << '\n';
+    header(out, "sparkle_duck_world_width", "gauge", "World width in cells.");
+    out << "sparkle_duck_world_width " << s.worldWidth << '\n';
+    header(out, "sparkle_duck_world_height", "gauge", "World height in cells.");
+    out << "sparkle_duck_world_height " << s.worldHeight << '\n';
+    header(out, "sparkle_duck_active_cells", "gauge", "Cells processed in the last step.");
+    out << "sparkle_duck_active_cells " << s.activeCells << '\n';
+    header(out, "sparkle_duck_clients", "gauge", "Connected WebSocket clients.");
+    out << "sparkle_duck_clients " << s.clients << '\n';
+
+    header(out, "sparkle_duck_sent_bytes_total", "counter", "Bytes sent to clients by format.");
+    out << "sparkle_duck_sent_bytes_total{format=\"basic\"} " << s.renderBytesSent[0] << '\n';
+    out << "sparkle_duck_sent_bytes_total{format=\"debug\"} " << s.renderBytesSent[1] << '\n';
+    out << "sparkle_duck_sent_bytes_total{format=\"binary\"} " << s.otherBytesSent << '\n';
+    header(
+        out,
+        "sparkle_duck_frames_delivered_total",
+        "counter",
+        "Render frames delivered to clients by format.");
+    out << "sparkle_duck_frames_delivered_total{format=\"basic\"} "
+        << s.renderFramesDelivered[0] << '\n';
+    out << "sparkle_duck_frames_delivered_total{format=\"debug\"} "
+        << s.renderFramesDelivered[1] << '\n';
+    header(
+        out,
+        "sparkle_duck_frames_dropped_total",
+        "counter",
+        "Frames skipped for clients (FPS cap or backpressure).");
+    out << "sparkle_duck_frames_dropped_total " << s.framesDropped << '\n';
+
+    header(
+        out,
+        "sparkle_duck_stage_duration_seconds",
+        "histogram",
+        "Per-stage step latency (bucketed from Timers histograms, ~12.5% resolution).");
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const StageSnapshot& stage = snapshot.stages[i];
+        const std::string_view name = stageName(i);
+        for (size_t b = 0; b < BUCKET_BOUNDS_MS.size(); ++b) {
+            out << "sparkle_duck_stage_duration_seconds_bucket{stage=\"" << name << "\",le=\""
+                << BUCKET_BOUNDS_MS[b] / 1000.0 << "\"} " << stage.buckets[b] << '\n';
+        }
+        out << "sparkle_duck_stage_duration_seconds_bucket{stage=\"" << name
+            << "\",le=\"+Inf\"} " << stage.count << '\n';
+        out << "sparkle_duck_stage_duration_seconds_sum{stage=\"" << name << "\"} "
+            << stage.sumSeconds << '\n';
+        out << "sparkle_duck_stage_duration_seconds_count{stage=\"" << name << "\"} "
+            << stage.count << '\n';
+    }
+
+    return out.str();
+}
+
+} // namespace Server
+} // namespace DirtSim
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "FlightRecorder.h"
+#include "core/Timers.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace DirtSim {
+namespace Server {
+
+/**
+ * @brief Live counters for Prometheus-style scraping.
+ *
+ * The physics thread publishes a fixed-size snapshot (at most every PUBLISH_INTERVAL) into a
+ * seqlock; the metrics HTTP thread reads it without taking any lock the physics thread could
+ * wait on. Stage latency histograms are folded out of the Timers' own log-linear histograms,
+ * so enabling the exporter adds no per-stage bookkeeping to the step itself. Ticks only happen
+ * in SimRunning, so state transitions publish too (publishPaused) and every snapshot carries its
+ * wall-clock publish time: scrapers can tell a paused server from a stalled one.
+ */
+class MetricsExporter {
+public:
+    // Per-tick values supplied by SimRunning.
+    struct Sample {
+        uint64_t stepsTotal = 0;
+        double stepRate = 0.0;
+        uint64_t timestep = 0;
+        uint32_t worldWidth = 0;
+        uint32_t worldHeight = 0;
+        uint32_t activeCells = 0;
+        uint32_t clients = 0;
+        std::array<uint64_t, 2> renderBytesSent{}; // Indexed by RenderFormat.
+        std::array<uint64_t, 2> renderFramesDelivered{};
+        uint64_t otherBytesSent = 0; // broadcastBinary payloads.
+        uint64_t framesDropped = 0;
+    };
+
+    // Histogram upper bounds in milliseconds (exported in seconds).
+    static constexpr std::array<double, 13> BUCKET_BOUNDS_MS = {
+        0.01, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0,
+    };
+
+    // World stages, then server stages (timed by the StateMachine's Timers).
+    static constexpr std::array<std::string_view, 4> SERVER_STAGES = {
+        "physics_step",
+        "scenario_tick",
+        "cache_update",
+        "broadcast_render_message",
+    };
+    static constexpr size_t STAGE_COUNT =
+        FlightRecorder::WORLD_STAGES.size() + SERVER_STAGES.size();
+
+    static constexpr auto PUBLISH_INTERVAL = std::chrono::milliseconds(100);
+
+    struct StageSnapshot {
+        uint64_t count = 0;
+        double sumSeconds = 0.0;
+        std::array<uint64_t, BUCKET_BOUNDS_MS.size()> buckets{}; // Cumulative.
+    };
+
+    struct Snapshot {
+        Sample sample;
+        std::array<StageSnapshot, STAGE_COUNT> stages{};
+        bool paused = false; // No physics ticks (SimPaused or Idle).
+        double publishedUnixSeconds = 0.0; // Wall-clock time of the publish (0 = never).
+    };
+
+    MetricsExporter();
+
+    void setEnabled(bool enabled) { enabled_ = enabled; }
+    bool isEnabled() const { return enabled_; }
+
+    // True when enabled and PUBLISH_INTERVAL has passed since the last publish.
+    bool publishDue(std::chrono::steady_clock::time_point now) const;
+
+    /**
+     * @brief Publish a new snapshot (physics thread only).
+     * @param worldTimers Timers of the World being stepped.
+     * @param serverTimers Timers of the server StateMachine.
+     */
+    void publish(
+        const Sample& sample,
+        const Timers& worldTimers,
+        const Timers& serverTimers,
+        std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Re-publish the latest snapshot with the run state changed (physics thread only).
+     *
+     * Called on state transitions, since publish() only runs from SimRunning's tick. Pausing
+     * zeroes the step rate; counters and histograms keep their last values. Not rate limited.
+     */
+    void publishPaused(bool paused);
+
+    // Latest published snapshot (any thread; zeros before the first publish).
+    Snapshot read() const;
+
+    // Latest snapshot in the Prometheus text exposition format (version 0.0.4).
+    std::string renderPrometheus() const;
+
+    static std::string_view stageName(size_t index);
+
+private:
+    static constexpr size_t WORDS = (sizeof(Snapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    bool enabled_ = false;
+    std::chrono::steady_clock::time_point lastPublish_;
+    std::array<Timers::TimerId, STAGE_COUNT> stageIds_{};
+    Snapshot last_; // Copy of the latest publish, for publishPaused (physics thread only).
+
+    void store(Snapshot& snapshot);
+
+    // Seqlock: odd while a write is in progress. The payload is stored word by word in
+    // relaxed atomics so a torn read is detected (and retried) rather than undefined.
+    std::atomic<uint64_t> sequence_{ 0 };
+    std::array<std::atomic<uint64_t>, WORDS> words_{};
+};
+
+} // namespace Server
+} // namespace DirtSim
@@ -1,19 +1,25 @@
 #include "StateMachine.h"
 #include "Event.h"
 #include "EventProcessor.h"
+#include "FlightRecorder.h"
+#include "MetricsExporter.h"
 #include "core/ScenarioConfig.h"
 #include "core/Timers.h"
+#include "core/TraceRecorder.h"
 #include "core/World.h" // Must be first for complete type in variant.
 #include "core/WorldData.h"
 #include "core/WorldEventGenerator.h"
 #include "scenarios/Scenario.h"
 #include "scenarios/ScenarioRegistry.h"
 #include "states/State.h"
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <mutex>
 #include <spdlog/spdlog.h>
 #include <thread>
+#include <vector>
 
 namespace DirtSim {
 namespace Server {
@@ -26,10 +32,23 @@ struct StateMachine::Impl {
     EventProcessor eventProcessor_;
     ScenarioRegistry scenarioRegistry_;
     Timers timers_;
+    FlightRecorder flightRecorder_;
+    MetricsExporter metricsExporter_;
     State::Any fsmState_{ State::Startup{} };
     class WebSocketServer* wsServer_ = nullptr;
-    std::shared_ptr<WorldData> cachedWorldData_;
-    mutable std::mutex cachedWorldDataMutex_;
+
+    // World snapshot publication. Buffers are recycled once no reader references them, so
+    // steady-state publishing reuses the cell vectors instead of allocating.
+    std::array<std::shared_ptr<WorldData>, 3> snapshotBuffers_;
+    std::shared_ptr<const WorldData> publishedSnapshot_;
+    uint64_t publishedGeneration_ = 0;
+    std::atomic<uint64_t> latestGeneration_{ 0 };
+    mutable std::atomic<bool> snapshotRequested_{ false };
+    mutable std::mutex snapshotMutex_;
+    mutable std::vector<WorldDataCallback> pendingRequests_; // Guarded by snapshotMutex_.
+
+    std::optional<Api::StatusGet::Okay> cachedStatus_;
+    mutable std::mutex cachedStatusMutex_;
 
     Impl() : scenarioRegistry_(ScenarioRegistry::createDefault()) {}
 };
@@ -75,16 +94,103 @@ void StateMachine::setWebSocketServer(WebSocketServer* server)
     pImpl->wsServer_ = server;
 }
 
-void StateMachine::updateCachedWorldData(const WorldData& data)
+void StateMachine::updateCachedWorldData(const WorldData& data, bool force)
 {
-    std::lock_guard<std::mutex> lock(pImpl->cachedWorldDataMutex_);
-    pImpl->cachedWorldData_ = std::make_shared<WorldData>(data);
+    const uint64_t generation = ++pImpl->latestGeneration_;
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->cachedStatusMutex_);
+        if (!pImpl->cachedStatus_) {
+            pImpl->cachedStatus_.emplace();
+        }
+        auto& status = *pImpl->cachedStatus_;
+        status.timestep = data.timestep;
+        status.scenario_id = data.scenario_id;
+        status.width = data.width;
+        status.height = data.height;
+    }
+
+    if (!pImpl->snapshotRequested_.exchange(false) && !force) {
+        return;
+    }
+
+    // Find a back buffer held by nobody else. The published snapshot and any snapshot
+    // still referenced by a reader have use_count > 1, so they are never overwritten.
+    std::shared_ptr<WorldData> back;
+    for (auto& buffer : pImpl->snapshotBuffers_) {
+        if (!buffer) {
+            buffer = std::make_shared<WorldData>();
+        }
+        if (buffer.use_count() == 1) {
+            back = buffer;
+            break;
+        }
+    }
+
+    if (back) {
+        // Copy-assign reuses the existing vector capacity.
+        *back = data;
+    }
+    else {
+        // All buffers are held by slow readers - fall back to a one-off allocation.
+        back = std::make_shared<WorldData>(data);
+    }
+
+    std::vector<WorldDataCallback> pending;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->snapshotMutex_);
+        pImpl->publishedSnapshot_ = back;
+        pImpl->publishedGeneration_ = generation;
+        pending.swap(pImpl->pendingRequests_);
+    }
+
+    // Callbacks run outside the lock, on this (physics) thread: they only hand the snapshot
+    // to another thread, which does any serializing and sending.
+    for (auto& callback : pending) {
+        callback(back);
+    }
+}
+
+void StateMachine::requestWorldData(WorldDataCallback callback) const
+{
+    std::shared_ptr<const WorldData> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->snapshotMutex_);
+        if (pImpl->publishedGeneration_ < pImpl->latestGeneration_.load()) {
+            pImpl->pendingRequests_.push_back(std::move(callback));
+            pImpl->snapshotRequested_ = true;
+            return;
+        }
+        snapshot = pImpl->publishedSnapshot_; // May be nullptr.
+    }
+    callback(std::move(snapshot));
 }
 
-std::shared_ptr<WorldData> StateMachine::getCachedWorldData() const
+std::shared_ptr<const WorldData> StateMachine::getCachedWorldData() const
 {
-    std::lock_guard<std::mutex> lock(pImpl->cachedWorldDataMutex_);
-    return pImpl->cachedWorldData_; // Returns shared_ptr (may be nullptr).
+    std::lock_guard<std::mutex> lock(pImpl->snapshotMutex_);
+    return pImpl->publishedSnapshot_; // May be nullptr.
+}
+
+void StateMachine::flushWorldDataRequests()
+{
+    std::vector<WorldDataCallback> pending;
+    std::shared_ptr<const WorldData> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->snapshotMutex_);
+        pending.swap(pImpl->pendingRequests_);
+        snapshot = pImpl->publishedSnapshot_;
+    }
+
+    for (auto& callback : pending) {
+        callback(snapshot);
+    }
+}
+
+std::optional<Api::StatusGet::Okay> StateMachine::getCachedStatus() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->cachedStatusMutex_);
+    return pImpl->cachedStatus_;
 }
 
 ScenarioRegistry& StateMachine::getScenarioRegistry()
@@ -107,9 +213,30 @@ const Timers& StateMachine::getTimers() const
     return pImpl->timers_;
 }
 
+FlightRecorder& StateMachine::getFlightRecorder()
+{
+    return pImpl->flightRecorder_;
+}
+
+const FlightRecorder& StateMachine::getFlightRecorder() const
+{
+    return pImpl->flightRecorder_;
+}
+
+MetricsExporter& StateMachine::getMetricsExporter()
+{
+    return pImpl->metricsExporter_;
+}
+
+const MetricsExporter& StateMachine::getMetricsExporter() const
+{
+    return pImpl->metricsExporter_;
+}
+
 void StateMachine::mainLoopRun()
 {
     spdlog::info("Starting main event loop");
+    TraceRecorder::setThreadName("physics");
 
     // Initialize by sending init complete event.
     queueEvent(InitCompleteEvent{});
@@ -270,6 +397,9 @@ void StateMachine::transitionTo(State::Any newState)
 
     // Call onEnter for new state.
     std::visit([this](auto& state) { callOnEnter(state); }, pImpl->fsmState_.getVariant());
+
+    // The new state may never tick again; don't leave state_get requests waiting.
+    flushWorldDataRequests();
 }
 
 // Global event handlers.
@@ -3,9 +3,11 @@
 #include "core/Pimpl.h"
 #include "core/StateMachineBase.h"
 #include "core/StateMachineInterface.h"
+#include "server/api/StatusGet.h"
 
 #include <functional>
 #include <memory>
+#include <optional>
 
 // Forward declarations (global namespace).
 class Timers;
@@ -19,6 +21,8 @@ namespace Server {
 
 class Event;
 class EventProcessor;
+class FlightRecorder;
+class MetricsExporter;
 class WebSocketServer;
 struct QuitApplicationCommand;
 struct GetFPSCommand;
@@ -51,8 +55,38 @@ public:
     class WebSocketServer* getWebSocketServer();
     void setWebSocketServer(class WebSocketServer* server);
 
-    void updateCachedWorldData(const WorldData& data);
-    std::shared_ptr<WorldData> getCachedWorldData() const;
+    /**
+     * @brief Publish world state for readers on other threads (called once per tick).
+     *
+     * Status fields are always refreshed. The full WorldData is only copied when a reader
+     * asked for a snapshot since the last publish (or force is set), into a recycled back
+     * buffer that no reader holds, then swapped in as the new published snapshot. Requests
+     * queued by requestWorldData() are completed here, on the calling thread.
+     */
+    void updateCachedWorldData(const WorldData& data, bool force = false);
+
+    using WorldDataCallback = std::function<void(std::shared_ptr<const WorldData>)>;
+
+    /**
+     * @brief Deliver a snapshot that is at least as new as the last tick, without blocking.
+     *
+     * When the published snapshot is current the callback runs immediately on the calling
+     * thread. Otherwise it is queued and run by the physics thread right after the next
+     * publish, or with the latest (possibly older) snapshot on a state transition. The
+     * snapshot may be nullptr if nothing has been published yet. Since the callback may run
+     * on the physics thread, it must only hand the snapshot off (e.g. queue it for a worker),
+     * never serialize or send there.
+     */
+    void requestWorldData(WorldDataCallback callback) const;
+
+    /**
+     * @brief Latest published snapshot, which may be older than the last tick. Never blocks.
+     * May return nullptr if nothing has been published yet.
+     */
+    std::shared_ptr<const WorldData> getCachedWorldData() const;
+
+    // Lightweight status from the most recent publish (no cell data).
+    std::optional<Api::StatusGet::Okay> getCachedStatus() const;
 
     ScenarioRegistry& getScenarioRegistry();
     const ScenarioRegistry& getScenarioRegistry() const;
@@ -60,6 +94,12 @@ public:
     Timers& getTimers();
     const Timers& getTimers() const;
 
+    FlightRecorder& getFlightRecorder();
+    const FlightRecorder& getFlightRecorder() const;
+
+    MetricsExporter& getMetricsExporter();
+    const MetricsExporter& getMetricsExporter() const;
+
     uint32_t defaultWidth = 28;
     uint32_t defaultHeight = 28;
 
@@ -73,6 +113,11 @@ private:
      */
     void transitionTo(State::Any newState);
 
+    /**
+     * @brief Complete queued requestWorldData() callbacks with the latest snapshot.
+     */
+    void flushWorldDataRequests();
+
     /**
      * @brief Call onEnter if the state has it.
      */
@@ -3,21 +3,28 @@
 #include "ApiMacros.h"
 #include "CellGet.h"
 #include "CellSet.h"
+#include "CellsSetBulk.h"
 #include "DiagramGet.h"
 #include "Exit.h"
 #include "GravitySet.h"
+#include "MemoryStatsGet.h"
 #include "PerfStatsGet.h"
 #include "PhysicsSettingsGet.h"
 #include "PhysicsSettingsSet.h"
+#include "ProfileStart.h"
+#include "ProfileStop.h"
 #include "RenderFormatSet.h"
 #include "Reset.h"
 #include "ScenarioConfigSet.h"
 #include "SeedAdd.h"
 #include "SimRun.h"
+#include "SlowFramesGet.h"
 #include "SpawnDirtBall.h"
 #include "StateGet.h"
 #include "StatusGet.h"
 #include "TimerStatsGet.h"
+#include "TraceStart.h"
+#include "TraceStop.h"
 #include "WorldResize.h"
 #include <concepts>
 #include <nlohmann/json.hpp>
@@ -48,21 +55,28 @@ concept ApiCommandType = requires(T cmd) {
 using ApiCommand = std::variant<
     Api::CellGet::Command,
     Api::CellSet::Command,
+    Api::CellsSetBulk::Command,
     Api::DiagramGet::Command,
     Api::Exit::Command,
     Api::GravitySet::Command,
+    Api::MemoryStatsGet::Command,
     Api::PerfStatsGet::Command,
     Api::PhysicsSettingsGet::Command,
     Api::PhysicsSettingsSet::Command,
+    Api::ProfileStart::Command,
+    Api::ProfileStop::Command,
     Api::RenderFormatSet::Command,
     Api::Reset::Command,
     Api::ScenarioConfigSet::Command,
     Api::SeedAdd::Command,
     Api::SimRun::Command,
+    Api::SlowFramesGet::Command,
     Api::SpawnDirtBall::Command,
     Api::StateGet::Command,
     Api::StatusGet::Command,
     Api::TimerStatsGet::Command,
+    Api::TraceStart::Command,
+    Api::TraceStop::Command,
     Api::WorldResize::Command>;
 
 } // namespace DirtSim
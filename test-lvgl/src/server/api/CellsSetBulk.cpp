@@ -0,0 +1,162 @@
+#include "CellsSetBulk.h"
+#include "core/ReflectSerializer.h"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace DirtSim {
+namespace Api {
+namespace CellsSetBulk {
+
+namespace {
+
+constexpr char BASE64_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string encodeBase64(const std::vector<uint8_t>& bytes)
+{
+    std::string out;
+    out.reserve((bytes.size() + 2) / 3 * 4);
+
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        const size_t remaining = bytes.size() - i;
+        uint32_t triple = static_cast<uint32_t>(bytes[i]) << 16;
+        if (remaining > 1) {
+            triple |= static_cast<uint32_t>(bytes[i + 1]) << 8;
+        }
+        if (remaining > 2) {
+            triple |= bytes[i + 2];
+        }
+
+        out += BASE64_ALPHABET[(triple >> 18) & 0x3F];
+        out += BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        out += remaining > 1 ? BASE64_ALPHABET[(triple >> 6) & 0x3F] : '=';
+        out += remaining > 2 ? BASE64_ALPHABET[triple & 0x3F] : '=';
+    }
+
+    return out;
+}
+
+std::vector<uint8_t> decodeBase64(const std::string& text)
+{
+    std::array<int8_t, 256> lookup;
+    lookup.fill(-1);
+    for (int i = 0; i < 64; ++i) {
+        lookup[static_cast<uint8_t>(BASE64_ALPHABET[i])] = static_cast<int8_t>(i);
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(text.size() / 4 * 3);
+
+    uint32_t accumulator = 0;
+    int bits = 0;
+    for (const char c : text) {
+        if (c == '=') {
+            break;
+        }
+        const int8_t value = lookup[static_cast<uint8_t>(c)];
+        if (value < 0) {
+            throw std::runtime_error("CellsSetBulk: 'packed' is not valid base64");
+        }
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>((accumulator >> bits) & 0xFF));
+        }
+    }
+
+    return out;
+}
+
+} // namespace
+
+void to_json(nlohmann::json& j, const Rect& rect)
+{
+    j = ReflectSerializer::to_json(rect);
+}
+
+void from_json(const nlohmann::json& j, Rect& rect)
+{
+    rect = ReflectSerializer::from_json<Rect>(j);
+}
+
+void to_json(nlohmann::json& j, const Span& span)
+{
+    j = ReflectSerializer::to_json(span);
+}
+
+void from_json(const nlohmann::json& j, Span& span)
+{
+    span = ReflectSerializer::from_json<Span>(j);
+}
+
+void appendPackedCell(std::vector<uint8_t>& packed, const PackedCell& cell)
+{
+    uint32_t fillBits = 0;
+    std::memcpy(&fillBits, &cell.fill, sizeof(fillBits));
+
+    for (int shift = 0; shift < 32; shift += 8) {
+        packed.push_back(static_cast<uint8_t>(cell.index >> shift));
+    }
+    packed.push_back(static_cast<uint8_t>(cell.material));
+    for (int shift = 0; shift < 32; shift += 8) {
+        packed.push_back(static_cast<uint8_t>(fillBits >> shift));
+    }
+}
+
+PackedCell readPackedCell(const uint8_t* record)
+{
+    uint32_t index = 0;
+    uint32_t fillBits = 0;
+    for (int i = 0; i < 4; ++i) {
+        index |= static_cast<uint32_t>(record[i]) << (i * 8);
+        fillBits |= static_cast<uint32_t>(record[5 + i]) << (i * 8);
+    }
+
+    float fill = 0.0f;
+    std::memcpy(&fill, &fillBits, sizeof(fill));
+
+    return PackedCell{
+        .index = index,
+        .material = static_cast<MaterialType>(record[4]),
+        .fill = fill,
+    };
+}
+
+nlohmann::json Command::toJson() const
+{
+    nlohmann::json j;
+    j["rects"] = rects;
+    j["spans"] = spans;
+    j["packed"] = encodeBase64(packed);
+    return j;
+}
+
+Command Command::fromJson(const nlohmann::json& j)
+{
+    Command cmd;
+    if (j.contains("rects")) {
+        cmd.rects = j["rects"].get<std::vector<Rect>>();
+    }
+    if (j.contains("spans")) {
+        cmd.spans = j["spans"].get<std::vector<Span>>();
+    }
+    if (j.contains("packed")) {
+        // Raw bytes over MessagePack, base64 over JSON.
+        const auto& packed = j["packed"];
+        cmd.packed = packed.is_binary() ? std::vector<uint8_t>(packed.get_binary())
+                                        : decodeBase64(packed.get<std::string>());
+    }
+    return cmd;
+}
+
+nlohmann::json Okay::toJson() const
+{
+    return ReflectSerializer::to_json(*this);
+}
+
+} // namespace CellsSetBulk
+} // namespace Api
+} // namespace DirtSim
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ApiError.h"
+#include "ApiMacros.h"
+#include "core/CommandWithCallback.h"
+#include "core/MaterialType.h"
+#include "core/Result.h"
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+namespace DirtSim {
+namespace Api {
+
+namespace CellsSetBulk {
+
+DEFINE_API_NAME(CellsSetBulk);
+
+// Fills every cell in [x, x + width) × [y, y + height).
+struct Rect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    MaterialType material = MaterialType::AIR;
+    double fill = 1.0;
+};
+
+// Fills a horizontal run of length cells starting at (x, y).
+struct Span {
+    int x = 0;
+    int y = 0;
+    int length = 0;
+    MaterialType material = MaterialType::AIR;
+    double fill = 1.0;
+};
+
+void to_json(nlohmann::json& j, const Rect& rect);
+void from_json(const nlohmann::json& j, Rect& rect);
+void to_json(nlohmann::json& j, const Span& span);
+void from_json(const nlohmann::json& j, Span& span);
+
+/**
+ * Packed cell record: little-endian uint32 cell index (y * width + x), uint8
+ * MaterialType, float32 fill. The "packed" field is base64 in JSON and raw bin in
+ * MessagePack commands.
+ */
+inline constexpr size_t PACKED_RECORD_SIZE = 9;
+
+struct PackedCell {
+    uint32_t index = 0;
+    MaterialType material = MaterialType::AIR;
+    float fill = 0.0f;
+};
+
+void appendPackedCell(std::vector<uint8_t>& packed, const PackedCell& cell);
+PackedCell readPackedCell(const uint8_t* record);
+
+/**
+ * Overwrites cells in one command, applied atomically between physics steps.
+ * Edits apply rects, then spans, then packed records; later edits win.
+ */
+struct Command {
+    std::vector<Rect> rects;
+    std::vector<Span> spans;
+    std::vector<uint8_t> packed; // PACKED_RECORD_SIZE bytes per record.
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+    static Command fromJson(const nlohmann::json& j);
+};
+
+struct Okay {
+    uint32_t cells_changed = 0;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+};
+
+using Response = Result<Okay, ApiError>;
+using Cwc = CommandWithCallback<Command, Response>;
+
+} // namespace CellsSetBulk
+} // namespace Api
+} // namespace DirtSim
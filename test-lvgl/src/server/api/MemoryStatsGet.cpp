@@ -0,0 +1,35 @@
+#include "MemoryStatsGet.h"
+#include "core/ReflectSerializer.h"
+
+namespace DirtSim {
+namespace Api {
+namespace MemoryStatsGet {
+
+void to_json(nlohmann::json& j, const AllocationEntry& entry)
+{
+    j = ReflectSerializer::to_json(entry);
+}
+
+void from_json(const nlohmann::json& j, AllocationEntry& entry)
+{
+    entry = ReflectSerializer::from_json<AllocationEntry>(j);
+}
+
+nlohmann::json Command::toJson() const
+{
+    return ReflectSerializer::to_json(*this);
+}
+
+Command Command::fromJson(const nlohmann::json& j)
+{
+    return ReflectSerializer::from_json<Command>(j);
+}
+
+nlohmann::json Okay::toJson() const
+{
+    return ReflectSerializer::to_json(*this);
+}
+
+} // namespace MemoryStatsGet
+} // namespace Api
+} // namespace DirtSim
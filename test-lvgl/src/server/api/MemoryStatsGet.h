@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ApiError.h"
+#include "ApiMacros.h"
+#include "core/CommandWithCallback.h"
+#include "core/Result.h"
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace DirtSim {
+namespace Api {
+namespace MemoryStatsGet {
+
+DEFINE_API_NAME(MemoryStatsGet);
+
+struct Command {
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+    static Command fromJson(const nlohmann::json& j);
+};
+
+// Heap traffic on the physics thread (allocation-tracking builds only).
+struct AllocationEntry {
+    uint32_t calls = 0; // Timer calls or frames the counts cover.
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t frees = 0;
+    double allocations_per_call = 0.0;
+};
+
+void to_json(nlohmann::json& j, const AllocationEntry& entry);
+void from_json(const nlohmann::json& j, AllocationEntry& entry);
+
+struct Okay {
+    uint64_t resident_bytes = 0; // Whole process RSS.
+
+    // Container capacity held by each subsystem: cells, debug_info, bitmaps,
+    // neighborhoods, tree_maps.
+    std::map<std::string, uint64_t> subsystem_bytes;
+
+    // False unless the server was built with SPARKLE_DUCK_ALLOC_TRACKING; all counts are zero.
+    bool alloc_tracking = false;
+    AllocationEntry last_frame;  // The most recent tick.
+    AllocationEntry all_frames;  // Every tick since the simulation started.
+    uint32_t allocation_free_frames = 0;
+    uint64_t max_frame_allocations = 0;
+    std::map<std::string, AllocationEntry> stage_allocations; // World and server timers.
+    AllocationEntry process;                                  // All threads, since startup.
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+};
+
+using Response = Result<Okay, ApiError>;
+using Cwc = CommandWithCallback<Command, Response>;
+
+} // namespace MemoryStatsGet
+} // namespace Api
+} // namespace DirtSim
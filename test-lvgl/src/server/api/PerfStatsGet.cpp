@@ -5,6 +5,26 @@ namespace DirtSim {
 namespace Api {
 namespace PerfStatsGet {
 
+void to_json(nlohmann::json& j, const ClientEntry& entry)
+{
+    j = ReflectSerializer::to_json(entry);
+}
+
+void from_json(const nlohmann::json& j, ClientEntry& entry)
+{
+    entry = ReflectSerializer::from_json<ClientEntry>(j);
+}
+
+void to_json(nlohmann::json& j, const StageCounterEntry& entry)
+{
+    j = ReflectSerializer::to_json(entry);
+}
+
+void from_json(const nlohmann::json& j, StageCounterEntry& entry)
+{
+    entry = ReflectSerializer::from_json<StageCounterEntry>(j);
+}
+
 nlohmann::json Command::toJson() const
 {
     return ReflectSerializer::to_json(*this);
@@ -3,8 +3,13 @@
 #include "ApiError.h"
 #include "ApiMacros.h"
 #include "core/CommandWithCallback.h"
+#include "core/RenderMessage.h"
 #include "core/Result.h"
+#include <cstdint>
+#include <map>
 #include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
 
 namespace DirtSim {
 namespace Api {
@@ -18,6 +23,35 @@ struct Command {
     static Command fromJson(const nlohmann::json& j);
 };
 
+// Per-client frame delivery counters from the WebSocket server.
+struct ClientEntry {
+    uint32_t id = 0;
+    RenderFormat format = RenderFormat::BASIC;
+    uint32_t max_fps = 0;        // 0 = unlimited.
+    uint64_t buffered_bytes = 0; // Bytes queued in the client's send buffer right now.
+    uint64_t bytes_sent = 0;
+    uint64_t frames_delivered = 0;
+    uint64_t frames_skipped = 0; // Dropped by max_fps decimation or backpressure.
+};
+
+void to_json(nlohmann::json& j, const ClientEntry& entry);
+void from_json(const nlohmann::json& j, ClientEntry& entry);
+
+// Hardware counters for one World timer scope (server run with --hw-counters).
+struct StageCounterEntry {
+    uint32_t calls = 0;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_misses = 0;
+    uint64_t branch_misses = 0;
+    double ipc = 0.0;                    // Instructions per cycle.
+    double llc_misses_per_cell = 0.0;    // Per call, per grid cell.
+    double branch_misses_per_cell = 0.0; // Per call, per grid cell.
+};
+
+void to_json(nlohmann::json& j, const StageCounterEntry& entry);
+void from_json(const nlohmann::json& j, StageCounterEntry& entry);
+
 struct Okay {
     double fps = 0.0;
 
@@ -37,6 +71,12 @@ struct Okay {
     double network_send_total_ms = 0.0;
     uint32_t network_send_calls = 0;
 
+    std::vector<ClientEntry> clients;
+
+    // Events that opened; empty when hardware counters are off or unsupported.
+    std::vector<std::string> hw_counter_events;
+    std::map<std::string, StageCounterEntry> stage_counters;
+
     API_COMMAND_NAME();
     nlohmann::json toJson() const;
 };
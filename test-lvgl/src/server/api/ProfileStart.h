@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ApiError.h"
+#include "ApiMacros.h"
+#include "core/CommandWithCallback.h"
+#include "core/Result.h"
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+namespace DirtSim {
+namespace Api {
+
+namespace ProfileStart {
+
+DEFINE_API_NAME(ProfileStart);
+
+struct Command {
+    // Samples per second of consumed CPU time (0 = SamplingProfiler default).
+    uint32_t frequency_hz = 0;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+    static Command fromJson(const nlohmann::json& j);
+};
+
+struct Okay {
+    uint32_t frequency_hz = 0;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+};
+
+using Response = Result<Okay, ApiError>;
+using Cwc = CommandWithCallback<Command, Response>;
+
+} // namespace ProfileStart
+} // namespace Api
+} // namespace DirtSim
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ApiError.h"
+#include "ApiMacros.h"
+#include "core/CommandWithCallback.h"
+#include "core/Result.h"
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace DirtSim {
+namespace Api {
+
+namespace ProfileStop {
+
+DEFINE_API_NAME(ProfileStop);
+
+struct Command {
+    // Bare file name for the folded stacks, written under the server's --profile-dir.
+    // Empty = return them inline in `folded`.
+    std::string path;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+    static Command fromJson(const nlohmann::json& j);
+};
+
+struct Okay {
+    uint64_t sample_count = 0;
+    uint64_t dropped_samples = 0;
+    uint64_t stack_count = 0;
+    std::string path; // Full server-side path written (empty when returned inline).
+    std::string folded; // "thread;outer;...;inner count" lines for flamegraph.pl (when no path).
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+};
+
+using Response = Result<Okay, ApiError>;
+using Cwc = CommandWithCallback<Command, Response>;
+
+} // namespace ProfileStop
+} // namespace Api
+} // namespace DirtSim
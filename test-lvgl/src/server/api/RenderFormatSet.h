@@ -17,6 +17,7 @@ DEFINE_API_NAME(RenderFormatSet);
 
 struct Command {
     RenderFormat format;
+    uint32_t max_fps = 0; // Frame push rate cap for this client (0 = unlimited).
 
     API_COMMAND_NAME();
     nlohmann::json toJson() const;
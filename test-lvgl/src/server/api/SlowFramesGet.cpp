@@ -0,0 +1,45 @@
+#include "SlowFramesGet.h"
+#include "core/ReflectSerializer.h"
+
+namespace DirtSim {
+namespace Api {
+namespace SlowFramesGet {
+
+void to_json(nlohmann::json& j, const FrameEntry& entry)
+{
+    j = ReflectSerializer::to_json(entry);
+}
+
+void from_json(const nlohmann::json& j, FrameEntry& entry)
+{
+    entry = ReflectSerializer::from_json<FrameEntry>(j);
+}
+
+void to_json(nlohmann::json& j, const Capture& capture)
+{
+    j = ReflectSerializer::to_json(capture);
+}
+
+void from_json(const nlohmann::json& j, Capture& capture)
+{
+    capture = ReflectSerializer::from_json<Capture>(j);
+}
+
+nlohmann::json Command::toJson() const
+{
+    return ReflectSerializer::to_json(*this);
+}
+
+Command Command::fromJson(const nlohmann::json& j)
+{
+    return ReflectSerializer::from_json<Command>(j);
+}
+
+nlohmann::json Okay::toJson() const
+{
+    return ReflectSerializer::to_json(*this);
+}
+
+} // namespace SlowFramesGet
+} // namespace Api
+} // namespace DirtSim
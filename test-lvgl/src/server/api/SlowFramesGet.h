@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ApiError.h"
+#include "ApiMacros.h"
+#include "core/CommandWithCallback.h"
+#include "core/Result.h"
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace DirtSim {
+namespace Api {
+namespace SlowFramesGet {
+
+DEFINE_API_NAME(SlowFramesGet);
+
+struct Command {
+    bool clear = false; // Drop the returned captures afterwards.
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+    static Command fromJson(const nlohmann::json& j);
+};
+
+// One server tick from the flight recorder.
+struct FrameEntry {
+    uint64_t timestep = 0;
+    double frame_ms = 0.0; // Whole tick, wall clock.
+    uint32_t active_cells = 0;
+    uint32_t pending_moves = 0;
+    uint32_t blocked_transfers = 0;
+    uint32_t client_count = 0;
+    std::map<std::string, double> stage_ms; // Time spent in each stage during this tick.
+};
+
+void to_json(nlohmann::json& j, const FrameEntry& entry);
+void from_json(const nlohmann::json& j, FrameEntry& entry);
+
+// Frames surrounding a tick that exceeded the slow frame threshold.
+struct Capture {
+    uint64_t trigger_timestep = 0;
+    double trigger_frame_ms = 0.0;
+    std::string file; // Dump written on the server (empty if no dump directory is set).
+    std::vector<FrameEntry> frames;
+};
+
+void to_json(nlohmann::json& j, const Capture& capture);
+void from_json(const nlohmann::json& j, Capture& capture);
+
+struct Okay {
+    double threshold_ms = 0.0; // 0 = slow frame capture disabled.
+    std::vector<Capture> captures;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+};
+
+using Response = Result<Okay, ApiError>;
+using Cwc = CommandWithCallback<Command, Response>;
+
+} // namespace SlowFramesGet
+} // namespace Api
+} // namespace DirtSim
@@ -5,6 +5,7 @@
 #include "core/CommandWithCallback.h"
 #include "core/Result.h"
 #include "core/WorldData.h"
+#include <cstdint>
 #include <nlohmann/json.hpp>
 
 namespace DirtSim {
@@ -14,7 +15,17 @@ namespace StateGet {
 
 DEFINE_API_NAME(StateGet);
 
+/**
+ * Leading tag of a binary (zpp_bits) reply to a correlated state_get.
+ * Frame layout: uint32 BINARY_RESPONSE_MAGIC, uint64 correlation id, WorldData.
+ * Unsolicited pushes carry a bare WorldData, whose first field (width) never
+ * takes this value.
+ */
+inline constexpr uint32_t BINARY_RESPONSE_MAGIC = 0x53474231; // "SGB1".
+
 struct Command {
+    bool binary = false; // Reply with a zpp_bits frame instead of JSON.
+
     API_COMMAND_NAME();
     nlohmann::json toJson() const;
     static Command fromJson(const nlohmann::json& j);
@@ -24,6 +24,12 @@ struct TimerEntry {
     double total_ms = 0.0;
     double avg_ms = 0.0;
     uint32_t calls = 0;
+
+    // Per-call latency distribution (histogram estimates, max is exact).
+    double p50_ms = 0.0;
+    double p90_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
 };
 
 struct Okay {
@@ -0,0 +1,25 @@
+#include "TraceStart.h"
+#include "core/ReflectSerializer.h"
+
+namespace DirtSim {
+namespace Api {
+namespace TraceStart {
+
+nlohmann::json Command::toJson() const
+{
+    return ReflectSerializer::to_json(*this);
+}
+
+Command Command::fromJson(const nlohmann::json& j)
+{
+    return ReflectSerializer::from_json<Command>(j);
+}
+
+nlohmann::json Okay::toJson() const
+{
+    return ReflectSerializer::to_json(*this);
+}
+
+} // namespace TraceStart
+} // namespace Api
+} // namespace DirtSim
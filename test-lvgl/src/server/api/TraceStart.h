@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ApiError.h"
+#include "ApiMacros.h"
+#include "core/CommandWithCallback.h"
+#include "core/Result.h"
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+namespace DirtSim {
+namespace Api {
+
+namespace TraceStart {
+
+DEFINE_API_NAME(TraceStart);
+
+struct Command {
+    // Ring size in events (0 = TraceRecorder default). Oldest events are overwritten.
+    uint32_t max_events = 0;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+    static Command fromJson(const nlohmann::json& j);
+};
+
+struct Okay {
+    uint32_t capacity = 0;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+};
+
+using Response = Result<Okay, ApiError>;
+using Cwc = CommandWithCallback<Command, Response>;
+
+} // namespace TraceStart
+} // namespace Api
+} // namespace DirtSim
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ApiError.h"
+#include "ApiMacros.h"
+#include "core/CommandWithCallback.h"
+#include "core/Result.h"
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace DirtSim {
+namespace Api {
+
+namespace TraceStop {
+
+DEFINE_API_NAME(TraceStop);
+
+struct Command {
+    // Bare file name for the Chrome trace JSON, written under the server's --trace-dir.
+    // Empty = return it inline in `trace`.
+    std::string path;
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+    static Command fromJson(const nlohmann::json& j);
+};
+
+struct Okay {
+    uint64_t event_count = 0;
+    uint64_t dropped_events = 0;
+    std::string path; // Full server-side path written (empty when returned inline).
+    nlohmann::json trace; // Chrome trace-event JSON, loadable in Perfetto (when no path).
+
+    API_COMMAND_NAME();
+    nlohmann::json toJson() const;
+};
+
+using Response = Result<Okay, ApiError>;
+using Cwc = CommandWithCallback<Command, Response>;
+
+} // namespace TraceStop
+} // namespace Api
+} // namespace DirtSim
@@ -1,7 +1,11 @@
+#include "FlightRecorder.h"
+#include "MetricsExporter.h"
 #include "StateMachine.h"
 #include "core/GridOfCells.h"
+#include "core/HardwareCounters.h"
 #include "core/LoggingChannels.h"
 #include "core/Timers.h"
+#include "network/MetricsHttpServer.h"
 #include "network/WebSocketServer.h"
 #include <args.hxx>
 #include <csignal>
@@ -63,6 +67,36 @@ int main(int argc, char** argv)
         "no-openmp",
         "Disable OpenMP parallelization (for testing/debugging)",
         { "no-openmp" });
+    args::Flag hwCounters(
+        parser,
+        "hw-counters",
+        "Collect per-stage hardware counters (cycles, instructions, LLC and branch misses)",
+        { "hw-counters" });
+    args::ValueFlag<double> slowFrameMs(
+        parser,
+        "ms",
+        "Capture frames around any tick slower than this (default: off)",
+        { "slow-frame-ms" });
+    args::ValueFlag<std::string> slowFrameDir(
+        parser,
+        "dir",
+        "Directory to dump slow frame captures to as JSON (default: memory only)",
+        { "slow-frame-dir" });
+    args::ValueFlag<std::string> traceDir(
+        parser,
+        "dir",
+        "Directory trace_stop may write named trace files to (default: inline replies only)",
+        { "trace-dir" });
+    args::ValueFlag<std::string> profileDir(
+        parser,
+        "dir",
+        "Directory profile_stop may write named folded-stack files to (default: inline only)",
+        { "profile-dir" });
+    args::ValueFlag<uint16_t> metricsPort(
+        parser,
+        "port",
+        "Serve Prometheus metrics at http://127.0.0.1:<port>/metrics (default: off)",
+        { "metrics-port" });
 
     try {
         parser.ParseCLI(argc, argv);
@@ -88,6 +122,11 @@ int main(int argc, char** argv)
     GridOfCells::USE_OPENMP = !openmpDisabled;
     spdlog::info("OpenMP parallelization: {}", GridOfCells::USE_OPENMP ? "ENABLED" : "DISABLED");
 
+    // Counters are per thread, so open them here on the physics thread (and its OpenMP team).
+    if (hwCounters && !HardwareCounters::enable()) {
+        spdlog::warn("Hardware counters unavailable, continuing without them");
+    }
+
     // Initialize logging from config file (supports .local override).
     std::string configPath = logConfig ? args::get(logConfig) : "logging-config.json";
     LoggingChannels::initializeFromConfig(configPath);
@@ -111,12 +150,35 @@ int main(int argc, char** argv)
     auto stateMachine = std::make_unique<Server::StateMachine>();
     g_stateMachine = stateMachine.get();
 
+    if (slowFrameMs) {
+        Server::FlightRecorder::Config recorderConfig;
+        recorderConfig.thresholdMs = args::get(slowFrameMs);
+        recorderConfig.dumpDirectory = slowFrameDir ? args::get(slowFrameDir) : "";
+        stateMachine->getFlightRecorder().setConfig(recorderConfig);
+    }
+
+    std::unique_ptr<Server::MetricsHttpServer> metricsServer;
+    if (metricsPort) {
+        stateMachine->getMetricsExporter().setEnabled(true);
+        metricsServer = std::make_unique<Server::MetricsHttpServer>(
+            stateMachine->getMetricsExporter(), args::get(metricsPort));
+        if (!metricsServer->start()) {
+            return 1;
+        }
+    }
+
     // Set up signal handler for graceful shutdown.
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
 
     // Create WebSocket server.
     Server::WebSocketServer server(*stateMachine, port);
+    if (traceDir) {
+        server.setTraceDirectory(args::get(traceDir));
+    }
+    if (profileDir) {
+        server.setProfileDirectory(args::get(profileDir));
+    }
     server.start();
 
     // Give state machine access to server for broadcasting.
@@ -131,6 +193,9 @@ int main(int argc, char** argv)
 
     // Cleanup.
     server.stop();
+    if (metricsServer) {
+        metricsServer->stop();
+    }
     spdlog::info("Server shut down cleanly");
 
     // Print timer statistics if requested.
@@ -0,0 +1,33 @@
+#include "ClientFramePacer.h"
+
+namespace DirtSim {
+namespace Server {
+
+bool ClientFramePacer::admit(Clock::time_point now, size_t bufferedBytes, size_t maxBufferedBytes)
+{
+    if (maxFps_ > 0 && framesDelivered_ > 0) {
+        const auto minInterval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / maxFps_));
+        if (now - lastDeliveredTime_ < minInterval) {
+            framesSkipped_++;
+            return false;
+        }
+    }
+
+    // Backpressure: the client hasn't drained previous frames yet.
+    if (bufferedBytes > maxBufferedBytes) {
+        framesSkipped_++;
+        return false;
+    }
+
+    return true;
+}
+
+void ClientFramePacer::onDelivered(Clock::time_point now)
+{
+    framesDelivered_++;
+    lastDeliveredTime_ = now;
+}
+
+} // namespace Server
+} // namespace DirtSim
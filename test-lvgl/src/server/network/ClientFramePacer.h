@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace DirtSim {
+namespace Server {
+
+/**
+ * @brief Per-client frame gate shared by every broadcast path.
+ *
+ * A frame is skipped when the client's max FPS interval has not elapsed since its last
+ * delivered frame, or when its send queue holds more than the backpressure threshold.
+ * Knows nothing about sockets: the caller passes the queue depth in, so the policy can be
+ * tested without a connection.
+ */
+class ClientFramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Decide whether a frame should go out now; counts it as skipped otherwise.
+     * @param bufferedBytes Bytes still queued for this client.
+     * @param maxBufferedBytes Backpressure threshold.
+     */
+    bool admit(Clock::time_point now, size_t bufferedBytes, size_t maxBufferedBytes);
+
+    // Record a frame that was handed to the socket.
+    void onDelivered(Clock::time_point now);
+
+    void setMaxFps(uint32_t maxFps) { maxFps_ = maxFps; }
+    uint32_t maxFps() const { return maxFps_; }
+    uint64_t framesDelivered() const { return framesDelivered_; }
+    uint64_t framesSkipped() const { return framesSkipped_; }
+
+private:
+    uint32_t maxFps_ = 0; // 0 = unlimited.
+    Clock::time_point lastDeliveredTime_;
+    uint64_t framesDelivered_ = 0;
+    uint64_t framesSkipped_ = 0;
+};
+
+} // namespace Server
+} // namespace DirtSim
@@ -1,20 +1,28 @@
 #include "CommandDeserializerJson.h"
+#include "core/MsgPackAdapter.h"
 #include "server/api/CellGet.h"
 #include "server/api/CellSet.h"
+#include "server/api/CellsSetBulk.h"
 #include "server/api/DiagramGet.h"
 #include "server/api/Exit.h"
 #include "server/api/GravitySet.h"
+#include "server/api/MemoryStatsGet.h"
 #include "server/api/PerfStatsGet.h"
 #include "server/api/PhysicsSettingsGet.h"
 #include "server/api/PhysicsSettingsSet.h"
+#include "server/api/ProfileStart.h"
+#include "server/api/ProfileStop.h"
 #include "server/api/RenderFormatSet.h"
 #include "server/api/Reset.h"
 #include "server/api/ScenarioConfigSet.h"
 #include "server/api/SeedAdd.h"
 #include "server/api/SimRun.h"
+#include "server/api/SlowFramesGet.h"
 #include "server/api/SpawnDirtBall.h"
 #include "server/api/StateGet.h"
 #include "server/api/TimerStatsGet.h"
+#include "server/api/TraceStart.h"
+#include "server/api/TraceStop.h"
 #include <cctype>
 #include <spdlog/spdlog.h>
 
@@ -43,17 +51,40 @@ std::string toSnakeCase(const std::string& str)
 
 Result<ApiCommand, ApiError> CommandDeserializerJson::deserialize(const std::string& commandJson)
 {
-    // Parse JSON command.
-    nlohmann::json cmd;
+    auto parsed = parseJson(commandJson);
+    if (parsed.isError()) {
+        return Result<ApiCommand, ApiError>::error(parsed.errorValue());
+    }
+    return deserialize(parsed.value());
+}
 
+Result<nlohmann::json, ApiError> CommandDeserializerJson::parseJson(const std::string& commandJson)
+{
     try {
-        cmd = nlohmann::json::parse(commandJson);
+        return Result<nlohmann::json, ApiError>::okay(nlohmann::json::parse(commandJson));
     }
     catch (const nlohmann::json::parse_error& e) {
-        return Result<ApiCommand, ApiError>::error(
+        return Result<nlohmann::json, ApiError>::error(
             ApiError(std::string("JSON parse error: ") + e.what()));
     }
+}
+
+Result<nlohmann::json, ApiError> CommandDeserializerJson::parseMsgPack(
+    const std::vector<std::byte>& data)
+{
+    try {
+        const msgpack::object_handle handle =
+            msgpack::unpack(reinterpret_cast<const char*>(data.data()), data.size());
+        return Result<nlohmann::json, ApiError>::okay(handle.get().as<nlohmann::json>());
+    }
+    catch (const std::exception& e) {
+        return Result<nlohmann::json, ApiError>::error(
+            ApiError(std::string("MessagePack parse error: ") + e.what()));
+    }
+}
 
+Result<ApiCommand, ApiError> CommandDeserializerJson::deserialize(const nlohmann::json& cmd)
+{
     if (!cmd.is_object()) {
         return Result<ApiCommand, ApiError>::error(ApiError("Command must be a JSON object"));
     }
@@ -74,6 +105,9 @@ Result<ApiCommand, ApiError> CommandDeserializerJson::deserialize(const std::str
         else if (commandName == "cell_set") {
             return Result<ApiCommand, ApiError>::okay(Api::CellSet::Command::fromJson(cmd));
         }
+        else if (commandName == "cells_set_bulk") {
+            return Result<ApiCommand, ApiError>::okay(Api::CellsSetBulk::Command::fromJson(cmd));
+        }
         else if (commandName == "diagram_get") {
             return Result<ApiCommand, ApiError>::okay(Api::DiagramGet::Command::fromJson(cmd));
         }
@@ -83,6 +117,9 @@ Result<ApiCommand, ApiError> CommandDeserializerJson::deserialize(const std::str
         else if (commandName == "gravity_set") {
             return Result<ApiCommand, ApiError>::okay(Api::GravitySet::Command::fromJson(cmd));
         }
+        else if (commandName == "memory_stats_get") {
+            return Result<ApiCommand, ApiError>::okay(Api::MemoryStatsGet::Command::fromJson(cmd));
+        }
         else if (commandName == "perf_stats_get") {
             return Result<ApiCommand, ApiError>::okay(Api::PerfStatsGet::Command::fromJson(cmd));
         }
@@ -94,6 +131,12 @@ Result<ApiCommand, ApiError> CommandDeserializerJson::deserialize(const std::str
             return Result<ApiCommand, ApiError>::okay(
                 Api::PhysicsSettingsSet::Command::fromJson(cmd));
         }
+        else if (commandName == "profile_start") {
+            return Result<ApiCommand, ApiError>::okay(Api::ProfileStart::Command::fromJson(cmd));
+        }
+        else if (commandName == "profile_stop") {
+            return Result<ApiCommand, ApiError>::okay(Api::ProfileStop::Command::fromJson(cmd));
+        }
         else if (commandName == "render_format_set") {
             return Result<ApiCommand, ApiError>::okay(Api::RenderFormatSet::Command::fromJson(cmd));
         }
@@ -110,6 +153,9 @@ Result<ApiCommand, ApiError> CommandDeserializerJson::deserialize(const std::str
         else if (commandName == "sim_run") {
             return Result<ApiCommand, ApiError>::okay(Api::SimRun::Command::fromJson(cmd));
         }
+        else if (commandName == "slow_frames_get") {
+            return Result<ApiCommand, ApiError>::okay(Api::SlowFramesGet::Command::fromJson(cmd));
+        }
         else if (commandName == "spawn_dirt_ball") {
             return Result<ApiCommand, ApiError>::okay(Api::SpawnDirtBall::Command::fromJson(cmd));
         }
@@ -122,6 +168,12 @@ Result<ApiCommand, ApiError> CommandDeserializerJson::deserialize(const std::str
         else if (commandName == "timer_stats_get") {
             return Result<ApiCommand, ApiError>::okay(Api::TimerStatsGet::Command::fromJson(cmd));
         }
+        else if (commandName == "trace_start") {
+            return Result<ApiCommand, ApiError>::okay(Api::TraceStart::Command::fromJson(cmd));
+        }
+        else if (commandName == "trace_stop") {
+            return Result<ApiCommand, ApiError>::okay(Api::TraceStop::Command::fromJson(cmd));
+        }
         else if (commandName == "world_resize") {
             return Result<ApiCommand, ApiError>::okay(Api::WorldResize::Command::fromJson(cmd));
         }
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "server/api/ApiCommand.h"
+#include <cstddef>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
 
 namespace DirtSim {
 namespace Server {
@@ -22,6 +24,23 @@ public:
      * @return Result containing Command or error message.
      */
     Result<ApiCommand, ApiError> deserialize(const std::string& commandJson);
+
+    /**
+     * @brief Deserialize an already parsed command document into Command variant.
+     * @param cmd Command object ({"command": "...", ...params}).
+     * @return Result containing Command or error message.
+     */
+    Result<ApiCommand, ApiError> deserialize(const nlohmann::json& cmd);
+
+    /**
+     * @brief Parse a JSON command string into a document.
+     */
+    static Result<nlohmann::json, ApiError> parseJson(const std::string& commandJson);
+
+    /**
+     * @brief Parse a MessagePack command (same map layout as the JSON form) into a document.
+     */
+    static Result<nlohmann::json, ApiError> parseMsgPack(const std::vector<std::byte>& data);
 };
 
 } // namespace Server
@@ -0,0 +1,156 @@
+#include "MetricsHttpServer.h"
+#include "core/TraceRecorder.h"
+#include "server/MetricsExporter.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace DirtSim {
+namespace Server {
+
+namespace {
+
+// Poll timeout, bounding how long stop() waits for the listener thread.
+constexpr int POLL_TIMEOUT_MS = 200;
+constexpr int CLIENT_TIMEOUT_MS = 1000;
+constexpr size_t MAX_REQUEST_BYTES = 8192;
+
+void sendAll(int fd, const std::string& data)
+{
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const ssize_t sent = ::send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+}
+
+std::string response(const char* status, const char* contentType, const std::string& body)
+{
+    std::string out = "HTTP/1.1 ";
+    out += status;
+    out += "\r\nContent-Type: ";
+    out += contentType;
+    out += "\r\nContent-Length: " + std::to_string(body.size());
+    out += "\r\nConnection: close\r\n\r\n";
+    out += body;
+    return out;
+}
+
+} // namespace
+
+MetricsHttpServer::MetricsHttpServer(const MetricsExporter& exporter, uint16_t port)
+    : exporter_(exporter), port_(port)
+{}
+
+MetricsHttpServer::~MetricsHttpServer()
+{
+    stop();
+}
+
+bool MetricsHttpServer::start()
+{
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        spdlog::error("MetricsHttpServer: socket() failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    const int reuse = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port_);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0
+        || ::listen(listenFd_, 8) < 0) {
+        spdlog::error(
+            "MetricsHttpServer: Cannot listen on 127.0.0.1:{}: {}", port_, std::strerror(errno));
+        ::close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    thread_ = std::thread([this] { run(); });
+    spdlog::info("MetricsHttpServer: Serving http://127.0.0.1:{}/metrics", port_);
+    return true;
+}
+
+void MetricsHttpServer::stop()
+{
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+    }
+}
+
+void MetricsHttpServer::run()
+{
+    TraceRecorder::setThreadName("metrics");
+
+    while (running_) {
+        pollfd pfd{ .fd = listenFd_, .events = POLLIN, .revents = 0 };
+        const int ready = ::poll(&pfd, 1, POLL_TIMEOUT_MS);
+        if (ready <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+
+        const int clientFd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            continue;
+        }
+        serveClient(clientFd);
+        ::close(clientFd);
+    }
+}
+
+void MetricsHttpServer::serveClient(int fd)
+{
+    // Read until the end of the request headers (the body, if any, is ignored).
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        pollfd pfd{ .fd = fd, .events = POLLIN, .revents = 0 };
+        if (::poll(&pfd, 1, CLIENT_TIMEOUT_MS) <= 0) {
+            return;
+        }
+        const ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    const size_t lineEnd = request.find("\r\n");
+    const std::string requestLine = request.substr(0, lineEnd);
+    const bool isMetrics =
+        requestLine.rfind("GET /metrics ", 0) == 0 || requestLine.rfind("GET /metrics?", 0) == 0;
+    if (isMetrics) {
+        const std::string body = exporter_.renderPrometheus();
+        sendAll(fd, response("200 OK", "text/plain; version=0.0.4; charset=utf-8", body));
+        return;
+    }
+
+    spdlog::debug("MetricsHttpServer: 404 for '{}'", requestLine);
+    sendAll(fd, response("404 Not Found", "text/plain; charset=utf-8", "Not found\n"));
+}
+
+} // namespace Server
+} // namespace DirtSim
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace DirtSim {
+namespace Server {
+
+class MetricsExporter;
+
+/**
+ * @brief Minimal plain-HTTP listener serving GET /metrics on 127.0.0.1.
+ *
+ * Runs on its own thread and only reads the exporter's published snapshot, so a slow or
+ * stuck scraper never blocks the physics thread. One request per connection, no keep-alive.
+ */
+class MetricsHttpServer {
+public:
+    MetricsHttpServer(const MetricsExporter& exporter, uint16_t port);
+    ~MetricsHttpServer();
+
+    MetricsHttpServer(const MetricsHttpServer&) = delete;
+    MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+
+    /**
+     * @brief Bind the port and start the listener thread.
+     * @return False if the socket could not be bound (the error is logged).
+     */
+    bool start();
+
+    /**
+     * @brief Stop the listener thread and close the socket.
+     */
+    void stop();
+
+    uint16_t getPort() const { return port_; }
+
+private:
+    const MetricsExporter& exporter_;
+    uint16_t port_;
+    int listenFd_ = -1;
+    std::atomic<bool> running_{ false };
+    std::thread thread_;
+
+    void run();
+    void serveClient(int fd);
+};
+
+} // namespace Server
+} // namespace DirtSim
@@ -0,0 +1,28 @@
+#include "OutputFile.h"
+
+namespace DirtSim {
+namespace Server {
+
+Result<std::filesystem::path, ApiError> resolveOutputFile(
+    const std::string& directory, const std::string& fileName, std::string_view flag)
+{
+    using PathResult = Result<std::filesystem::path, ApiError>;
+
+    if (directory.empty()) {
+        return PathResult::error(ApiError(
+            "Server-side output is disabled; start the server with " + std::string(flag)));
+    }
+
+    const bool hasSeparator = fileName.find_first_of("/\\") != std::string::npos;
+    const bool hasNul = fileName.find('\0') != std::string::npos;
+    if (fileName.empty() || hasSeparator || hasNul || fileName.find("..") != std::string::npos
+        || fileName == ".") {
+        return PathResult::error(
+            ApiError("Invalid output file name '" + fileName + "' (bare file name required)"));
+    }
+
+    return PathResult::okay(std::filesystem::path(directory) / fileName);
+}
+
+} // namespace Server
+} // namespace DirtSim
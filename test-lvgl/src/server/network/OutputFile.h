@@ -0,0 +1,23 @@
+#pragma once
+
+#include "core/Result.h"
+#include "server/api/ApiError.h"
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace DirtSim {
+namespace Server {
+
+/**
+ * @brief Resolve a client-supplied output file name inside a directory fixed at startup.
+ *
+ * The server accepts unauthenticated connections on every interface, so a client only picks
+ * a bare file name: empty names, path separators and ".." are rejected, as is any name when
+ * no directory was configured (the error names @p flag so the operator knows what to set).
+ */
+Result<std::filesystem::path, ApiError> resolveOutputFile(
+    const std::string& directory, const std::string& fileName, std::string_view flag);
+
+} // namespace Server
+} // namespace DirtSim
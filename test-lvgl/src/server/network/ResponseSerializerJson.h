@@ -3,20 +3,28 @@
 #include "server/api/ApiCommand.h"
 #include "server/api/CellGet.h"
 #include "server/api/CellSet.h"
+#include "server/api/CellsSetBulk.h"
 #include "server/api/DiagramGet.h"
 #include "server/api/Exit.h"
 #include "server/api/GravitySet.h"
+#include "server/api/MemoryStatsGet.h"
 #include "server/api/PerfStatsGet.h"
 #include "server/api/PhysicsSettingsGet.h"
 #include "server/api/PhysicsSettingsSet.h"
+#include "server/api/ProfileStart.h"
+#include "server/api/ProfileStop.h"
 #include "server/api/Reset.h"
 #include "server/api/ScenarioConfigSet.h"
 #include "server/api/SimRun.h"
+#include "server/api/SlowFramesGet.h"
 #include "server/api/StateGet.h"
 #include "server/api/TimerStatsGet.h"
+#include "server/api/TraceStart.h"
+#include "server/api/TraceStop.h"
 #include "server/api/WorldResize.h"
 #include <nlohmann/json.hpp>
 #include <string>
+#include <utility>
 
 namespace DirtSim {
 namespace Server {
@@ -37,6 +45,18 @@ public:
      */
     template <typename Response>
     std::string serialize(Response&& response)
+    {
+        return toDocument(std::forward<Response>(response)).dump();
+    }
+
+    /**
+     * @brief Build the response document without dumping it (callers can add fields).
+     * @tparam Response The response type to serialize.
+     * @param response The response to serialize (moved).
+     * @return JSON document ({"value": ...} or {"error": ...}).
+     */
+    template <typename Response>
+    nlohmann::json toDocument(Response&& response)
     {
         nlohmann::json doc;
 
@@ -62,7 +82,7 @@ public:
             }
         }
 
-        return doc.dump();
+        return doc;
     }
 };
 
@@ -1,8 +1,11 @@
 #include "WebSocketServer.h"
+#include "OutputFile.h"
 #include "core/MsgPackAdapter.h"
 #include "core/ReflectSerializer.h"
 #include "core/RenderMessageUtils.h"
+#include "core/SamplingProfiler.h"
 #include "core/Timers.h"
+#include "core/TraceRecorder.h"
 #include "server/StateMachine.h"
 #include <cstring>
 #include <spdlog/spdlog.h>
@@ -11,6 +14,15 @@
 namespace DirtSim {
 namespace Server {
 
+namespace {
+
+// Interned once at startup so per-frame timing skips the name lookup.
+const Timers::TimerId TIMER_NETWORK_SEND = Timers::intern("network_send");
+const Timers::TimerId TIMER_SERIALIZE_WORLDDATA = Timers::intern("serialize_worlddata");
+const Timers::TimerId TIMER_STATE_GET_IMMEDIATE_TOTAL = Timers::intern("state_get_immediate_total");
+
+} // namespace
+
 WebSocketServer::WebSocketServer(DirtSim::StateMachineInterface<Event>& stateMachine, uint16_t port)
     : stateMachine_(stateMachine)
 {
@@ -23,9 +35,16 @@ WebSocketServer::WebSocketServer(DirtSim::StateMachineInterface<Event>& stateMac
     // Create server.
     server_ = std::make_unique<rtc::WebSocketServer>(config);
 
+    stateGetThread_ = std::thread([this] { runStateGetReplies(); });
+
     spdlog::info("WebSocketServer created on port {}", port);
 }
 
+WebSocketServer::~WebSocketServer()
+{
+    stop();
+}
+
 void WebSocketServer::start()
 {
     // Set up client connection handler.
@@ -36,8 +55,18 @@ void WebSocketServer::start()
 
 void WebSocketServer::stop()
 {
+    {
+        std::lock_guard<std::mutex> lock(stateGetMutex_);
+        stateGetStopping_ = true;
+    }
+    stateGetReady_.notify_one();
+    if (stateGetThread_.joinable()) {
+        stateGetThread_.join();
+    }
+
     if (server_) {
         server_->stop();
+        server_.reset();
         spdlog::info("WebSocketServer stopped");
     }
 }
@@ -49,34 +78,38 @@ uint16_t WebSocketServer::getPort() const
 
 void WebSocketServer::onClientConnected(std::shared_ptr<rtc::WebSocket> ws)
 {
-    spdlog::info("WebSocket client connected");
-
-    // Add to connected clients list.
-    connectedClients_.push_back(ws);
+    uint32_t clientId = 0;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex_);
+        clientId = nextClientId_++;
+
+        // Render format defaults to BASIC, no frame rate cap.
+        ClientState client;
+        client.id = clientId;
+        clients_[ws] = client;
+    }
 
-    // Initialize render format to BASIC (default).
-    clientRenderFormats_[ws] = RenderFormat::BASIC;
+    spdlog::info("WebSocket client {} connected", clientId);
 
     // Set up message handler for this client.
     ws->onMessage([this, ws](std::variant<rtc::binary, rtc::string> data) {
-        if (std::holds_alternative<rtc::string>(data)) {
-            std::string message = std::get<rtc::string>(data);
-            onMessage(ws, message);
-        }
-        else {
-            spdlog::warn("WebSocket received binary message (not supported)");
+        // Text frames carry JSON commands, binary frames MessagePack; both parse exactly once.
+        auto parsed = std::holds_alternative<rtc::string>(data)
+            ? CommandDeserializerJson::parseJson(std::get<rtc::string>(data))
+            : CommandDeserializerJson::parseMsgPack(std::get<rtc::binary>(data));
+        if (parsed.isError()) {
+            spdlog::error("Command parse failed: {}", parsed.errorValue().message);
+            sendError(ws, parsed.errorValue().message, std::nullopt);
+            return;
         }
+        onMessage(ws, parsed.value());
     });
 
     // Set up close handler.
-    ws->onClosed([this, ws](void) {
-        spdlog::info("WebSocket client disconnected");
-        // Remove from connected clients list.
-        connectedClients_.erase(
-            std::remove(connectedClients_.begin(), connectedClients_.end(), ws),
-            connectedClients_.end());
-        // Remove render format tracking.
-        clientRenderFormats_.erase(ws);
+    ws->onClosed([this, ws, clientId](void) {
+        spdlog::info("WebSocket client {} disconnected", clientId);
+        std::lock_guard<std::mutex> lock(clientsMutex_);
+        clients_.erase(ws);
     });
 
     // Set up error handler.
@@ -85,10 +118,19 @@ void WebSocketServer::onClientConnected(std::shared_ptr<rtc::WebSocket> ws)
 
 void WebSocketServer::broadcast(const std::string& message)
 {
-    spdlog::trace("WebSocketServer: Broadcasting to {} clients", connectedClients_.size());
+    // Copy the recipients, then send unlocked: a slow send must not block connect/close
+    // handling, which takes the same mutex on the network thread.
+    std::vector<std::shared_ptr<rtc::WebSocket>> recipients;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex_);
+        recipients.reserve(clients_.size());
+        for (const auto& [ws, client] : clients_) {
+            recipients.push_back(ws);
+        }
+    }
+    spdlog::trace("WebSocketServer: Broadcasting to {} clients", recipients.size());
 
-    // Send to all connected clients.
-    for (auto& ws : connectedClients_) {
+    for (const auto& ws : recipients) {
         if (ws && ws->isOpen()) {
             try {
                 ws->send(message);
@@ -102,53 +144,52 @@ void WebSocketServer::broadcast(const std::string& message)
 
 void WebSocketServer::broadcastBinary(const rtc::binary& data)
 {
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<Delivery> deliveries = admitClients(now);
     spdlog::trace(
         "WebSocketServer: Broadcasting binary ({} bytes) to {} clients",
         data.size(),
-        connectedClients_.size());
+        deliveries.size());
 
-    // Send to all connected clients.
-    for (auto& ws : connectedClients_) {
-        if (ws && ws->isOpen()) {
-            try {
-                ws->send(data);
-            }
-            catch (const std::exception& e) {
-                spdlog::error("WebSocketServer: Binary broadcast failed for client: {}", e.what());
-            }
+    // Send to the clients that are keeping up, without holding clientsMutex_.
+    for (Delivery& delivery : deliveries) {
+        try {
+            delivery.ws->send(data);
+            delivery.bytes = data.size();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("WebSocketServer: Binary broadcast failed for client: {}", e.what());
         }
     }
+
+    recordDeliveries(deliveries, false, now);
 }
 
-void WebSocketServer::onMessage(std::shared_ptr<rtc::WebSocket> ws, const std::string& message)
+void WebSocketServer::onMessage(std::shared_ptr<rtc::WebSocket> ws, const nlohmann::json& command)
 {
-    spdlog::info("WebSocket received command: {}", message);
+    if (spdlog::should_log(spdlog::level::trace)) {
+        spdlog::trace("WebSocket received command: {}", command.dump());
+    }
 
     // Extract correlation ID from request (optional field).
     std::optional<uint64_t> correlationId;
-    try {
-        nlohmann::json json = nlohmann::json::parse(message);
-        if (json.contains("id") && json["id"].is_number()) {
-            correlationId = json["id"].get<uint64_t>();
-        }
-    }
-    catch (const std::exception& e) {
-        spdlog::error("Failed to parse correlation ID: {}", e.what());
+    if (command.is_object() && command.contains("id") && command["id"].is_number_unsigned()) {
+        correlationId = command["id"].get<uint64_t>();
     }
 
-    // Deserialize JSON → Command.
-    auto cmdResult = deserializer_.deserialize(message);
+    // Document → Command.
+    auto cmdResult = deserializer_.deserialize(command);
     if (cmdResult.isError()) {
         spdlog::error("Command deserialization failed: {}", cmdResult.errorValue().message);
         // Send error response back immediately.
-        std::string errorJson = R"({"error": ")" + cmdResult.errorValue().message + R"("})";
-        ws->send(errorJson);
+        sendError(ws, cmdResult.errorValue().message, correlationId);
         return;
     }
 
     // Some commands are handled immediately, by the websocket thread.
     if (std::holds_alternative<Api::StateGet::Command>(cmdResult.value())) {
-        handleStateGetImmediate(ws, correlationId);
+        handleStateGetImmediate(
+            ws, std::get<Api::StateGet::Command>(cmdResult.value()), correlationId);
         return;
     }
 
@@ -163,11 +204,50 @@ void WebSocketServer::onMessage(std::shared_ptr<rtc::WebSocket> ws, const std::s
         return;
     }
 
+    // Tracing and profiling must work in every state and must not wait behind a busy
+    // physics queue.
+    if (std::holds_alternative<Api::ProfileStart::Command>(cmdResult.value())) {
+        handleProfileStartImmediate(
+            ws, std::get<Api::ProfileStart::Command>(cmdResult.value()), correlationId);
+        return;
+    }
+
+    if (std::holds_alternative<Api::ProfileStop::Command>(cmdResult.value())) {
+        handleProfileStopImmediate(
+            ws, std::get<Api::ProfileStop::Command>(cmdResult.value()), correlationId);
+        return;
+    }
+
+    if (std::holds_alternative<Api::TraceStart::Command>(cmdResult.value())) {
+        handleTraceStartImmediate(
+            ws, std::get<Api::TraceStart::Command>(cmdResult.value()), correlationId);
+        return;
+    }
+
+    if (std::holds_alternative<Api::TraceStop::Command>(cmdResult.value())) {
+        handleTraceStopImmediate(
+            ws, std::get<Api::TraceStop::Command>(cmdResult.value()), correlationId);
+        return;
+    }
+
     // Others are queued for processing in FIFO order.
     Event cwcEvent = createCwcForCommand(cmdResult.value(), ws, correlationId);
     stateMachine_.queueEvent(cwcEvent);
 }
 
+void WebSocketServer::sendError(
+    const std::shared_ptr<rtc::WebSocket>& ws,
+    const std::string& message,
+    std::optional<uint64_t> correlationId)
+{
+    nlohmann::json response;
+    response["error"] = message;
+    if (correlationId.has_value()) {
+        response["id"] = correlationId.value();
+    }
+    ws->send(response.dump());
+}
+
 // =============================================================================
 // GENERIC CWC CREATION HELPERS
 // =============================================================================
@@ -191,21 +271,28 @@ struct ApiInfo;
 // Compile-time error if a command is added to ApiCommand variant but not listed here.
 REGISTER_API_NAMESPACE(CellGet)
 REGISTER_API_NAMESPACE(CellSet)
+REGISTER_API_NAMESPACE(CellsSetBulk)
 REGISTER_API_NAMESPACE(DiagramGet)
 REGISTER_API_NAMESPACE(Exit)
 REGISTER_API_NAMESPACE(GravitySet)
+REGISTER_API_NAMESPACE(MemoryStatsGet)
 REGISTER_API_NAMESPACE(PerfStatsGet)
 REGISTER_API_NAMESPACE(PhysicsSettingsGet)
 REGISTER_API_NAMESPACE(PhysicsSettingsSet)
+REGISTER_API_NAMESPACE(ProfileStart)
+REGISTER_API_NAMESPACE(ProfileStop)
 REGISTER_API_NAMESPACE(RenderFormatSet)
 REGISTER_API_NAMESPACE(Reset)
 REGISTER_API_NAMESPACE(ScenarioConfigSet)
 REGISTER_API_NAMESPACE(SeedAdd)
 REGISTER_API_NAMESPACE(SimRun)
+REGISTER_API_NAMESPACE(SlowFramesGet)
 REGISTER_API_NAMESPACE(SpawnDirtBall)
 REGISTER_API_NAMESPACE(StateGet)
 REGISTER_API_NAMESPACE(StatusGet)
 REGISTER_API_NAMESPACE(TimerStatsGet)
+REGISTER_API_NAMESPACE(TraceStart)
+REGISTER_API_NAMESPACE(TraceStop)
 REGISTER_API_NAMESPACE(WorldResize)
 
 #undef REGISTER_API_NAMESPACE
@@ -221,27 +308,63 @@ auto makeStandardCwc(
     typename Info::CwcType cwc;
     cwc.command = cmd;
     cwc.callback = [self, ws, correlationId](typename Info::ResponseType&& response) {
-        std::string jsonResponse = self->serializer_.serialize(std::move(response));
-
-        // Inject correlation ID if present.
+        nlohmann::json doc = self->serializer_.toDocument(std::move(response));
         if (correlationId.has_value()) {
-            try {
-                nlohmann::json json = nlohmann::json::parse(jsonResponse);
-                json["id"] = correlationId.value();
-                jsonResponse = json.dump();
-            }
-            catch (const std::exception& e) {
-                spdlog::error("Failed to inject correlation ID: {}", e.what());
-            }
+            doc["id"] = correlationId.value();
         }
+        std::string jsonResponse = doc.dump();
 
-        spdlog::info("{}: Sending response ({} bytes)", Info::name, jsonResponse.size());
+        spdlog::debug("{}: Sending response ({} bytes)", Info::name, jsonResponse.size());
         ws->send(jsonResponse);
     };
     return cwc;
 }
 
-// Specialization for StateGet: binary serialization with zpp_bits.
+// Rough per-element JSON sizes, used to size the state_get buffer once up front.
+constexpr size_t STATE_GET_JSON_BYTES_PER_CELL = 512;
+constexpr size_t STATE_GET_JSON_BYTES_PER_DEBUG = 384;
+
+// Streams a state_get reply straight into the outgoing buffer (no nlohmann DOM).
+std::string makeStateGetJson(const WorldData& data, std::optional<uint64_t> correlationId)
+{
+    std::string out;
+    out.reserve(
+        data.cells.size() * STATE_GET_JSON_BYTES_PER_CELL
+        + data.debug_info.size() * STATE_GET_JSON_BYTES_PER_DEBUG + 1024);
+
+    out += '{';
+    if (correlationId.has_value()) {
+        out += "\"id\":";
+        ReflectSerializer::write_json(out, correlationId.value());
+        out += ',';
+    }
+    out += "\"response_type\":";
+    ReflectSerializer::write_json(out, DirtSim::Api::StateGet::Okay::name());
+    out += ",\"value\":";
+    ReflectSerializer::write_json(out, data);
+    out += '}';
+    return out;
+}
+
+// Binary state_get reply: magic, correlation ID, then WorldData (see StateGet.h).
+rtc::binary makeStateGetBinary(const WorldData& data, uint64_t correlationId)
+{
+    rtc::binary bytes;
+    zpp::bits::out out(bytes);
+    out(DirtSim::Api::StateGet::BINARY_RESPONSE_MAGIC, correlationId, data).or_throw();
+    return bytes;
+}
+
+// Unsolicited WorldData push (no ID).
+rtc::binary makeWorldDataPush(const WorldData& data)
+{
+    rtc::binary bytes;
+    zpp::bits::out out(bytes);
+    out(data).or_throw();
+    return bytes;
+}
+
+// Specialization for StateGet: streamed JSON or zpp_bits binary.
 template <>
 auto makeStandardCwc<ApiInfo<DirtSim::Api::StateGet::Command>>(
     WebSocketServer* self,
@@ -251,79 +374,26 @@ auto makeStandardCwc<ApiInfo<DirtSim::Api::StateGet::Command>>(
 {
     DirtSim::Api::StateGet::Cwc cwc;
     cwc.command = cmd;
-    cwc.callback = [self, ws, correlationId](DirtSim::Api::StateGet::Response&& response) {
-        // Get timers for instrumentation.
-        auto& dsm = static_cast<StateMachine&>(self->stateMachine_);
-        auto& timers = dsm.getTimers();
-
+    cwc.callback = [self, ws, cmd, correlationId](DirtSim::Api::StateGet::Response&& response) {
         if (response.isError()) {
             // Send errors as JSON.
-            std::string jsonResponse = self->serializer_.serialize(std::move(response));
-
-            // Inject correlation ID if present.
+            nlohmann::json doc = self->serializer_.toDocument(std::move(response));
             if (correlationId.has_value()) {
-                try {
-                    nlohmann::json json = nlohmann::json::parse(jsonResponse);
-                    json["id"] = correlationId.value();
-                    jsonResponse = json.dump();
-                }
-                catch (const std::exception& e) {
-                    spdlog::error("Failed to inject correlation ID: {}", e.what());
-                }
+                doc["id"] = correlationId.value();
             }
+            std::string jsonResponse = doc.dump();
 
             spdlog::info("StateGet: Sending error response ({} bytes)", jsonResponse.size());
-            timers.startTimer("network_send");
             ws->send(jsonResponse);
-            timers.stopTimer("network_send");
+            return;
         }
-        else {
-            // Check if this is a correlated request (needs JSON) or unsolicited push (binary).
-            if (correlationId.has_value()) {
-                // Explicit state_get with correlation ID - send as JSON with ID.
-                timers.startTimer("serialize_worlddata");
-                std::string jsonResponse = self->serializer_.serialize(std::move(response));
-                timers.stopTimer("serialize_worlddata");
-
-                // Inject correlation ID.
-                try {
-                    nlohmann::json json = nlohmann::json::parse(jsonResponse);
-                    json["id"] = correlationId.value();
-                    jsonResponse = json.dump();
-                }
-                catch (const std::exception& e) {
-                    spdlog::error("Failed to inject correlation ID: {}", e.what());
-                }
-
-                spdlog::debug(
-                    "StateGet: Sending JSON response with ID {} ({} bytes)",
-                    correlationId.value(),
-                    jsonResponse.size());
-
-                timers.startTimer("network_send");
-                ws->send(jsonResponse);
-                timers.stopTimer("network_send");
-            }
-            else {
-                // Unsolicited push - send as binary (no ID).
-                timers.startTimer("serialize_worlddata");
-
-                std::vector<std::byte> data;
-                zpp::bits::out out(data);
-                out(response.value().worldData).or_throw();
-
-                timers.stopTimer("serialize_worlddata");
-
-                // Convert to rtc::binary.
-                rtc::binary binaryMsg(data.begin(), data.end());
 
-                spdlog::debug("StateGet: Sending binary push ({} bytes)", data.size());
-
-                timers.startTimer("network_send");
-                ws->send(binaryMsg);
-                timers.stopTimer("network_send");
-            }
-        }
+        // Runs on the physics thread: hand the data to the reply thread to serialize.
+        self->queueStateGetReply(
+            ws,
+            cmd,
+            correlationId,
+            std::make_shared<const WorldData>(std::move(response).value().worldData));
     };
     return cwc;
 }
@@ -348,127 +418,142 @@ Event WebSocketServer::createCwcForCommand(
 }
 
 void WebSocketServer::handleStateGetImmediate(
-    std::shared_ptr<rtc::WebSocket> ws, std::optional<uint64_t> correlationId)
+    std::shared_ptr<rtc::WebSocket> ws,
+    const Api::StateGet::Command& cmd,
+    std::optional<uint64_t> correlationId)
 {
     // Cast to concrete StateMachine type to access cached WorldData.
     auto& dsm = static_cast<StateMachine&>(stateMachine_);
-    auto& timers = dsm.getTimers();
 
-    // Track total server processing time.
-    timers.startTimer("state_get_immediate_total");
+    // The snapshot arrives at once when the published one is current, otherwise from the
+    // physics thread right after its next publish. Either way the callback only queues the
+    // reply: serialization and sending happen on the reply thread.
+    dsm.requestWorldData([this, ws, cmd, correlationId](std::shared_ptr<const WorldData> data) {
+        queueStateGetReply(ws, cmd, correlationId, std::move(data));
+    });
+}
 
-    // Get cached WorldData (already updated by physics thread).
-    auto cachedPtr = dsm.getCachedWorldData();
-    if (!cachedPtr) {
-        spdlog::warn("WebSocketServer: state_get immediate - no cached data available");
-        std::string errorJson = R"({"error": "No world data available"})";
+void WebSocketServer::queueStateGetReply(
+    std::shared_ptr<rtc::WebSocket> ws,
+    const Api::StateGet::Command& cmd,
+    std::optional<uint64_t> correlationId,
+    std::shared_ptr<const WorldData> data)
+{
+    {
+        std::lock_guard<std::mutex> lock(stateGetMutex_);
+        if (stateGetStopping_) {
+            return;
+        }
+        stateGetQueue_.push_back(StateGetReply{
+            .ws = std::move(ws),
+            .cmd = cmd,
+            .correlationId = correlationId,
+            .data = std::move(data),
+        });
+    }
+    stateGetReady_.notify_one();
+}
 
-        // Inject correlation ID if present.
-        if (correlationId.has_value()) {
-            try {
-                nlohmann::json json = nlohmann::json::parse(errorJson);
-                json["id"] = correlationId.value();
-                errorJson = json.dump();
-            }
-            catch (...) {
+void WebSocketServer::runStateGetReplies()
+{
+    while (true) {
+        StateGetReply reply;
+        {
+            std::unique_lock<std::mutex> lock(stateGetMutex_);
+            stateGetReady_.wait(
+                lock, [this] { return stateGetStopping_ || !stateGetQueue_.empty(); });
+            if (stateGetStopping_) {
+                return;
             }
+            reply = std::move(stateGetQueue_.front());
+            stateGetQueue_.pop_front();
         }
 
-        ws->send(errorJson);
-        timers.stopTimer("state_get_immediate_total");
-        return;
+        startStateGetTimer(TIMER_STATE_GET_IMMEDIATE_TOTAL);
+        sendStateGet(reply.ws, reply.cmd, reply.correlationId, reply.data.get());
+        stopStateGetTimer(TIMER_STATE_GET_IMMEDIATE_TOTAL);
     }
+}
 
-    // Check if this is a correlated request or unsolicited push.
-    if (correlationId.has_value()) {
-        // Explicit state_get with ID - send as JSON.
-        spdlog::debug("StateGet: Handling correlated request (ID {})", correlationId.value());
-        timers.startTimer("serialize_worlddata");
+Timers WebSocketServer::getStateGetTimers() const
+{
+    std::lock_guard<std::mutex> lock(stateGetTimersMutex_);
+    return stateGetTimers_;
+}
 
-        try {
-            // Serialize WorldData to JSON.
-            nlohmann::json doc;
-            doc["value"] = ReflectSerializer::to_json(*cachedPtr);
-            doc["id"] = correlationId.value();
-            std::string jsonResponse = doc.dump();
+void WebSocketServer::startStateGetTimer(Timers::TimerId id)
+{
+    std::lock_guard<std::mutex> lock(stateGetTimersMutex_);
+    stateGetTimers_.startTimer(id);
+}
 
-            timers.stopTimer("serialize_worlddata");
+void WebSocketServer::stopStateGetTimer(Timers::TimerId id)
+{
+    std::lock_guard<std::mutex> lock(stateGetTimersMutex_);
+    stateGetTimers_.stopTimer(id);
+}
 
-            spdlog::debug(
-                "StateGet: Sending JSON response with ID {} ({} bytes)",
-                correlationId.value(),
-                jsonResponse.size());
+void WebSocketServer::sendStateGet(
+    const std::shared_ptr<rtc::WebSocket>& ws,
+    const Api::StateGet::Command& cmd,
+    std::optional<uint64_t> correlationId,
+    const WorldData* data)
+{
+    if (!data) {
+        spdlog::warn("WebSocketServer: state_get immediate - no cached data available");
+        sendError(ws, "No world data available", correlationId);
+        return;
+    }
 
-            timers.startTimer("network_send");
-            ws->send(jsonResponse);
-            timers.stopTimer("network_send");
+    // Correlated requests get JSON (or binary when asked), unsolicited ones a binary push.
+    startStateGetTimer(TIMER_SERIALIZE_WORLDDATA);
+    rtc::message_variant message;
+    try {
+        if (!correlationId.has_value()) {
+            message = makeWorldDataPush(*data);
         }
-        catch (const std::exception& e) {
-            spdlog::error("StateGet: Failed to serialize JSON response: {}", e.what());
-            timers.stopTimer("serialize_worlddata");
+        else if (cmd.binary) {
+            message = makeStateGetBinary(*data, correlationId.value());
+        }
+        else {
+            message = makeStateGetJson(*data, correlationId);
         }
     }
-    else {
-        // Unsolicited push - send as binary (more efficient).
-        timers.startTimer("serialize_worlddata");
-
-        std::vector<std::byte> data;
-        zpp::bits::out out(data);
-        out(*cachedPtr).or_throw();
-
-        timers.stopTimer("serialize_worlddata");
-
-        // Convert to rtc::binary.
-        rtc::binary binaryMsg(data.begin(), data.end());
-
-        spdlog::debug("StateGet: Sending binary push ({} bytes)", data.size());
-
-        // Send immediately.
-        timers.startTimer("network_send");
-        ws->send(binaryMsg);
-        timers.stopTimer("network_send");
+    catch (const std::exception& e) {
+        spdlog::error("StateGet: Failed to serialize response: {}", e.what());
+        stopStateGetTimer(TIMER_SERIALIZE_WORLDDATA);
+        return;
     }
+    stopStateGetTimer(TIMER_SERIALIZE_WORLDDATA);
+
+    spdlog::debug(
+        "StateGet: Sending {} response ({} bytes)",
+        std::holds_alternative<rtc::binary>(message) ? "binary" : "JSON",
+        std::visit([](const auto& m) { return m.size(); }, message));
 
-    timers.stopTimer("state_get_immediate_total");
+    // Moved into the send queue; the buffer is not copied again.
+    startStateGetTimer(TIMER_NETWORK_SEND);
+    ws->send(std::move(message));
+    stopStateGetTimer(TIMER_NETWORK_SEND);
 }
 
 void WebSocketServer::handleStatusGetImmediate(
     std::shared_ptr<rtc::WebSocket> ws, std::optional<uint64_t> correlationId)
 {
-    // Cast to concrete StateMachine type to access cached WorldData.
+    // Cast to concrete StateMachine type to access cached status.
     auto& dsm = static_cast<StateMachine&>(stateMachine_);
 
-    // Get cached WorldData (already updated by physics thread).
-    auto cachedPtr = dsm.getCachedWorldData();
-    if (!cachedPtr) {
+    // Status is refreshed by the physics thread every tick (no cell data copied).
+    const auto status = dsm.getCachedStatus();
+    if (!status) {
         spdlog::warn("WebSocketServer: status_get immediate - no cached data available");
-        std::string errorJson = R"({"error": "No world data available"})";
-
-        // Inject correlation ID if present.
-        if (correlationId.has_value()) {
-            try {
-                nlohmann::json json = nlohmann::json::parse(errorJson);
-                json["id"] = correlationId.value();
-                errorJson = json.dump();
-            }
-            catch (...) {
-            }
-        }
-
-        ws->send(errorJson);
+        sendError(ws, "No world data available", correlationId);
         return;
     }
 
-    // Build lightweight status from cached data.
-    Api::StatusGet::Okay status;
-    status.timestep = cachedPtr->timestep;
-    status.scenario_id = cachedPtr->scenario_id;
-    status.width = cachedPtr->width;
-    status.height = cachedPtr->height;
-
     // Serialize to JSON.
     nlohmann::json response;
-    response["value"] = ReflectSerializer::to_json(status);
+    response["value"] = ReflectSerializer::to_json(*status);
 
     // Inject correlation ID if present.
     if (correlationId.has_value()) {
@@ -477,7 +562,7 @@ void WebSocketServer::handleStatusGetImmediate(
 
     std::string jsonResponse = response.dump();
 
-    spdlog::info("StatusGet: Sending response ({} bytes)", jsonResponse.size());
+    spdlog::debug("StatusGet: Sending response ({} bytes)", jsonResponse.size());
     ws->send(jsonResponse);
 }
 
@@ -490,8 +575,9 @@ void WebSocketServer::handleRenderFormatSetImmediate(
         "RenderFormatSet: Setting format to {}",
         cmd.format == RenderFormat::BASIC ? "BASIC" : "DEBUG");
 
-    // Set the render format for this client.
+    // Set the render format and frame rate cap for this client.
     setClientRenderFormat(ws, cmd.format);
+    setClientMaxFps(ws, cmd.max_fps);
 
     // Create success response.
     Api::RenderFormatSet::Okay okay;
@@ -512,63 +598,338 @@ void WebSocketServer::handleRenderFormatSetImmediate(
 
     std::string jsonResponse = responseJson.dump();
 
-    spdlog::info("RenderFormatSet: Sending response ({} bytes)", jsonResponse.size());
+    spdlog::debug("RenderFormatSet: Sending response ({} bytes)", jsonResponse.size());
     ws->send(jsonResponse);
 }
 
-void WebSocketServer::broadcastRenderMessage(const WorldData& data)
+void WebSocketServer::handleProfileStartImmediate(
+    std::shared_ptr<rtc::WebSocket> ws,
+    const Api::ProfileStart::Command& cmd,
+    std::optional<uint64_t> correlationId)
 {
-    spdlog::trace(
-        "WebSocketServer: Broadcasting RenderMessage to {} clients", connectedClients_.size());
+    TraceRecorder::setThreadName("network");
 
-    // Pack and send to each client with their requested format.
-    for (auto& ws : connectedClients_) {
-        if (ws && ws->isOpen()) {
-            try {
-                // Get client's render format (defaults to BASIC).
-                RenderFormat format = getClientRenderFormat(ws);
+    const uint32_t frequency =
+        cmd.frequency_hz > 0 ? cmd.frequency_hz : SamplingProfiler::DEFAULT_FREQUENCY_HZ;
+    Api::ProfileStart::Response response;
+    if (SamplingProfiler::isRunning()) {
+        response = Api::ProfileStart::Response::error(ApiError("Profiler already running"));
+    }
+    else if (SamplingProfiler::start(frequency)) {
+        response =
+            Api::ProfileStart::Response::okay({ .frequency_hz = SamplingProfiler::frequency() });
+    }
+    else {
+        response = Api::ProfileStart::Response::error(ApiError("Failed to start profiler"));
+    }
+
+    nlohmann::json doc = serializer_.toDocument(std::move(response));
+    if (correlationId.has_value()) {
+        doc["id"] = correlationId.value();
+    }
+    ws->send(doc.dump());
+}
+
+void WebSocketServer::handleProfileStopImmediate(
+    std::shared_ptr<rtc::WebSocket> ws,
+    const Api::ProfileStop::Command& cmd,
+    std::optional<uint64_t> correlationId)
+{
+    Api::ProfileStop::Response response;
+    if (!SamplingProfiler::isRunning()) {
+        response = Api::ProfileStop::Response::error(ApiError("Profiler is not running"));
+    }
+    else {
+        const SamplingProfiler::Summary summary = SamplingProfiler::stop();
+        Api::ProfileStop::Okay okay{
+            .sample_count = summary.samples,
+            .dropped_samples = summary.dropped,
+            .stack_count = summary.stacks,
+            .path = "",
+            .folded = {},
+        };
+
+        if (cmd.path.empty()) {
+            okay.folded = SamplingProfiler::exportFolded();
+            response = Api::ProfileStop::Response::okay(std::move(okay));
+        }
+        else if (auto file = resolveOutputFile(profileDirectory_, cmd.path, "--profile-dir");
+                 file.isError()) {
+            spdlog::warn("ProfileStop: {}", file.errorValue().message);
+            response = Api::ProfileStop::Response::error(file.errorValue());
+        }
+        else if (SamplingProfiler::writeFolded(file.value().string())) {
+            okay.path = file.value().string();
+            spdlog::info("ProfileStop: Wrote folded stacks to {}", okay.path);
+            response = Api::ProfileStop::Response::okay(std::move(okay));
+        }
+        else {
+            response = Api::ProfileStop::Response::error(
+                ApiError("Failed to write profile to " + file.value().string()));
+        }
+    }
 
-                // Pack WorldData into RenderMessage with client's format.
-                RenderMessage msg = RenderMessageUtils::packRenderMessage(data, format);
+    nlohmann::json doc = serializer_.toDocument(std::move(response));
+    if (correlationId.has_value()) {
+        doc["id"] = correlationId.value();
+    }
+    ws->send(doc.dump());
+}
 
-                // Serialize to binary using zpp_bits.
-                std::vector<std::byte> msgData;
-                zpp::bits::out out(msgData);
-                out(msg).or_throw();
+void WebSocketServer::handleTraceStartImmediate(
+    std::shared_ptr<rtc::WebSocket> ws,
+    const Api::TraceStart::Command& cmd,
+    std::optional<uint64_t> correlationId)
+{
+    TraceRecorder::setThreadName("network");
 
-                // Send binary message.
-                rtc::binary binaryMsg(msgData.begin(), msgData.end());
-                ws->send(binaryMsg);
+    const size_t capacity = cmd.max_events > 0 ? cmd.max_events : TraceRecorder::DEFAULT_CAPACITY;
+    Api::TraceStart::Response response;
+    if (TraceRecorder::start(capacity)) {
+        response = Api::TraceStart::Response::okay(
+            { .capacity = static_cast<uint32_t>(TraceRecorder::capacity()) });
+    }
+    else {
+        response = Api::TraceStart::Response::error(ApiError("Trace recording already active"));
+    }
 
-                spdlog::trace(
-                    "WebSocketServer: Sent RenderMessage ({} bytes, format={}) to client",
-                    msgData.size(),
-                    static_cast<int>(format));
-            }
-            catch (const std::exception& e) {
-                spdlog::error(
-                    "WebSocketServer: RenderMessage broadcast failed for client: {}", e.what());
-            }
+    nlohmann::json doc = serializer_.toDocument(std::move(response));
+    if (correlationId.has_value()) {
+        doc["id"] = correlationId.value();
+    }
+    ws->send(doc.dump());
+}
+
+void WebSocketServer::handleTraceStopImmediate(
+    std::shared_ptr<rtc::WebSocket> ws,
+    const Api::TraceStop::Command& cmd,
+    std::optional<uint64_t> correlationId)
+{
+    Api::TraceStop::Response response;
+    if (!TraceRecorder::isRecording()) {
+        response = Api::TraceStop::Response::error(ApiError("Trace recording is not active"));
+    }
+    else {
+        const TraceRecorder::Summary summary = TraceRecorder::stop();
+        Api::TraceStop::Okay okay{
+            .event_count = summary.recorded - summary.dropped,
+            .dropped_events = summary.dropped,
+            .path = "",
+            .trace = nullptr,
+        };
+
+        if (cmd.path.empty()) {
+            okay.trace = TraceRecorder::exportChromeTrace();
+            response = Api::TraceStop::Response::okay(std::move(okay));
+        }
+        else if (auto file = resolveOutputFile(traceDirectory_, cmd.path, "--trace-dir");
+                 file.isError()) {
+            spdlog::warn("TraceStop: {}", file.errorValue().message);
+            response = Api::TraceStop::Response::error(file.errorValue());
+        }
+        else if (TraceRecorder::writeChromeTrace(file.value().string())) {
+            okay.path = file.value().string();
+            spdlog::info("TraceStop: Wrote trace to {}", okay.path);
+            response = Api::TraceStop::Response::okay(std::move(okay));
+        }
+        else {
+            response = Api::TraceStop::Response::error(
+                ApiError("Failed to write trace to " + file.value().string()));
         }
     }
+
+    nlohmann::json doc = serializer_.toDocument(std::move(response));
+    if (correlationId.has_value()) {
+        doc["id"] = correlationId.value();
+    }
+    ws->send(doc.dump());
+}
+
+void WebSocketServer::setTraceDirectory(const std::string& directory)
+{
+    traceDirectory_ = directory;
+}
+
+void WebSocketServer::setProfileDirectory(const std::string& directory)
+{
+    profileDirectory_ = directory;
+}
+
+std::vector<WebSocketServer::Delivery> WebSocketServer::admitClients(
+    std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    std::vector<Delivery> deliveries;
+    deliveries.reserve(clients_.size());
+    for (auto& [ws, client] : clients_) {
+        if (!ws || !ws->isOpen()) {
+            continue;
+        }
+
+        const size_t buffered = ws->bufferedAmount();
+        if (!client.pacer.admit(now, buffered, maxBufferedBytes_)) {
+            totals_.framesSkipped++;
+            spdlog::trace(
+                "WebSocketServer: Skipping frame for client {} ({} bytes queued)",
+                client.id,
+                buffered);
+            continue;
+        }
+        deliveries.push_back(Delivery{ .ws = ws, .clientId = client.id, .format = client.format });
+    }
+    return deliveries;
+}
+
+void WebSocketServer::recordDeliveries(
+    const std::vector<Delivery>& deliveries, bool render, std::chrono::steady_clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    for (const Delivery& delivery : deliveries) {
+        if (delivery.bytes == 0) {
+            continue;
+        }
+
+        if (render) {
+            const auto formatIndex = static_cast<size_t>(delivery.format);
+            totals_.renderBytesSent[formatIndex] += delivery.bytes;
+            totals_.renderFramesDelivered[formatIndex]++;
+        }
+        else {
+            totals_.binaryBytesSent += delivery.bytes;
+        }
+
+        // The client may have disconnected while the frame was being sent.
+        auto it = clients_.find(delivery.ws);
+        if (it != clients_.end()) {
+            it->second.bytesSent += delivery.bytes;
+            it->second.pacer.onDelivered(now);
+        }
+    }
+}
+
+void WebSocketServer::broadcastRenderMessage(const WorldData& data)
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<Delivery> deliveries = admitClients(now);
+    spdlog::trace("WebSocketServer: Broadcasting RenderMessage to {} clients", deliveries.size());
+
+    // Packed lazily, at most once per format per frame, outside clientsMutex_.
+    std::optional<rtc::binary> packedBasic;
+    std::optional<rtc::binary> packedDebug;
+    auto getPacked = [&](RenderFormat format) -> const rtc::binary& {
+        auto& slot = format == RenderFormat::DEBUG ? packedDebug : packedBasic;
+        if (!slot) {
+            RenderMessage msg = RenderMessageUtils::packRenderMessage(data, format);
+
+            // Serialize to binary using zpp_bits.
+            std::vector<std::byte> msgData;
+            zpp::bits::out out(msgData);
+            out(msg).or_throw();
+            slot.emplace(msgData.begin(), msgData.end());
+        }
+        return *slot;
+    };
+
+    for (Delivery& delivery : deliveries) {
+        try {
+            const rtc::binary& binaryMsg = getPacked(delivery.format);
+            delivery.ws->send(binaryMsg);
+            delivery.bytes = binaryMsg.size();
+
+            spdlog::trace(
+                "WebSocketServer: Sent RenderMessage ({} bytes, format={}) to client {}",
+                binaryMsg.size(),
+                static_cast<int>(delivery.format),
+                delivery.clientId);
+        }
+        catch (const std::exception& e) {
+            spdlog::error(
+                "WebSocketServer: RenderMessage broadcast failed for client {}: {}",
+                delivery.clientId,
+                e.what());
+        }
+    }
+
+    recordDeliveries(deliveries, true, now);
 }
 
 void WebSocketServer::setClientRenderFormat(std::shared_ptr<rtc::WebSocket> ws, RenderFormat format)
 {
-    clientRenderFormats_[ws] = format;
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    auto it = clients_.find(ws);
+    if (it == clients_.end()) {
+        return;
+    }
+    it->second.format = format;
     spdlog::info(
-        "WebSocketServer: Client render format set to {}",
+        "WebSocketServer: Client {} render format set to {}",
+        it->second.id,
         format == RenderFormat::BASIC ? "BASIC" : "DEBUG");
 }
 
 RenderFormat WebSocketServer::getClientRenderFormat(std::shared_ptr<rtc::WebSocket> ws) const
 {
-    auto it = clientRenderFormats_.find(ws);
-    if (it != clientRenderFormats_.end()) {
-        return it->second;
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    auto it = clients_.find(ws);
+    if (it != clients_.end()) {
+        return it->second.format;
     }
     return RenderFormat::BASIC; // Default.
 }
 
+void WebSocketServer::setClientMaxFps(std::shared_ptr<rtc::WebSocket> ws, uint32_t maxFps)
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    auto it = clients_.find(ws);
+    if (it == clients_.end()) {
+        return;
+    }
+    it->second.pacer.setMaxFps(maxFps);
+    spdlog::info("WebSocketServer: Client {} max FPS set to {}", it->second.id, maxFps);
+}
+
+size_t WebSocketServer::getClientCount() const
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    return clients_.size();
+}
+
+WebSocketServer::DeliveryTotals WebSocketServer::getDeliveryTotals() const
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    return totals_;
+}
+
+std::vector<Api::PerfStatsGet::ClientEntry> WebSocketServer::getClientStats() const
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+
+    std::vector<Api::PerfStatsGet::ClientEntry> result;
+    result.reserve(clients_.size());
+    for (const auto& [ws, client] : clients_) {
+        result.push_back(Api::PerfStatsGet::ClientEntry{
+            .id = client.id,
+            .format = client.format,
+            .max_fps = client.pacer.maxFps(),
+            .buffered_bytes = ws ? static_cast<uint64_t>(ws->bufferedAmount()) : 0,
+            .bytes_sent = client.bytesSent,
+            .frames_delivered = client.pacer.framesDelivered(),
+            .frames_skipped = client.pacer.framesSkipped(),
+        });
+    }
+
+    // Stable ordering for clients polling stats.
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+        return a.id < b.id;
+    });
+    return result;
+}
+
+void WebSocketServer::setMaxBufferedBytes(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    maxBufferedBytes_ = bytes;
+}
+
 } // namespace Server
 } // namespace DirtSim
@@ -1,16 +1,24 @@
 #pragma once
 
+#include "ClientFramePacer.h"
 #include "CommandDeserializerJson.h"
 #include "ResponseSerializerJson.h"
 #include "core/RenderMessage.h"
 #include "core/StateMachineInterface.h"
+#include "core/Timers.h"
 #include "core/WorldData.h"
 #include "server/Event.h"
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <rtc/rtc.hpp>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace DirtSim {
@@ -20,6 +28,7 @@ class WebSocketServer {
 public:
     explicit WebSocketServer(
         DirtSim::StateMachineInterface<Event>& stateMachine, uint16_t port = 8080);
+    ~WebSocketServer();
 
     /**
      * @brief Start the server.
@@ -27,7 +36,7 @@ public:
     void start();
 
     /**
-     * @brief Stop the server.
+     * @brief Stop the server and the state_get reply thread (unsent replies are dropped).
      */
     void stop();
 
@@ -46,6 +55,9 @@ public:
     /**
      * @brief Broadcast binary data to all connected clients.
      * @param data Binary data to broadcast.
+     *
+     * Gated per client like broadcastRenderMessage: skipped when the client's max FPS
+     * interval has not elapsed or its outgoing queue is over the backpressure threshold.
      */
     void broadcastBinary(const rtc::binary& data);
 
@@ -54,6 +66,10 @@ public:
      * @param data World data to pack and send.
      *
      * Each client receives RenderMessage in their requested format (BASIC or DEBUG).
+     * A frame is skipped for a client when its max FPS interval has not elapsed or when
+     * its libdatachannel send queue holds more than maxBufferedBytes, so a lagging viewer
+     * drops frames instead of growing an unbounded queue. Each format is packed at most
+     * once per frame and shared between clients.
      */
     void broadcastRenderMessage(const WorldData& data);
 
@@ -71,17 +87,136 @@ public:
      */
     RenderFormat getClientRenderFormat(std::shared_ptr<rtc::WebSocket> ws) const;
 
+    /**
+     * @brief Cap the rate of frames pushed to a specific client.
+     * @param ws Client connection.
+     * @param maxFps Max frames per second (0 = unlimited).
+     */
+    void setClientMaxFps(std::shared_ptr<rtc::WebSocket> ws, uint32_t maxFps);
+
+    /**
+     * @brief Snapshot of per-client frame delivery counters (for perf_stats_get).
+     */
+    std::vector<Api::PerfStatsGet::ClientEntry> getClientStats() const;
+
+    // Delivery counters over the server's lifetime, including disconnected clients.
+    struct DeliveryTotals {
+        std::array<uint64_t, 2> renderBytesSent{}; // Indexed by RenderFormat.
+        std::array<uint64_t, 2> renderFramesDelivered{};
+        uint64_t binaryBytesSent = 0;
+        uint64_t framesSkipped = 0;
+    };
+
+    DeliveryTotals getDeliveryTotals() const;
+
+    /**
+     * @brief Number of connected clients.
+     */
+    size_t getClientCount() const;
+
+    // Clients with more than this many bytes queued for sending are skipped.
+    void setMaxBufferedBytes(size_t bytes);
+
+    static constexpr size_t DEFAULT_MAX_BUFFERED_BYTES = 2 * 1024 * 1024;
+
+    /**
+     * @brief Copy of the state_get reply thread's timers (serialize_worlddata, network_send,
+     * state_get_immediate_total). Safe to call from any thread.
+     */
+    Timers getStateGetTimers() const;
+
+    /**
+     * @brief Serialize and send a state_get reply on the reply thread (nullptr = no data yet).
+     * Only queues and signals, so the physics thread can call it between ticks.
+     */
+    void queueStateGetReply(
+        std::shared_ptr<rtc::WebSocket> ws,
+        const Api::StateGet::Command& cmd,
+        std::optional<uint64_t> correlationId,
+        std::shared_ptr<const WorldData> data);
+
+    /**
+     * @brief Directory trace_stop may write into (empty = inline replies only).
+     * Clients name only the file; anything with a path component is rejected.
+     */
+    void setTraceDirectory(const std::string& directory);
+
+    /**
+     * @brief Directory profile_stop may write into (empty = inline replies only).
+     * Same file name rules as setTraceDirectory().
+     */
+    void setProfileDirectory(const std::string& directory);
+
     // Public for generic Cwc creation helpers.
     ResponseSerializerJson serializer_;
     DirtSim::StateMachineInterface<Event>& stateMachine_;
 
 private:
-    std::vector<std::shared_ptr<rtc::WebSocket>> connectedClients_;
+    struct ClientState {
+        uint32_t id = 0;
+        RenderFormat format = RenderFormat::BASIC;
+        uint64_t bytesSent = 0;
+        ClientFramePacer pacer; // Max FPS, backpressure and frame counters.
+    };
+
+    // Written from libdatachannel threads (connect/close) and read from the physics thread.
+    // Never held across ws->send(): a close callback may fire from inside a send.
+    std::map<std::shared_ptr<rtc::WebSocket>, ClientState> clients_;
+    mutable std::mutex clientsMutex_;
+    uint32_t nextClientId_ = 1;
+    DeliveryTotals totals_; // Guarded by clientsMutex_.
+    size_t maxBufferedBytes_ = DEFAULT_MAX_BUFFERED_BYTES;
+    std::string traceDirectory_;   // Set before start(); read on the network thread.
+    std::string profileDirectory_; // Likewise.
+
     std::unique_ptr<rtc::WebSocketServer> server_;
     CommandDeserializerJson deserializer_;
 
-    // Per-client render format tracking (defaults to BASIC).
-    std::map<std::shared_ptr<rtc::WebSocket>, RenderFormat> clientRenderFormats_;
+    // state_get replies are serialized and sent on their own thread, never on the physics
+    // thread (which only hands over the snapshot) or while holding a state machine lock.
+    struct StateGetReply {
+        std::shared_ptr<rtc::WebSocket> ws;
+        Api::StateGet::Command cmd;
+        std::optional<uint64_t> correlationId;
+        std::shared_ptr<const WorldData> data;
+    };
+    std::deque<StateGetReply> stateGetQueue_; // Guarded by stateGetMutex_.
+    bool stateGetStopping_ = false;           // Likewise.
+    std::mutex stateGetMutex_;
+    std::condition_variable stateGetReady_;
+    Timers stateGetTimers_; // Written by the reply thread; guarded by stateGetTimersMutex_.
+    mutable std::mutex stateGetTimersMutex_;
+    std::thread stateGetThread_;
+
+    // Reply thread body: wait for queued replies and send them in order.
+    void runStateGetReplies();
+
+    // Time a reply stage on stateGetTimers_ (locks stateGetTimersMutex_ only around the edge).
+    void startStateGetTimer(Timers::TimerId id);
+    void stopStateGetTimer(Timers::TimerId id);
+
+    // A client admitted for one paced frame. Sends happen with clientsMutex_ released.
+    struct Delivery {
+        std::shared_ptr<rtc::WebSocket> ws;
+        uint32_t clientId = 0;
+        RenderFormat format = RenderFormat::BASIC;
+        size_t bytes = 0; // Set once sent; 0 = not delivered.
+    };
+
+    /**
+     * @brief Snapshot the open clients whose pacer admits a frame now (locks clientsMutex_).
+     * Counts the skipped ones in the client's and the server's counters.
+     */
+    std::vector<Delivery> admitClients(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Add sent deliveries to the counters (locks clientsMutex_).
+     * Clients that disconnected meanwhile only count toward the server totals.
+     */
+    void recordDeliveries(
+        const std::vector<Delivery>& deliveries,
+        bool render,
+        std::chrono::steady_clock::time_point now);
 
     /**
      * @brief Handle new WebSocket connection.
@@ -90,11 +225,19 @@ private:
     void onClientConnected(std::shared_ptr<rtc::WebSocket> ws);
 
     /**
-     * @brief Handle incoming message from a client.
+     * @brief Handle an incoming command from a client.
      * @param ws The WebSocket connection.
-     * @param message The received message.
+     * @param command The command document, parsed once from JSON text or MessagePack.
      */
-    void onMessage(std::shared_ptr<rtc::WebSocket> ws, const std::string& message);
+    void onMessage(std::shared_ptr<rtc::WebSocket> ws, const nlohmann::json& command);
+
+    /**
+     * @brief Send {"error": message} (with "id" when correlated) to one client.
+     */
+    void sendError(
+        const std::shared_ptr<rtc::WebSocket>& ws,
+        const std::string& message,
+        std::optional<uint64_t> correlationId);
 
     /**
      * @brief Wrap ApiCommand in appropriate Cwc with response callback.
@@ -109,12 +252,24 @@ private:
         std::optional<uint64_t> correlationId);
 
     /**
-     * @brief Handle state_get immediately without queuing (low latency path).
+     * @brief Handle state_get without queuing it behind other commands (low latency path).
      * @param ws The WebSocket connection for sending response.
+     * @param cmd The state_get command (selects JSON or binary reply).
      * @param correlationId Optional correlation ID from request.
      */
     void handleStateGetImmediate(
-        std::shared_ptr<rtc::WebSocket> ws, std::optional<uint64_t> correlationId);
+        std::shared_ptr<rtc::WebSocket> ws,
+        const Api::StateGet::Command& cmd,
+        std::optional<uint64_t> correlationId);
+
+    /**
+     * @brief Serialize and send a state_get reply for a snapshot (reply thread only).
+     */
+    void sendStateGet(
+        const std::shared_ptr<rtc::WebSocket>& ws,
+        const Api::StateGet::Command& cmd,
+        std::optional<uint64_t> correlationId,
+        const WorldData* data);
 
     /**
      * @brief Handle status_get immediately without queuing (low latency path).
@@ -134,6 +289,50 @@ private:
         std::shared_ptr<rtc::WebSocket> ws,
         const Api::RenderFormatSet::Command& cmd,
         std::optional<uint64_t> correlationId);
+
+    /**
+     * @brief Handle profile_start immediately, in any server state.
+     * @param ws The WebSocket connection for sending response.
+     * @param cmd The profile start command (sampling rate).
+     * @param correlationId Optional correlation ID from request.
+     */
+    void handleProfileStartImmediate(
+        std::shared_ptr<rtc::WebSocket> ws,
+        const Api::ProfileStart::Command& cmd,
+        std::optional<uint64_t> correlationId);
+
+    /**
+     * @brief Handle profile_stop immediately: stop sampling, then write or return the stacks.
+     * @param ws The WebSocket connection for sending response.
+     * @param cmd The profile stop command (optional file name under the profile directory).
+     * @param correlationId Optional correlation ID from request.
+     */
+    void handleProfileStopImmediate(
+        std::shared_ptr<rtc::WebSocket> ws,
+        const Api::ProfileStop::Command& cmd,
+        std::optional<uint64_t> correlationId);
+
+    /**
+     * @brief Handle trace_start immediately, in any server state.
+     * @param ws The WebSocket connection for sending response.
+     * @param cmd The trace start command (ring size).
+     * @param correlationId Optional correlation ID from request.
+     */
+    void handleTraceStartImmediate(
+        std::shared_ptr<rtc::WebSocket> ws,
+        const Api::TraceStart::Command& cmd,
+        std::optional<uint64_t> correlationId);
+
+    /**
+     * @brief Handle trace_stop immediately: stop recording, then write or return the trace.
+     * @param ws The WebSocket connection for sending response.
+     * @param cmd The trace stop command (optional file name under the trace directory).
+     * @param correlationId Optional correlation ID from request.
+     */
+    void handleTraceStopImmediate(
+        std::shared_ptr<rtc::WebSocket> ws,
+        const Api::TraceStop::Command& cmd,
+        std::optional<uint64_t> correlationId);
 };
 
 } // namespace Server
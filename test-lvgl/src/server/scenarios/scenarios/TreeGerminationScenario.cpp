@@ -3,6 +3,8 @@
 #include "core/World.h"
 #include "core/WorldData.h"
 #include "core/organisms/TreeManager.h"
+#include "core/organisms/brains/NeuralBrain.h"
+#include "core/organisms/brains/NeuralNetwork.h"
 #include "server/scenarios/Scenario.h"
 #include "server/scenarios/ScenarioRegistry.h"
 #include <spdlog/spdlog.h>
@@ -26,8 +28,8 @@ public:
 
     void setConfig(const ScenarioConfig& newConfig, World& /*world*/) override
     {
-        if (std::holds_alternative<EmptyConfig>(newConfig)) {
-            config_ = std::get<EmptyConfig>(newConfig);
+        if (std::holds_alternative<TreeGerminationConfig>(newConfig)) {
+            config_ = std::get<TreeGerminationConfig>(newConfig);
             spdlog::info("TreeGerminationScenario: Config updated");
         }
         else {
@@ -55,7 +57,7 @@ public:
         }
 
         // Plant seed in center for balanced growth demonstration.
-        TreeId tree_id = world.getTreeManager().plantSeed(world, 4, 4);
+        TreeId tree_id = world.getTreeManager().plantSeed(world, 4, 4, createBrain());
         spdlog::info("TreeGerminationScenario: Planted seed {} at (4, 4)", tree_id);
     }
 
@@ -71,6 +73,38 @@ public:
     }
 
 private:
+    // NeuralBrain from config_.brain_weights_path, or nullptr (TreeManager's RuleBasedBrain)
+    // when no path is set or the weights cannot be used.
+    std::unique_ptr<TreeBrain> createBrain() const
+    {
+        const std::string& path = config_.brain_weights_path;
+        if (path.empty()) {
+            return nullptr;
+        }
+
+        auto network = NeuralNetwork::loadFromFile(path);
+        if (network.isError()) {
+            spdlog::error(
+                "TreeGerminationScenario: Failed to load brain weights {} ({}), using rule-based "
+                "brain",
+                path,
+                network.errorValue());
+            return nullptr;
+        }
+
+        auto brain = NeuralBrain::create(std::move(network).value());
+        if (brain.isError()) {
+            spdlog::error(
+                "TreeGerminationScenario: Brain weights {} unusable ({}), using rule-based brain",
+                path,
+                brain.errorValue());
+            return nullptr;
+        }
+
+        spdlog::info("TreeGerminationScenario: Using neural brain from {}", path);
+        return std::move(brain).value();
+    }
+
     ScenarioMetadata metadata_;
-    EmptyConfig config_; // No configuration needed.
+    TreeGerminationConfig config_;
 };
@@ -1,6 +1,7 @@
 #include "State.h"
 #include "core/Timers.h"
 #include "core/World.h"
+#include "server/MetricsExporter.h"
 #include "server/StateMachine.h"
 #include "server/scenarios/ScenarioRegistry.h"
 #include <spdlog/spdlog.h>
@@ -9,10 +10,13 @@ namespace DirtSim {
 namespace Server {
 namespace State {
 
-void Idle::onEnter(StateMachine& /*dsm*/)
+void Idle::onEnter(StateMachine& dsm)
 {
     spdlog::info("Idle: Server ready, waiting for commands (no active World)");
     // Note: World is owned by SimRunning state, not StateMachine.
+
+    // Nothing ticks here, so tell scrapers the last published values are not moving.
+    dsm.getMetricsExporter().publishPaused(true);
 }
 
 void Idle::onExit(StateMachine& /*dsm*/)
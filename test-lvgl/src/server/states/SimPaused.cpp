@@ -1,7 +1,10 @@
 #include "State.h"
 #include "core/Timers.h"
+#include "server/FlightRecorder.h"
+#include "server/MetricsExporter.h"
 #include "server/StateMachine.h"
 #include "server/api/TimerStatsGet.h"
+#include "server/network/WebSocketServer.h"
 #include "server/scenarios/ScenarioRegistry.h"
 #include <spdlog/spdlog.h>
 
@@ -9,10 +12,16 @@ namespace DirtSim {
 namespace Server {
 namespace State {
 
-void SimPaused::onEnter(StateMachine& /*dsm*/)
+void SimPaused::onEnter(StateMachine& dsm)
 {
     spdlog::info(
         "SimPaused: Simulation paused at step {} (World preserved)", previousState.stepCount);
+
+    // No more ticks will publish while paused, so make the final state available to readers.
+    if (previousState.world) {
+        dsm.updateCachedWorldData(previousState.world->getData(), true);
+    }
+    dsm.getMetricsExporter().publishPaused(true);
 }
 
 void SimPaused::onExit(StateMachine& /*dsm*/)
@@ -31,7 +40,7 @@ State::Any SimPaused::onEvent(const Api::Exit::Cwc& cwc, StateMachine& /*dsm*/)
     return Shutdown{};
 }
 
-State::Any SimPaused::onEvent(const Api::StateGet::Cwc& cwc, StateMachine& dsm)
+State::Any SimPaused::onEvent(const Api::StateGet::Cwc& cwc, StateMachine& /*dsm*/)
 {
     using Response = Api::StateGet::Response;
 
@@ -40,19 +49,24 @@ State::Any SimPaused::onEvent(const Api::StateGet::Cwc& cwc, StateMachine& dsm)
         return std::move(*this);
     }
 
-    // Return cached WorldData from paused state.
-    auto cachedPtr = dsm.getCachedWorldData();
-    if (cachedPtr) {
-        Api::StateGet::Okay responseData;
-        responseData.worldData = *cachedPtr;
-        cwc.sendResponse(Response::okay(std::move(responseData)));
-    }
-    else {
-        // Fallback: cache not ready yet, copy from world.
-        Api::StateGet::Okay responseData;
-        responseData.worldData = previousState.world->getData();
-        cwc.sendResponse(Response::okay(std::move(responseData)));
-    }
+    // Handlers run on the physics thread, so read the paused world directly.
+    Api::StateGet::Okay responseData;
+    responseData.worldData = previousState.world->getData();
+    cwc.sendResponse(Response::okay(std::move(responseData)));
+    return std::move(*this);
+}
+
+State::Any SimPaused::onEvent(const Api::MemoryStatsGet::Cwc& cwc, StateMachine& dsm)
+{
+    using Response = Api::MemoryStatsGet::Response;
+
+    Api::MemoryStatsGet::Okay stats = previousState.collectMemoryStats(dsm);
+    spdlog::info(
+        "SimPaused: API memory_stats_get returning {} resident bytes, {} tracked frames",
+        stats.resident_bytes,
+        stats.all_frames.calls);
+
+    cwc.sendResponse(Response::okay(std::move(stats)));
     return std::move(*this);
 }
 
@@ -60,8 +74,11 @@ State::Any SimPaused::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine& d
 {
     using Response = Api::PerfStatsGet::Response;
 
-    // Gather performance statistics from timers.
+    // Gather performance statistics from timers. state_get serialization and sends are timed
+    // on the WebSocket server's reply thread.
     auto& timers = dsm.getTimers();
+    const Timers replyTimers =
+        dsm.getWebSocketServer() ? dsm.getWebSocketServer()->getStateGetTimers() : Timers{};
 
     Api::PerfStatsGet::Okay stats;
     stats.fps = previousState.actualFPS;
@@ -73,8 +90,8 @@ State::Any SimPaused::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine& d
         stats.physics_calls > 0 ? stats.physics_total_ms / stats.physics_calls : 0.0;
 
     // Serialization timing.
-    stats.serialization_calls = timers.getCallCount("serialize_worlddata");
-    stats.serialization_total_ms = timers.getAccumulatedTime("serialize_worlddata");
+    stats.serialization_calls = replyTimers.getCallCount("serialize_worlddata");
+    stats.serialization_total_ms = replyTimers.getAccumulatedTime("serialize_worlddata");
     stats.serialization_avg_ms = stats.serialization_calls > 0
         ? stats.serialization_total_ms / stats.serialization_calls
         : 0.0;
@@ -86,11 +103,17 @@ State::Any SimPaused::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine& d
         stats.cache_update_calls > 0 ? stats.cache_update_total_ms / stats.cache_update_calls : 0.0;
 
     // Network send timing.
-    stats.network_send_calls = timers.getCallCount("network_send");
-    stats.network_send_total_ms = timers.getAccumulatedTime("network_send");
+    stats.network_send_calls = replyTimers.getCallCount("network_send");
+    stats.network_send_total_ms = replyTimers.getAccumulatedTime("network_send");
     stats.network_send_avg_ms =
         stats.network_send_calls > 0 ? stats.network_send_total_ms / stats.network_send_calls : 0.0;
 
+    // Per-client frame delivery (decimation and backpressure drops).
+    if (dsm.getWebSocketServer()) {
+        stats.clients = dsm.getWebSocketServer()->getClientStats();
+    }
+    previousState.addStageCounters(stats);
+
     spdlog::info(
         "SimPaused: API perf_stats_get returning {} physics steps, {} serializations",
         stats.physics_calls,
@@ -100,6 +123,26 @@ State::Any SimPaused::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine& d
     return std::move(*this);
 }
 
+State::Any SimPaused::onEvent(const Api::SlowFramesGet::Cwc& cwc, StateMachine& dsm)
+{
+    using Response = Api::SlowFramesGet::Response;
+
+    auto& recorder = dsm.getFlightRecorder();
+
+    Api::SlowFramesGet::Okay okay;
+    okay.threshold_ms = recorder.getConfig().thresholdMs;
+    okay.captures.assign(recorder.getCaptures().begin(), recorder.getCaptures().end());
+
+    if (cwc.command.clear) {
+        recorder.clearCaptures();
+    }
+
+    spdlog::info("SimPaused: API slow_frames_get returning {} captures", okay.captures.size());
+
+    cwc.sendResponse(Response::okay(std::move(okay)));
+    return std::move(*this);
+}
+
 State::Any SimPaused::onEvent(const Api::TimerStatsGet::Cwc& cwc, StateMachine& dsm)
 {
     using Response = Api::TimerStatsGet::Response;
@@ -110,10 +153,15 @@ State::Any SimPaused::onEvent(const Api::TimerStatsGet::Cwc& cwc, StateMachine&
     Api::TimerStatsGet::Okay okay;
 
     for (const auto& name : timerNames) {
+        const auto percentiles = timers.getPercentiles(name);
         Api::TimerStatsGet::TimerEntry entry;
         entry.total_ms = timers.getAccumulatedTime(name);
         entry.calls = timers.getCallCount(name);
         entry.avg_ms = entry.calls > 0 ? entry.total_ms / entry.calls : 0.0;
+        entry.p50_ms = percentiles.p50_ms;
+        entry.p90_ms = percentiles.p90_ms;
+        entry.p99_ms = percentiles.p99_ms;
+        entry.max_ms = percentiles.max_ms;
         okay.timers[name] = entry;
     }
 
@@ -18,7 +18,9 @@ struct SimPaused {
     void onExit(StateMachine& dsm);
 
     Any onEvent(const Api::Exit::Cwc& cwc, StateMachine& dsm);
+    Any onEvent(const Api::MemoryStatsGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine& dsm);
+    Any onEvent(const Api::SlowFramesGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const Api::StateGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const Api::TimerStatsGet::Cwc& cwc, StateMachine& dsm);
 
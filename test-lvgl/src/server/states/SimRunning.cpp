@@ -1,23 +1,40 @@
 #include "State.h"
+#include "core/AllocationTracker.h"
 #include "core/Cell.h"
+#include "core/HardwareCounters.h"
 #include "core/Timers.h"
 #include "core/World.h" // Must be before State.h for complete type.
 #include "core/WorldEventGenerator.h"
 #include "core/WorldFrictionCalculator.h"
 #include "core/organisms/TreeManager.h"
+#include "server/FlightRecorder.h"
+#include "server/MetricsExporter.h"
 #include "server/StateMachine.h"
 #include "server/network/WebSocketServer.h"
 #include "server/scenarios/Scenario.h"
 #include "server/scenarios/ScenarioRegistry.h"
+#include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
+#include <unistd.h>
 #include <zpp_bits.h>
 
 namespace DirtSim {
 namespace Server {
 namespace State {
 
+namespace {
+
+// Interned once at startup so per-frame timing skips the name lookup.
+const Timers::TimerId TIMER_BROADCAST_RENDER_MESSAGE = Timers::intern("broadcast_render_message");
+const Timers::TimerId TIMER_CACHE_UPDATE = Timers::intern("cache_update");
+const Timers::TimerId TIMER_PHYSICS_STEP = Timers::intern("physics_step");
+const Timers::TimerId TIMER_SCENARIO_TICK = Timers::intern("scenario_tick");
+
+} // namespace
+
 void SimRunning::onEnter(StateMachine& dsm)
 {
     spdlog::info("SimRunning: Entering simulation state");
@@ -61,6 +78,9 @@ void SimRunning::onEnter(StateMachine& dsm)
     }
 
     spdlog::info("SimRunning: Ready to run simulation (stepCount={})", stepCount);
+
+    // Ticks publish full samples from here on; flag the resume straight away.
+    dsm.getMetricsExporter().publishPaused(false);
 }
 
 void SimRunning::onExit(StateMachine& /*dsm. */)
@@ -79,14 +99,16 @@ void SimRunning::tick(StateMachine& dsm)
     // Headless server: advance physics simulation with fixed timestep accumulator.
     assert(world && "World must exist in SimRunning state");
 
+    const AllocationScope frameAllocations;
+
     // Measure real elapsed time since last physics update.
     const auto now = std::chrono::steady_clock::now();
 
     // Scenario tick (particle generation, timed events, etc.).
     if (scenario) {
-        dsm.getTimers().startTimer("scenario_tick");
+        dsm.getTimers().startTimer(TIMER_SCENARIO_TICK);
         scenario->tick(*world, FIXED_TIMESTEP_SECONDS);
-        dsm.getTimers().stopTimer("scenario_tick");
+        dsm.getTimers().stopTimer(TIMER_SCENARIO_TICK);
 
         // Sync scenario's config to WorldData (scenario is source of truth).
         // This ensures auto-changes (like water column auto-disable) propagate to UI.
@@ -94,9 +116,9 @@ void SimRunning::tick(StateMachine& dsm)
     }
 
     // Advance physics by fixed timestep.
-    dsm.getTimers().startTimer("physics_step");
+    dsm.getTimers().startTimer(TIMER_PHYSICS_STEP);
     world->advanceTime(FIXED_TIMESTEP_SECONDS);
-    dsm.getTimers().stopTimer("physics_step");
+    dsm.getTimers().stopTimer(TIMER_PHYSICS_STEP);
 
     stepCount++;
 
@@ -112,8 +134,12 @@ void SimRunning::tick(StateMachine& dsm)
         if (stepCount == 100 || stepCount % 500 == 0) {
             spdlog::info("SimRunning: Actual FPS: {:.1f} (step {})", actualFPS, stepCount);
 
-            // Log performance timing stats.
+            // Log performance timing stats. state_get replies are timed on the WebSocket
+            // server's reply thread.
             auto& timers = dsm.getTimers();
+            const Timers replyTimers = dsm.getWebSocketServer()
+                ? dsm.getWebSocketServer()->getStateGetTimers()
+                : Timers{};
             spdlog::info(
                 "  Physics: {:.1f}ms avg ({} calls, {:.1f}ms total)",
                 timers.getCallCount("physics_step") > 0 ? timers.getAccumulatedTime("physics_step")
@@ -130,27 +156,28 @@ void SimRunning::tick(StateMachine& dsm)
                 timers.getAccumulatedTime("cache_update"));
             spdlog::info(
                 "  zpp_bits pack: {:.2f}ms avg ({} calls, {:.1f}ms total)",
-                timers.getCallCount("serialize_worlddata") > 0
-                    ? timers.getAccumulatedTime("serialize_worlddata")
-                        / timers.getCallCount("serialize_worlddata")
+                replyTimers.getCallCount("serialize_worlddata") > 0
+                    ? replyTimers.getAccumulatedTime("serialize_worlddata")
+                        / replyTimers.getCallCount("serialize_worlddata")
                     : 0.0,
-                timers.getCallCount("serialize_worlddata"),
-                timers.getAccumulatedTime("serialize_worlddata"));
+                replyTimers.getCallCount("serialize_worlddata"),
+                replyTimers.getAccumulatedTime("serialize_worlddata"));
             spdlog::info(
                 "  Network send: {:.2f}ms avg ({} calls, {:.1f}ms total)",
-                timers.getCallCount("network_send") > 0 ? timers.getAccumulatedTime("network_send")
-                        / timers.getCallCount("network_send")
-                                                        : 0.0,
-                timers.getCallCount("network_send"),
-                timers.getAccumulatedTime("network_send"));
+                replyTimers.getCallCount("network_send") > 0
+                    ? replyTimers.getAccumulatedTime("network_send")
+                        / replyTimers.getCallCount("network_send")
+                    : 0.0,
+                replyTimers.getCallCount("network_send"),
+                replyTimers.getAccumulatedTime("network_send"));
             spdlog::info(
                 "  state_get immediate (total): {:.2f}ms avg ({} calls, {:.1f}ms total)",
-                timers.getCallCount("state_get_immediate_total") > 0
-                    ? timers.getAccumulatedTime("state_get_immediate_total")
-                        / timers.getCallCount("state_get_immediate_total")
+                replyTimers.getCallCount("state_get_immediate_total") > 0
+                    ? replyTimers.getAccumulatedTime("state_get_immediate_total")
+                        / replyTimers.getCallCount("state_get_immediate_total")
                     : 0.0,
-                timers.getCallCount("state_get_immediate_total"),
-                timers.getAccumulatedTime("state_get_immediate_total"));
+                replyTimers.getCallCount("state_get_immediate_total"),
+                replyTimers.getAccumulatedTime("state_get_immediate_total"));
         }
     }
 
@@ -174,10 +201,10 @@ void SimRunning::tick(StateMachine& dsm)
         world->getData().tree_vision.reset();
     }
 
-    // Update StateMachine's cached WorldData after all physics steps complete.
-    dsm.getTimers().startTimer("cache_update");
+    // Publish to readers on other threads (copies cells only if a snapshot was requested).
+    dsm.getTimers().startTimer(TIMER_CACHE_UPDATE);
     dsm.updateCachedWorldData(world->getData());
-    dsm.getTimers().stopTimer("cache_update");
+    dsm.getTimers().stopTimer(TIMER_CACHE_UPDATE);
 
     spdlog::debug("SimRunning: Advanced simulation, total step {})", stepCount);
 
@@ -188,9 +215,9 @@ void SimRunning::tick(StateMachine& dsm)
 
         // Broadcast RenderMessage to all clients (per-client format).
         auto broadcastStart = std::chrono::steady_clock::now();
-        timers.startTimer("broadcast_render_message");
+        timers.startTimer(TIMER_BROADCAST_RENDER_MESSAGE);
         dsm.getWebSocketServer()->broadcastRenderMessage(world->getData());
-        timers.stopTimer("broadcast_render_message");
+        timers.stopTimer(TIMER_BROADCAST_RENDER_MESSAGE);
         auto broadcastEnd = std::chrono::steady_clock::now();
         auto broadcastMs =
             std::chrono::duration_cast<std::chrono::milliseconds>(broadcastEnd - broadcastStart)
@@ -223,6 +250,61 @@ void SimRunning::tick(StateMachine& dsm)
         }
         lastFrameSendTime = now;
     }
+
+    // Per-tick context for slow frame captures.
+    const World::StepStats& stepStats = world->getLastStepStats();
+    const FlightRecorder::FrameCounters counters{
+        .timestep = world->getData().timestep,
+        .frameMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - now)
+                .count(),
+        .activeCells = stepStats.active_cells,
+        .pendingMoves = stepStats.pending_moves,
+        .blockedTransfers = stepStats.blocked_transfers,
+        .clientCount = dsm.getWebSocketServer()
+            ? static_cast<uint32_t>(dsm.getWebSocketServer()->getClientCount())
+            : 0,
+    };
+    dsm.getFlightRecorder().recordFrame(counters, world->getTimers(), dsm.getTimers());
+
+    // Live metrics for scrapers (rate limited; the HTTP thread reads the published copy).
+    auto& metrics = dsm.getMetricsExporter();
+    const auto publishTime = std::chrono::steady_clock::now();
+    if (metrics.publishDue(publishTime)) {
+        MetricsExporter::Sample sample{
+            .stepsTotal = stepCount,
+            .stepRate = actualFPS,
+            .timestep = world->getData().timestep,
+            .worldWidth = world->getData().width,
+            .worldHeight = world->getData().height,
+            .activeCells = stepStats.active_cells,
+            .clients = counters.clientCount,
+            .renderBytesSent = {},
+            .renderFramesDelivered = {},
+            .otherBytesSent = 0,
+            .framesDropped = 0,
+        };
+        if (dsm.getWebSocketServer()) {
+            const auto totals = dsm.getWebSocketServer()->getDeliveryTotals();
+            sample.renderBytesSent = totals.renderBytesSent;
+            sample.renderFramesDelivered = totals.renderFramesDelivered;
+            sample.otherBytesSent = totals.binaryBytesSent;
+            sample.framesDropped = totals.framesSkipped;
+        }
+        metrics.publish(sample, world->getTimers(), dsm.getTimers(), publishTime);
+    }
+
+    if constexpr (AllocationTracker::isCompiledIn()) {
+        lastFrameAllocations = frameAllocations.counts();
+        allFrameAllocations.allocations += lastFrameAllocations.allocations;
+        allFrameAllocations.bytes += lastFrameAllocations.bytes;
+        allFrameAllocations.frees += lastFrameAllocations.frees;
+        maxFrameAllocations = std::max(maxFrameAllocations, lastFrameAllocations.allocations);
+        trackedFrames++;
+        if (lastFrameAllocations.allocations == 0) {
+            allocationFreeFrames++;
+        }
+    }
 }
 
 State::Any SimRunning::onEvent(const ApplyScenarioCommand& cmd, StateMachine& dsm)
@@ -327,6 +409,108 @@ State::Any SimRunning::onEvent(const Api::CellSet::Cwc& cwc, StateMachine& /*dsm
     return std::move(*this);
 }
 
+State::Any SimRunning::onEvent(const Api::CellsSetBulk::Cwc& cwc, StateMachine& /*dsm*/)
+{
+    using Response = Api::CellsSetBulk::Response;
+
+    if (!world) {
+        cwc.sendResponse(Response::error(ApiError("No world available")));
+        return std::move(*this);
+    }
+
+    const int width = static_cast<int>(world->getData().width);
+    const int height = static_cast<int>(world->getData().height);
+    const auto& cmd = cwc.command;
+
+    // Compared by subtraction so huge sizes cannot overflow past the check.
+    const auto inBounds = [&](int x, int y, int w, int h) {
+        return x >= 0 && y >= 0 && w >= 0 && h >= 0 && w <= width - x && h <= height - y;
+    };
+    const auto validFill = [](double fill) { return fill >= 0.0 && fill <= 1.0; };
+
+    // Validate everything up front so the edit applies completely or not at all.
+    for (const auto& rect : cmd.rects) {
+        if (!inBounds(rect.x, rect.y, rect.width, rect.height)) {
+            cwc.sendResponse(Response::error(ApiError("Rect out of bounds")));
+            return std::move(*this);
+        }
+        if (!validFill(rect.fill)) {
+            cwc.sendResponse(Response::error(ApiError("Fill must be between 0.0 and 1.0")));
+            return std::move(*this);
+        }
+    }
+    for (const auto& span : cmd.spans) {
+        if (!inBounds(span.x, span.y, span.length, 1)) {
+            cwc.sendResponse(Response::error(ApiError("Span out of bounds")));
+            return std::move(*this);
+        }
+        if (!validFill(span.fill)) {
+            cwc.sendResponse(Response::error(ApiError("Fill must be between 0.0 and 1.0")));
+            return std::move(*this);
+        }
+    }
+    if (cmd.packed.size() % Api::CellsSetBulk::PACKED_RECORD_SIZE != 0) {
+        cwc.sendResponse(Response::error(ApiError("Packed data is not a whole number of records")));
+        return std::move(*this);
+    }
+
+    const size_t packedCount = cmd.packed.size() / Api::CellsSetBulk::PACKED_RECORD_SIZE;
+    size_t editCount = packedCount;
+    for (const auto& rect : cmd.rects) {
+        editCount += static_cast<size_t>(rect.width) * rect.height;
+    }
+    for (const auto& span : cmd.spans) {
+        editCount += span.length;
+    }
+
+    std::vector<World::CellEdit> edits;
+    edits.reserve(editCount);
+
+    for (const auto& rect : cmd.rects) {
+        for (int y = rect.y; y < rect.y + rect.height; ++y) {
+            for (int x = rect.x; x < rect.x + rect.width; ++x) {
+                edits.push_back(
+                    World::CellEdit{ .x = static_cast<uint32_t>(x),
+                                     .y = static_cast<uint32_t>(y),
+                                     .material = rect.material,
+                                     .fill = rect.fill });
+            }
+        }
+    }
+    for (const auto& span : cmd.spans) {
+        for (int x = span.x; x < span.x + span.length; ++x) {
+            edits.push_back(
+                World::CellEdit{ .x = static_cast<uint32_t>(x),
+                                 .y = static_cast<uint32_t>(span.y),
+                                 .material = span.material,
+                                 .fill = span.fill });
+        }
+    }
+    for (size_t i = 0; i < packedCount; ++i) {
+        const auto cell = Api::CellsSetBulk::readPackedCell(
+            cmd.packed.data() + i * Api::CellsSetBulk::PACKED_RECORD_SIZE);
+        if (cell.index >= static_cast<uint32_t>(width * height)
+            || cell.material > MaterialType::WOOD
+            || !validFill(cell.fill)) {
+            cwc.sendResponse(Response::error(ApiError("Invalid packed cell record")));
+            return std::move(*this);
+        }
+        edits.push_back(
+            World::CellEdit{ .x = cell.index % static_cast<uint32_t>(width),
+                             .y = cell.index / static_cast<uint32_t>(width),
+                             .material = cell.material,
+                             .fill = cell.fill });
+    }
+
+    // Events are handled between ticks, so the whole batch lands on one step boundary.
+    Api::CellsSetBulk::Okay okay;
+    okay.cells_changed = world->applyCellEdits(edits);
+    spdlog::debug("CellsSetBulk: Applied {} of {} edits", okay.cells_changed, edits.size());
+
+    cwc.sendResponse(Response::okay(std::move(okay)));
+    return std::move(*this);
+}
+
 State::Any SimRunning::onEvent(const Api::GravitySet::Cwc& cwc, StateMachine& /*dsm*/)
 {
     using Response = Api::GravitySet::Response;
@@ -343,12 +527,103 @@ State::Any SimRunning::onEvent(const Api::GravitySet::Cwc& cwc, StateMachine& /*
     return std::move(*this);
 }
 
+namespace {
+
+uint64_t residentBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    uint64_t sizePages = 0;
+    uint64_t residentPages = 0;
+    if (!(statm >> sizePages >> residentPages)) {
+        return 0;
+    }
+    return residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+Api::MemoryStatsGet::AllocationEntry toAllocationEntry(
+    const AllocationTracker::Counts& counts, uint32_t calls)
+{
+    return Api::MemoryStatsGet::AllocationEntry{
+        .calls = calls,
+        .allocations = counts.allocations,
+        .bytes = counts.bytes,
+        .frees = counts.frees,
+        .allocations_per_call =
+            calls > 0 ? static_cast<double>(counts.allocations) / calls : 0.0,
+    };
+}
+
+void addStageAllocations(
+    std::map<std::string, Api::MemoryStatsGet::AllocationEntry>& stages, const Timers& timers)
+{
+    for (const auto& name : timers.getAllTimerNames()) {
+        const AllocationTracker::Counts counts = timers.getAllocations(name);
+        if (counts.allocations == 0 && counts.frees == 0) {
+            continue;
+        }
+        stages[name] = toAllocationEntry(counts, timers.getCallCount(name));
+    }
+}
+
+} // namespace
+
+Api::MemoryStatsGet::Okay SimRunning::collectMemoryStats(const StateMachine& dsm) const
+{
+    Api::MemoryStatsGet::Okay stats;
+    stats.resident_bytes = residentBytes();
+
+    if (world) {
+        const World::MemoryUsage usage = world->getMemoryUsage();
+        stats.subsystem_bytes = {
+            { "cells", usage.cells },
+            { "debug_info", usage.debug_info },
+            { "bitmaps", usage.bitmaps },
+            { "neighborhoods", usage.neighborhoods },
+            { "tree_maps", usage.tree_maps },
+            { "move_queues", usage.move_queues },
+        };
+    }
+
+    stats.alloc_tracking = AllocationTracker::isCompiledIn();
+    if (!stats.alloc_tracking) {
+        return stats;
+    }
+
+    stats.last_frame = toAllocationEntry(lastFrameAllocations, trackedFrames > 0 ? 1 : 0);
+    stats.all_frames = toAllocationEntry(allFrameAllocations, trackedFrames);
+    stats.allocation_free_frames = allocationFreeFrames;
+    stats.max_frame_allocations = maxFrameAllocations;
+    if (world) {
+        addStageAllocations(stats.stage_allocations, world->getTimers());
+    }
+    addStageAllocations(stats.stage_allocations, dsm.getTimers());
+    stats.process = toAllocationEntry(AllocationTracker::processCounts(), 0);
+    return stats;
+}
+
+State::Any SimRunning::onEvent(const Api::MemoryStatsGet::Cwc& cwc, StateMachine& dsm)
+{
+    using Response = Api::MemoryStatsGet::Response;
+
+    Api::MemoryStatsGet::Okay stats = collectMemoryStats(dsm);
+    spdlog::info(
+        "SimRunning: API memory_stats_get returning {} resident bytes, {} tracked frames",
+        stats.resident_bytes,
+        stats.all_frames.calls);
+
+    cwc.sendResponse(Response::okay(std::move(stats)));
+    return std::move(*this);
+}
+
 State::Any SimRunning::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine& dsm)
 {
     using Response = Api::PerfStatsGet::Response;
 
-    // Gather performance statistics from timers.
+    // Gather performance statistics from timers. state_get serialization and sends are timed
+    // on the WebSocket server's reply thread.
     auto& timers = dsm.getTimers();
+    const Timers replyTimers =
+        dsm.getWebSocketServer() ? dsm.getWebSocketServer()->getStateGetTimers() : Timers{};
 
     Api::PerfStatsGet::Okay stats;
     stats.fps = actualFPS;
@@ -360,8 +635,8 @@ State::Any SimRunning::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine&
         stats.physics_calls > 0 ? stats.physics_total_ms / stats.physics_calls : 0.0;
 
     // Serialization timing.
-    stats.serialization_calls = timers.getCallCount("serialize_worlddata");
-    stats.serialization_total_ms = timers.getAccumulatedTime("serialize_worlddata");
+    stats.serialization_calls = replyTimers.getCallCount("serialize_worlddata");
+    stats.serialization_total_ms = replyTimers.getAccumulatedTime("serialize_worlddata");
     stats.serialization_avg_ms = stats.serialization_calls > 0
         ? stats.serialization_total_ms / stats.serialization_calls
         : 0.0;
@@ -373,11 +648,17 @@ State::Any SimRunning::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine&
         stats.cache_update_calls > 0 ? stats.cache_update_total_ms / stats.cache_update_calls : 0.0;
 
     // Network send timing.
-    stats.network_send_calls = timers.getCallCount("network_send");
-    stats.network_send_total_ms = timers.getAccumulatedTime("network_send");
+    stats.network_send_calls = replyTimers.getCallCount("network_send");
+    stats.network_send_total_ms = replyTimers.getAccumulatedTime("network_send");
     stats.network_send_avg_ms =
         stats.network_send_calls > 0 ? stats.network_send_total_ms / stats.network_send_calls : 0.0;
 
+    // Per-client frame delivery (decimation and backpressure drops).
+    if (dsm.getWebSocketServer()) {
+        stats.clients = dsm.getWebSocketServer()->getClientStats();
+    }
+    addStageCounters(stats);
+
     spdlog::info(
         "SimRunning: API perf_stats_get returning {} physics steps, {} serializations",
         stats.physics_calls,
@@ -387,6 +668,64 @@ State::Any SimRunning::onEvent(const Api::PerfStatsGet::Cwc& cwc, StateMachine&
     return std::move(*this);
 }
 
+void SimRunning::addStageCounters(Api::PerfStatsGet::Okay& stats) const
+{
+    if (!HardwareCounters::isEnabled() || !world) {
+        return;
+    }
+
+    for (size_t event = 0; event < HardwareCounters::EVENT_COUNT; ++event) {
+        if (HardwareCounters::isAvailable(static_cast<HardwareCounters::Event>(event))) {
+            stats.hw_counter_events.emplace_back(HardwareCounters::EVENT_NAMES[event]);
+        }
+    }
+
+    const auto& timers = world->getTimers();
+    const double cells = static_cast<double>(world->getData().width) * world->getData().height;
+    for (const auto& name : timers.getAllTimerNames()) {
+        const HardwareCounters::Values counters = timers.getHardwareCounters(name);
+        if (counters[HardwareCounters::Cycles] == 0
+            && counters[HardwareCounters::Instructions] == 0) {
+            continue;
+        }
+
+        Api::PerfStatsGet::StageCounterEntry entry;
+        entry.calls = timers.getCallCount(name);
+        entry.cycles = counters[HardwareCounters::Cycles];
+        entry.instructions = counters[HardwareCounters::Instructions];
+        entry.llc_misses = counters[HardwareCounters::LlcMisses];
+        entry.branch_misses = counters[HardwareCounters::BranchMisses];
+        entry.ipc = entry.cycles > 0 ? static_cast<double>(entry.instructions) / entry.cycles : 0.0;
+
+        const double cellCalls = cells * entry.calls;
+        if (cellCalls > 0.0) {
+            entry.llc_misses_per_cell = entry.llc_misses / cellCalls;
+            entry.branch_misses_per_cell = entry.branch_misses / cellCalls;
+        }
+        stats.stage_counters[name] = entry;
+    }
+}
+
+State::Any SimRunning::onEvent(const Api::SlowFramesGet::Cwc& cwc, StateMachine& dsm)
+{
+    using Response = Api::SlowFramesGet::Response;
+
+    auto& recorder = dsm.getFlightRecorder();
+
+    Api::SlowFramesGet::Okay okay;
+    okay.threshold_ms = recorder.getConfig().thresholdMs;
+    okay.captures.assign(recorder.getCaptures().begin(), recorder.getCaptures().end());
+
+    if (cwc.command.clear) {
+        recorder.clearCaptures();
+    }
+
+    spdlog::info("SimRunning: API slow_frames_get returning {} captures", okay.captures.size());
+
+    cwc.sendResponse(Response::okay(std::move(okay)));
+    return std::move(*this);
+}
+
 State::Any SimRunning::onEvent(const Api::TimerStatsGet::Cwc& cwc, StateMachine& /*dsm*/)
 {
     using Response = Api::TimerStatsGet::Response;
@@ -395,12 +734,17 @@ State::Any SimRunning::onEvent(const Api::TimerStatsGet::Cwc& cwc, StateMachine&
     Api::TimerStatsGet::Okay stats;
 
     if (world) {
-        auto timerNames = world->getTimers().getAllTimerNames();
-        for (const auto& name : timerNames) {
+        const auto& timers = world->getTimers();
+        for (const auto& name : timers.getAllTimerNames()) {
+            const auto percentiles = timers.getPercentiles(name);
             Api::TimerStatsGet::TimerEntry entry;
-            entry.total_ms = world->getTimers().getAccumulatedTime(name);
-            entry.calls = world->getTimers().getCallCount(name);
+            entry.total_ms = timers.getAccumulatedTime(name);
+            entry.calls = timers.getCallCount(name);
             entry.avg_ms = entry.calls > 0 ? entry.total_ms / entry.calls : 0.0;
+            entry.p50_ms = percentiles.p50_ms;
+            entry.p90_ms = percentiles.p90_ms;
+            entry.p99_ms = percentiles.p99_ms;
+            entry.max_ms = percentiles.max_ms;
             stats.timers[name] = entry;
         }
     }
@@ -590,7 +934,7 @@ State::Any SimRunning::onEvent(const Api::PhysicsSettingsSet::Cwc& cwc, StateMac
     return std::move(*this);
 }
 
-State::Any SimRunning::onEvent(const Api::StateGet::Cwc& cwc, StateMachine& dsm)
+State::Any SimRunning::onEvent(const Api::StateGet::Cwc& cwc, StateMachine& /*dsm*/)
 {
     using Response = Api::StateGet::Response;
 
@@ -602,19 +946,10 @@ State::Any SimRunning::onEvent(const Api::StateGet::Cwc& cwc, StateMachine& dsm)
         return std::move(*this);
     }
 
-    // Return cached WorldData (fast - uses pre-cached copy, no World copy overhead!).
-    auto cachedPtr = dsm.getCachedWorldData();
-    if (cachedPtr) {
-        Api::StateGet::Okay responseData;
-        responseData.worldData = *cachedPtr;
-        cwc.sendResponse(Response::okay(std::move(responseData)));
-    }
-    else {
-        // Fallback: cache not ready yet, copy from world.
-        Api::StateGet::Okay responseData;
-        responseData.worldData = world->getData();
-        cwc.sendResponse(Response::okay(std::move(responseData)));
-    }
+    // Handlers run on the physics thread, so the live world is the freshest source.
+    Api::StateGet::Okay responseData;
+    responseData.worldData = world->getData();
+    cwc.sendResponse(Response::okay(std::move(responseData)));
 
     // Log server processing time for state_get requests (includes serialization + send).
     auto requestEnd = std::chrono::steady_clock::now();
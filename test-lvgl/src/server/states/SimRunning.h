@@ -1,6 +1,7 @@
 #pragma once
 
 #include "StateForward.h"
+#include "core/AllocationTracker.h"
 #include "server/Event.h"
 #include "server/scenarios/Scenario.h"
 #include <chrono>
@@ -35,19 +36,34 @@ struct SimRunning {
     static constexpr double FIXED_TIMESTEP_SECONDS = 0.016; // 16ms = 60 FPS physics.
     std::chrono::steady_clock::time_point lastPhysicsTime;
 
+    // Heap traffic per tick on the physics thread (allocation-tracking builds only).
+    AllocationTracker::Counts lastFrameAllocations;
+    AllocationTracker::Counts allFrameAllocations;
+    uint32_t trackedFrames = 0;
+    uint32_t allocationFreeFrames = 0;
+    uint64_t maxFrameAllocations = 0;
+
     void onEnter(StateMachine& dsm);
     void onExit(StateMachine& dsm);
 
     // Called each frame by main loop to advance simulation.
     void tick(StateMachine& dsm);
 
+    // Add per-stage hardware counters from the World's Timers to a perf_stats_get reply.
+    void addStageCounters(Api::PerfStatsGet::Okay& stats) const;
+
+    // Build a memory_stats_get reply (subsystem sizes and allocation counts).
+    Api::MemoryStatsGet::Okay collectMemoryStats(const StateMachine& dsm) const;
+
     Any onEvent(const ApplyScenarioCommand& cmd, StateMachine& dsm);
     Any onEvent(const ResizeWorldCommand& cmd, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::CellGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::CellSet::Cwc& cwc, StateMachine& dsm);
+    Any onEvent(const DirtSim::Api::CellsSetBulk::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::DiagramGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::Exit::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::GravitySet::Cwc& cwc, StateMachine& dsm);
+    Any onEvent(const DirtSim::Api::MemoryStatsGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::PerfStatsGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::TimerStatsGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::PhysicsSettingsGet::Cwc& cwc, StateMachine& dsm);
@@ -56,6 +72,7 @@ struct SimRunning {
     Any onEvent(const DirtSim::Api::ScenarioConfigSet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::WorldResize::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::SeedAdd::Cwc& cwc, StateMachine& dsm);
+    Any onEvent(const DirtSim::Api::SlowFramesGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::StatusGet::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::SimRun::Cwc& cwc, StateMachine& dsm);
     Any onEvent(const DirtSim::Api::SpawnDirtBall::Cwc& cwc, StateMachine& dsm);
@@ -0,0 +1,75 @@
+#include "server/network/ClientFramePacer.h"
+#include <chrono>
+#include <gtest/gtest.h>
+
+using namespace DirtSim::Server;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t MAX_BUFFERED = 1024;
+
+} // namespace
+
+TEST(ClientFramePacerTest, UnlimitedClientGetsEveryFrame)
+{
+    ClientFramePacer pacer;
+    auto now = ClientFramePacer::Clock::time_point{};
+
+    for (int frame = 0; frame < 10; ++frame) {
+        ASSERT_TRUE(pacer.admit(now, 0, MAX_BUFFERED));
+        pacer.onDelivered(now);
+        now += 1ms;
+    }
+
+    EXPECT_EQ(pacer.framesDelivered(), 10u);
+    EXPECT_EQ(pacer.framesSkipped(), 0u);
+}
+
+TEST(ClientFramePacerTest, MaxFpsDecimatesFrames)
+{
+    ClientFramePacer pacer;
+    pacer.setMaxFps(10); // One frame per 100 ms.
+    auto now = ClientFramePacer::Clock::time_point{};
+
+    // 60 frames at ~60 Hz over one second.
+    for (int frame = 0; frame < 60; ++frame) {
+        if (pacer.admit(now, 0, MAX_BUFFERED)) {
+            pacer.onDelivered(now);
+        }
+        now += 16667us;
+    }
+
+    EXPECT_EQ(pacer.framesDelivered(), 10u);
+    EXPECT_EQ(pacer.framesSkipped(), 50u);
+}
+
+TEST(ClientFramePacerTest, BackpressureSkipsUntilQueueDrains)
+{
+    ClientFramePacer pacer;
+    auto now = ClientFramePacer::Clock::time_point{};
+
+    EXPECT_TRUE(pacer.admit(now, MAX_BUFFERED, MAX_BUFFERED));
+    pacer.onDelivered(now);
+
+    EXPECT_FALSE(pacer.admit(now + 1ms, MAX_BUFFERED + 1, MAX_BUFFERED));
+    EXPECT_FALSE(pacer.admit(now + 2ms, 10 * MAX_BUFFERED, MAX_BUFFERED));
+    EXPECT_TRUE(pacer.admit(now + 3ms, 0, MAX_BUFFERED));
+
+    EXPECT_EQ(pacer.framesDelivered(), 1u);
+    EXPECT_EQ(pacer.framesSkipped(), 2u);
+}
+
+TEST(ClientFramePacerTest, SkippedFrameDoesNotResetFpsInterval)
+{
+    ClientFramePacer pacer;
+    pacer.setMaxFps(10);
+    auto now = ClientFramePacer::Clock::time_point{};
+
+    ASSERT_TRUE(pacer.admit(now, 0, MAX_BUFFERED));
+    pacer.onDelivered(now);
+
+    // Interval elapsed but the queue is full: skipped, and the next frame may go at once.
+    EXPECT_FALSE(pacer.admit(now + 150ms, MAX_BUFFERED + 1, MAX_BUFFERED));
+    EXPECT_TRUE(pacer.admit(now + 160ms, 0, MAX_BUFFERED));
+}
@@ -0,0 +1,75 @@
+#include "core/MsgPackAdapter.h"
+#include "server/network/CommandDeserializerJson.h"
+#include <gtest/gtest.h>
+
+using namespace DirtSim;
+using namespace DirtSim::Server;
+
+namespace {
+
+std::vector<std::byte> packMsgPack(const nlohmann::json& doc)
+{
+    msgpack::sbuffer buffer;
+    msgpack::pack(buffer, doc);
+    const auto* bytes = reinterpret_cast<const std::byte*>(buffer.data());
+    return std::vector<std::byte>(bytes, bytes + buffer.size());
+}
+
+} // namespace
+
+TEST(CommandDeserializerTest, MsgPackCommandMatchesJson)
+{
+    const nlohmann::json doc = {
+        { "command", "cell_set" }, { "id", 12 }, { "x", 3 }, { "y", 4 },
+        { "material", "WATER" },   { "fill", 0.5 },
+    };
+
+    auto parsed = CommandDeserializerJson::parseMsgPack(packMsgPack(doc));
+    ASSERT_TRUE(parsed.isValue());
+    EXPECT_EQ(parsed.value()["id"].get<uint64_t>(), 12u);
+
+    CommandDeserializerJson deserializer;
+    auto result = deserializer.deserialize(parsed.value());
+    ASSERT_TRUE(result.isValue());
+    ASSERT_TRUE(std::holds_alternative<Api::CellSet::Command>(result.value()));
+
+    const auto& cmd = std::get<Api::CellSet::Command>(result.value());
+    EXPECT_EQ(cmd.x, 3);
+    EXPECT_EQ(cmd.y, 4);
+    EXPECT_EQ(cmd.material, MaterialType::WATER);
+    EXPECT_DOUBLE_EQ(cmd.fill, 0.5);
+}
+
+TEST(CommandDeserializerTest, MsgPackCarriesRawPackedCells)
+{
+    std::vector<uint8_t> packed;
+    Api::CellsSetBulk::appendPackedCell(
+        packed, { .index = 42, .material = MaterialType::SAND, .fill = 0.25f });
+
+    const nlohmann::json doc = {
+        { "command", "cells_set_bulk" },
+        { "packed", nlohmann::json::binary(packed) },
+    };
+
+    auto parsed = CommandDeserializerJson::parseMsgPack(packMsgPack(doc));
+    ASSERT_TRUE(parsed.isValue());
+
+    CommandDeserializerJson deserializer;
+    auto result = deserializer.deserialize(parsed.value());
+    ASSERT_TRUE(result.isValue());
+
+    const auto& cmd = std::get<Api::CellsSetBulk::Command>(result.value());
+    ASSERT_EQ(cmd.packed.size(), Api::CellsSetBulk::PACKED_RECORD_SIZE);
+    const auto cell = Api::CellsSetBulk::readPackedCell(cmd.packed.data());
+    EXPECT_EQ(cell.index, 42u);
+    EXPECT_EQ(cell.material, MaterialType::SAND);
+    EXPECT_FLOAT_EQ(cell.fill, 0.25f);
+}
+
+TEST(CommandDeserializerTest, MalformedMsgPackIsAnError)
+{
+    const std::vector<std::byte> garbage = { std::byte{ 0xc1 } }; // Never-used MessagePack tag.
+
+    auto parsed = CommandDeserializerJson::parseMsgPack(garbage);
+    EXPECT_TRUE(parsed.isError());
+}
@@ -0,0 +1,99 @@
+#include "core/Timers.h"
+#include "server/FlightRecorder.h"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace DirtSim;
+using namespace DirtSim::Server;
+
+namespace {
+
+FlightRecorder::FrameCounters makeCounters(uint64_t timestep, double frameMs)
+{
+    FlightRecorder::FrameCounters counters;
+    counters.timestep = timestep;
+    counters.frameMs = frameMs;
+    counters.activeCells = 100;
+    counters.pendingMoves = 5;
+    counters.blockedTransfers = 2;
+    counters.clientCount = 1;
+    return counters;
+}
+
+} // namespace
+
+TEST(FlightRecorderTest, NoCapturesWhenDisabled)
+{
+    FlightRecorder recorder;
+    Timers worldTimers;
+    Timers serverTimers;
+
+    for (uint64_t step = 0; step < 20; ++step) {
+        recorder.recordFrame(makeCounters(step, 500.0), worldTimers, serverTimers);
+    }
+
+    EXPECT_TRUE(recorder.getCaptures().empty());
+}
+
+TEST(FlightRecorderTest, SlowFrameCapturesSurroundingFrames)
+{
+    FlightRecorder recorder;
+    FlightRecorder::Config config;
+    config.thresholdMs = 50.0;
+    config.framesBefore = 3;
+    config.framesAfter = 2;
+    recorder.setConfig(config);
+
+    Timers worldTimers;
+    Timers serverTimers;
+
+    for (uint64_t step = 0; step < 10; ++step) {
+        const double frameMs = step == 5 ? 80.0 : 10.0;
+        recorder.recordFrame(makeCounters(step, frameMs), worldTimers, serverTimers);
+    }
+
+    ASSERT_EQ(recorder.getCaptures().size(), 1u);
+    const auto& capture = recorder.getCaptures().front();
+    EXPECT_EQ(capture.trigger_timestep, 5u);
+    EXPECT_DOUBLE_EQ(capture.trigger_frame_ms, 80.0);
+    EXPECT_TRUE(capture.file.empty());
+
+    // 3 before + trigger + 2 after.
+    ASSERT_EQ(capture.frames.size(), 6u);
+    EXPECT_EQ(capture.frames.front().timestep, 2u);
+    EXPECT_EQ(capture.frames.back().timestep, 7u);
+    EXPECT_EQ(capture.frames[3].pending_moves, 5u);
+    EXPECT_EQ(capture.frames[3].blocked_transfers, 2u);
+    EXPECT_EQ(capture.frames[3].stage_ms.size(), FlightRecorder::STAGE_COUNT);
+
+    recorder.clearCaptures();
+    EXPECT_TRUE(recorder.getCaptures().empty());
+}
+
+TEST(FlightRecorderTest, StageTimesArePerFrameDeltas)
+{
+    FlightRecorder recorder;
+    FlightRecorder::Config config;
+    config.thresholdMs = 1.0;
+    config.framesBefore = 1;
+    config.framesAfter = 0;
+    recorder.setConfig(config);
+
+    Timers worldTimers;
+    Timers serverTimers;
+
+    // First frame: no stage time. Second frame: process_moves runs for ~5ms.
+    recorder.recordFrame(makeCounters(1, 0.5), worldTimers, serverTimers);
+    worldTimers.startTimer("process_moves");
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    worldTimers.stopTimer("process_moves");
+    recorder.recordFrame(makeCounters(2, 6.0), worldTimers, serverTimers);
+
+    ASSERT_EQ(recorder.getCaptures().size(), 1u);
+    const auto& frames = recorder.getCaptures().front().frames;
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_FLOAT_EQ(frames[0].stage_ms.at("process_moves"), 0.0);
+    EXPECT_GE(frames[1].stage_ms.at("process_moves"), 4.0);
+    EXPECT_FLOAT_EQ(frames[1].stage_ms.at("scenario_tick"), 0.0);
+}
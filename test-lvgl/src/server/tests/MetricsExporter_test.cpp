@@ -0,0 +1,152 @@
+#include "core/Timers.h"
+#include "server/MetricsExporter.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace DirtSim;
+using namespace DirtSim::Server;
+
+TEST(MetricsExporterTest, PublishIsRateLimitedAndOffByDefault)
+{
+    MetricsExporter exporter;
+    const auto now = std::chrono::steady_clock::now();
+    EXPECT_FALSE(exporter.publishDue(now));
+
+    exporter.setEnabled(true);
+    EXPECT_TRUE(exporter.publishDue(now));
+
+    Timers timers;
+    exporter.publish(MetricsExporter::Sample{}, timers, timers, now);
+    EXPECT_FALSE(exporter.publishDue(now + std::chrono::milliseconds(10)));
+    EXPECT_TRUE(exporter.publishDue(now + MetricsExporter::PUBLISH_INTERVAL));
+}
+
+TEST(MetricsExporterTest, SnapshotRoundTripsWithCumulativeBuckets)
+{
+    MetricsExporter exporter;
+    exporter.setEnabled(true);
+
+    Timers worldTimers;
+    Timers serverTimers;
+    for (int i = 0; i < 3; ++i) {
+        serverTimers.startTimer("physics_step");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        serverTimers.stopTimer("physics_step");
+    }
+
+    MetricsExporter::Sample sample;
+    sample.stepsTotal = 42;
+    sample.worldWidth = 100;
+    sample.worldHeight = 50;
+    sample.renderBytesSent = { 1000, 2000 };
+    sample.framesDropped = 7;
+    exporter.publish(sample, worldTimers, serverTimers, std::chrono::steady_clock::now());
+
+    const auto snapshot = exporter.read();
+    EXPECT_EQ(snapshot.sample.stepsTotal, 42u);
+    EXPECT_EQ(snapshot.sample.worldWidth, 100u);
+    EXPECT_EQ(snapshot.sample.renderBytesSent[1], 2000u);
+    EXPECT_EQ(snapshot.sample.framesDropped, 7u);
+
+    const size_t physicsIndex = FlightRecorder::WORLD_STAGES.size();
+    ASSERT_EQ(MetricsExporter::stageName(physicsIndex), "physics_step");
+    const auto& stage = snapshot.stages[physicsIndex];
+    EXPECT_EQ(stage.count, 3u);
+    EXPECT_GT(stage.sumSeconds, 0.005);
+
+    // Sleeps land above 1ms; the 250ms bound holds every call.
+    EXPECT_EQ(stage.buckets[5], 0u);
+    EXPECT_EQ(stage.buckets.back(), 3u);
+    for (size_t b = 1; b < stage.buckets.size(); ++b) {
+        EXPECT_GE(stage.buckets[b], stage.buckets[b - 1]);
+    }
+
+    // Untouched stages stay empty.
+    EXPECT_EQ(snapshot.stages[0].count, 0u);
+}
+
+TEST(MetricsExporterTest, RendersPrometheusText)
+{
+    MetricsExporter exporter;
+    exporter.setEnabled(true);
+
+    Timers timers;
+    MetricsExporter::Sample sample;
+    sample.clients = 2;
+    sample.renderFramesDelivered = { 5, 1 };
+    exporter.publish(sample, timers, timers, std::chrono::steady_clock::now());
+
+    const std::string text = exporter.renderPrometheus();
+    EXPECT_NE(text.find("# TYPE sparkle_duck_stage_duration_seconds histogram"), std::string::npos);
+    EXPECT_NE(text.find("sparkle_duck_clients 2\n"), std::string::npos);
+    EXPECT_NE(
+        text.find("sparkle_duck_frames_delivered_total{format=\"basic\"} 5\n"), std::string::npos);
+    EXPECT_NE(
+        text.find("sparkle_duck_stage_duration_seconds_bucket{stage=\"process_moves\","
+                  "le=\"+Inf\"} 0"),
+        std::string::npos);
+}
+
+TEST(MetricsExporterTest, PauseIsPublishedWithoutATick)
+{
+    MetricsExporter exporter;
+    exporter.setEnabled(true);
+    EXPECT_EQ(exporter.read().publishedUnixSeconds, 0.0);
+
+    Timers timers;
+    MetricsExporter::Sample sample;
+    sample.stepsTotal = 10;
+    sample.stepRate = 60.0;
+    exporter.publish(sample, timers, timers, std::chrono::steady_clock::now());
+    const auto running = exporter.read();
+    EXPECT_FALSE(running.paused);
+    EXPECT_GT(running.publishedUnixSeconds, 0.0);
+
+    // Pausing keeps the counters, zeroes the rate and refreshes the timestamp.
+    exporter.publishPaused(true);
+    const auto paused = exporter.read();
+    EXPECT_TRUE(paused.paused);
+    EXPECT_EQ(paused.sample.stepsTotal, 10u);
+    EXPECT_EQ(paused.sample.stepRate, 0.0);
+    EXPECT_GE(paused.publishedUnixSeconds, running.publishedUnixSeconds);
+
+    const std::string text = exporter.renderPrometheus();
+    EXPECT_NE(text.find("sparkle_duck_paused 1\n"), std::string::npos);
+    EXPECT_NE(text.find("sparkle_duck_step_rate 0\n"), std::string::npos);
+    EXPECT_NE(text.find("sparkle_duck_last_update_timestamp_seconds "), std::string::npos);
+
+    // The next tick clears the flag.
+    exporter.publish(sample, timers, timers, std::chrono::steady_clock::now());
+    EXPECT_FALSE(exporter.read().paused);
+}
+
+TEST(MetricsExporterTest, ConcurrentReadsNeverTear)
+{
+    MetricsExporter exporter;
+    exporter.setEnabled(true);
+    Timers timers;
+
+    std::atomic<bool> done{ false };
+    std::thread reader([&] {
+        while (!done) {
+            const auto snapshot = exporter.read();
+            // Writer keeps these fields equal, so a torn copy would show a mismatch.
+            ASSERT_EQ(snapshot.sample.stepsTotal, snapshot.sample.timestep);
+        }
+    });
+
+    auto now = std::chrono::steady_clock::now();
+    for (uint64_t step = 1; step <= 2000; ++step) {
+        MetricsExporter::Sample sample;
+        sample.stepsTotal = step;
+        sample.timestep = step;
+        now += MetricsExporter::PUBLISH_INTERVAL;
+        exporter.publish(sample, timers, timers, now);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(exporter.read().sample.stepsTotal, 2000u);
+}
@@ -0,0 +1,35 @@
+#include "server/network/OutputFile.h"
+#include <gtest/gtest.h>
+
+using namespace DirtSim::Server;
+
+TEST(OutputFileTest, BareNameResolvesInsideDirectory)
+{
+    const auto result = resolveOutputFile("/var/tmp/traces", "run-1.json", "--trace-dir");
+
+    ASSERT_FALSE(result.isError());
+    EXPECT_EQ(result.value(), std::filesystem::path("/var/tmp/traces/run-1.json"));
+}
+
+TEST(OutputFileTest, RejectsNamesThatLeaveTheDirectory)
+{
+    for (const std::string name : { "/etc/passwd",
+                                    "../escape.json",
+                                    "sub/dir.json",
+                                    "..",
+                                    ".",
+                                    "a..b",
+                                    "..\\escape.json",
+                                    "" }) {
+        const auto result = resolveOutputFile("/var/tmp/traces", name, "--trace-dir");
+        EXPECT_TRUE(result.isError()) << "accepted '" << name << "'";
+    }
+}
+
+TEST(OutputFileTest, RejectsEverythingWithoutConfiguredDirectory)
+{
+    const auto result = resolveOutputFile("", "run-1.json", "--trace-dir");
+
+    ASSERT_TRUE(result.isError());
+    EXPECT_NE(result.errorValue().message.find("--trace-dir"), std::string::npos);
+}
@@ -0,0 +1,128 @@
+#include "core/WorldData.h"
+#include "server/StateMachine.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace DirtSim;
+using namespace DirtSim::Server;
+
+namespace {
+
+WorldData makeWorldData(uint32_t timestep)
+{
+    WorldData data;
+    data.width = 8;
+    data.height = 8;
+    data.cells.resize(64);
+    data.timestep = timestep;
+    data.scenario_id = "sandbox";
+    return data;
+}
+
+} // namespace
+
+TEST(StateMachineSnapshotTest, StatusIsRefreshedWithoutSnapshotRequest)
+{
+    StateMachine sm;
+    EXPECT_FALSE(sm.getCachedStatus().has_value());
+
+    sm.updateCachedWorldData(makeWorldData(7));
+
+    const auto status = sm.getCachedStatus();
+    ASSERT_TRUE(status.has_value());
+    EXPECT_EQ(status->timestep, 7u);
+    EXPECT_EQ(status->scenario_id, "sandbox");
+    EXPECT_EQ(status->width, 8u);
+}
+
+TEST(StateMachineSnapshotTest, ForcedPublishIsReturnedImmediately)
+{
+    StateMachine sm;
+    sm.updateCachedWorldData(makeWorldData(3), true);
+
+    const auto snapshot = sm.getCachedWorldData();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->timestep, 3u);
+    EXPECT_EQ(snapshot->cells.size(), 64u);
+}
+
+TEST(StateMachineSnapshotTest, CurrentSnapshotIsDeliveredImmediately)
+{
+    StateMachine sm;
+    sm.updateCachedWorldData(makeWorldData(4), true);
+
+    std::shared_ptr<const WorldData> snapshot;
+    bool called = false;
+    sm.requestWorldData([&](std::shared_ptr<const WorldData> data) {
+        snapshot = std::move(data);
+        called = true;
+    });
+
+    ASSERT_TRUE(called);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->timestep, 4u);
+}
+
+TEST(StateMachineSnapshotTest, StaleRequestIsCompletedByNextPublish)
+{
+    StateMachine sm;
+    sm.updateCachedWorldData(makeWorldData(1), true);
+    sm.updateCachedWorldData(makeWorldData(2)); // Nobody asked - not materialized.
+
+    // The published snapshot is stale: the request is queued and the caller does not wait.
+    std::shared_ptr<const WorldData> snapshot;
+    bool called = false;
+    sm.requestWorldData([&](std::shared_ptr<const WorldData> data) {
+        snapshot = std::move(data);
+        called = true;
+    });
+    EXPECT_FALSE(called);
+    EXPECT_EQ(sm.getCachedWorldData()->timestep, 1u);
+
+    // The next tick materializes a snapshot and completes the request.
+    sm.updateCachedWorldData(makeWorldData(3));
+    ASSERT_TRUE(called);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->timestep, 3u);
+}
+
+TEST(StateMachineSnapshotTest, RequestFromOtherThreadIsServedByPhysicsThread)
+{
+    StateMachine sm;
+    sm.updateCachedWorldData(makeWorldData(1), true);
+    sm.updateCachedWorldData(makeWorldData(2));
+
+    std::atomic<bool> done{ false };
+    std::atomic<uint32_t> servedTimestep{ 0 };
+    std::thread reader([&] {
+        sm.requestWorldData([&](std::shared_ptr<const WorldData> data) {
+            servedTimestep = data ? data->timestep : 0;
+            done = true;
+        });
+    });
+    reader.join(); // Returns without waiting for a publish.
+
+    // Keep ticking like the physics thread until the request is served.
+    uint32_t timestep = 3;
+    while (!done) {
+        sm.updateCachedWorldData(makeWorldData(timestep++));
+    }
+
+    EXPECT_GE(servedTimestep.load(), 3u);
+}
+
+TEST(StateMachineSnapshotTest, HeldSnapshotIsNeverOverwritten)
+{
+    StateMachine sm;
+    sm.updateCachedWorldData(makeWorldData(1), true);
+    const auto held = sm.getCachedWorldData();
+    ASSERT_NE(held, nullptr);
+
+    for (uint32_t timestep = 2; timestep < 10; ++timestep) {
+        sm.updateCachedWorldData(makeWorldData(timestep), true);
+    }
+
+    EXPECT_EQ(held->timestep, 1u);
+    EXPECT_EQ(sm.getCachedWorldData()->timestep, 9u);
+}
@@ -8,6 +8,7 @@
 #include "server/states/SimRunning.h"
 #include "server/states/State.h"
 #include <gtest/gtest.h>
+#include <limits>
 #include <spdlog/spdlog.h>
 
 using namespace DirtSim;
@@ -591,3 +592,109 @@ TEST_F(StateSimRunningTest, WorldResize_ResizesWorldGrid)
     EXPECT_EQ(simRunning.world->getData().width, 100) << "World width should be resized to 100";
     EXPECT_EQ(simRunning.world->getData().height, 100) << "World height should be resized to 100";
 }
+
+/**
+ * @brief Test that CellsSetBulk applies rects, spans and packed records in one command.
+ */
+TEST_F(StateSimRunningTest, CellsSetBulk_AppliesAllEditKinds)
+{
+    // Setup: Create initialized SimRunning with clean scenario.
+    SimRunning simRunning = createSimRunningWithWorld();
+    applyCleanScenario(simRunning);
+    const uint32_t width = simRunning.world->getData().width;
+
+    // Execute: One command with a 3x2 rect, a 4-cell span and one packed record.
+    Api::CellsSetBulk::Command cmd;
+    cmd.rects.push_back({ .x = 5, .y = 5, .width = 3, .height = 2, .material = MaterialType::DIRT });
+    cmd.spans.push_back(
+        { .x = 10, .y = 12, .length = 4, .material = MaterialType::WATER, .fill = 0.5 });
+    Api::CellsSetBulk::appendPackedCell(
+        cmd.packed,
+        { .index = 20 * width + 14, .material = MaterialType::SAND, .fill = 0.75f });
+
+    // Round-trip through JSON (packed records travel as base64).
+    cmd = Api::CellsSetBulk::Command::fromJson(cmd.toJson());
+
+    uint32_t cellsChanged = 0;
+    Api::CellsSetBulk::Cwc cwc(cmd, [&](Api::CellsSetBulk::Response&& response) {
+        ASSERT_TRUE(response.isValue()) << "CellsSetBulk should succeed";
+        cellsChanged = response.value().cells_changed;
+    });
+    State::Any newState = simRunning.onEvent(cwc, *stateMachine);
+    ASSERT_TRUE(std::holds_alternative<SimRunning>(newState.getVariant()));
+    simRunning = std::move(std::get<SimRunning>(newState.getVariant()));
+
+    // Verify: Every edit landed.
+    const WorldData& data = simRunning.world->getData();
+    EXPECT_EQ(cellsChanged, 11u);
+    EXPECT_EQ(data.at(5, 5).material_type, MaterialType::DIRT);
+    EXPECT_EQ(data.at(7, 6).material_type, MaterialType::DIRT);
+    EXPECT_EQ(data.at(13, 12).material_type, MaterialType::WATER);
+    EXPECT_DOUBLE_EQ(data.at(13, 12).fill_ratio, 0.5);
+    EXPECT_EQ(data.at(14, 20).material_type, MaterialType::SAND);
+    EXPECT_NEAR(data.at(14, 20).fill_ratio, 0.75, 1e-6);
+}
+
+/**
+ * @brief Test that an invalid CellsSetBulk command changes nothing.
+ */
+TEST_F(StateSimRunningTest, CellsSetBulk_RejectsOutOfBoundsAtomically)
+{
+    // Setup: Create initialized SimRunning with clean scenario.
+    SimRunning simRunning = createSimRunningWithWorld();
+    applyCleanScenario(simRunning);
+    const uint32_t width = simRunning.world->getData().width;
+
+    // Execute: A valid rect followed by a rect hanging off the right edge.
+    Api::CellsSetBulk::Command cmd;
+    cmd.rects.push_back({ .x = 5, .y = 5, .width = 2, .height = 2, .material = MaterialType::DIRT });
+    cmd.rects.push_back({ .x = static_cast<int>(width) - 1,
+                          .y = 5,
+                          .width = 2,
+                          .height = 1,
+                          .material = MaterialType::DIRT });
+
+    bool callbackInvoked = false;
+    Api::CellsSetBulk::Cwc cwc(cmd, [&](Api::CellsSetBulk::Response&& response) {
+        callbackInvoked = true;
+        EXPECT_TRUE(response.isError());
+        EXPECT_EQ(response.errorValue().message, "Rect out of bounds");
+    });
+    State::Any newState = simRunning.onEvent(cwc, *stateMachine);
+    ASSERT_TRUE(callbackInvoked);
+    simRunning = std::move(std::get<SimRunning>(newState.getVariant()));
+
+    // Verify: The valid rect was not applied either.
+    EXPECT_EQ(simRunning.world->getData().at(5, 5).material_type, MaterialType::AIR);
+}
+
+/**
+ * @brief Test that rect and span sizes near INT_MAX are rejected instead of overflowing.
+ */
+TEST_F(StateSimRunningTest, CellsSetBulk_RejectsHugeSizes)
+{
+    // Setup: Create initialized SimRunning with clean scenario.
+    SimRunning simRunning = createSimRunningWithWorld();
+    applyCleanScenario(simRunning);
+
+    constexpr int huge = std::numeric_limits<int>::max();
+    std::vector<std::pair<Api::CellsSetBulk::Command, std::string>> cases(4);
+    cases[0].first.rects.push_back({ .x = 1, .y = 1, .width = huge, .height = 1 });
+    cases[1].first.rects.push_back({ .x = 1, .y = 1, .width = 1, .height = huge });
+    cases[2].first.rects.push_back({ .x = 1, .y = 1, .width = huge, .height = huge });
+    cases[3].first.spans.push_back({ .x = 1, .y = 1, .length = huge });
+    cases[0].second = cases[1].second = cases[2].second = "Rect out of bounds";
+    cases[3].second = "Span out of bounds";
+
+    for (const auto& [cmd, expectedError] : cases) {
+        bool callbackInvoked = false;
+        Api::CellsSetBulk::Cwc cwc(cmd, [&](Api::CellsSetBulk::Response&& response) {
+            callbackInvoked = true;
+            ASSERT_TRUE(response.isError());
+            EXPECT_EQ(response.errorValue().message, expectedError);
+        });
+        State::Any newState = simRunning.onEvent(cwc, *stateMachine);
+        ASSERT_TRUE(callbackInvoked);
+        simRunning = std::move(std::get<SimRunning>(newState.getVariant()));
+    }
+}
@@ -0,0 +1,98 @@
+#include "core/AllocationTracker.h"
+#include "core/ScopeTimer.h"
+#include "core/Timers.h"
+#include "core/World.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace DirtSim;
+
+TEST(AllocationTrackerTest, UntrackedBuildReadsZero)
+{
+    if (AllocationTracker::isCompiledIn()) {
+        GTEST_SKIP() << "Built with allocation tracking";
+    }
+
+    Timers timers;
+    {
+        ScopeTimer timer(timers, "alloc_untracked_scope");
+        auto data = std::make_unique<std::vector<int>>(64);
+    }
+
+    EXPECT_EQ(timers.getAllocations("alloc_untracked_scope").allocations, 0u);
+    EXPECT_EQ(AllocationTracker::processCounts().allocations, 0u);
+}
+
+TEST(AllocationTrackerTest, ScopesCountAllocationsAndBytes)
+{
+    if (!AllocationTracker::isCompiledIn()) {
+        GTEST_SKIP() << "Runs in sparkle-duck-tests-alloc";
+    }
+
+    // Interned up front: a name temporary would be freed inside the scope and counted.
+    const Timers::TimerId id = Timers::intern("alloc_tracked_scope");
+    Timers timers;
+    AllocationScope scope;
+    {
+        ScopeTimer timer(timers, id);
+        std::vector<int> values(256);
+        values[0] = 1;
+    }
+
+    const AllocationTracker::Counts stage = timers.getAllocations("alloc_tracked_scope");
+    EXPECT_EQ(stage.allocations, 1u);
+    EXPECT_EQ(stage.bytes, 256 * sizeof(int));
+    EXPECT_EQ(stage.frees, 1u);
+    EXPECT_GE(scope.counts().allocations, 1u);
+}
+
+TEST(AllocationTrackerTest, WorldStepAllocationsMatchAdvanceTimeScope)
+{
+    if (!AllocationTracker::isCompiledIn()) {
+        GTEST_SKIP() << "Runs in sparkle-duck-tests-alloc";
+    }
+
+    World world(20, 20);
+    world.addMaterialAtCell(10, 5, MaterialType::WATER, 1.0);
+    world.advanceTime(0.016); // Let queues and caches reach their steady-state capacity.
+
+    const AllocationTracker::Counts before = world.getTimers().getAllocations("advance_time");
+    AllocationScope step;
+    world.advanceTime(0.016);
+
+    const AllocationTracker::Counts stage =
+        world.getTimers().getAllocations("advance_time") - before;
+    EXPECT_EQ(stage.allocations, step.counts().allocations);
+    EXPECT_EQ(stage.bytes, step.counts().bytes);
+}
+
+TEST(AllocationTrackerTest, SteadyStateStepDoesNotAllocate)
+{
+    if (!AllocationTracker::isCompiledIn()) {
+        GTEST_SKIP() << "Runs in sparkle-duck-tests-alloc";
+    }
+
+    // Large enough for the OpenMP stages to run in parallel.
+    constexpr uint32_t SIZE = 60;
+    constexpr int WARMUP_STEPS = 50;
+    World world(SIZE, SIZE);
+    for (uint32_t x = 2; x < SIZE - 2; ++x) {
+        world.addMaterialAtCell(x, SIZE - 2, MaterialType::DIRT, 1.0);
+        world.addMaterialAtCell(x, SIZE - 4, MaterialType::WATER, 1.0);
+    }
+    world.addMaterialAtCell(SIZE / 2, 3, MaterialType::SAND, 1.0);
+
+    // Warm-up grows every scratch buffer, queue and thread pool to its working size.
+    for (int i = 0; i < WARMUP_STEPS; ++i) {
+        world.advanceTime(0.016);
+    }
+
+    // Process-wide, so allocations on OpenMP workers count too.
+    for (int step = 0; step < 10; ++step) {
+        const AllocationTracker::Counts before = AllocationTracker::processCounts();
+        world.advanceTime(0.016);
+        const AllocationTracker::Counts delta = AllocationTracker::processCounts() - before;
+        EXPECT_EQ(delta.allocations, 0u) << "step " << step << " (" << delta.bytes << " bytes)";
+    }
+}
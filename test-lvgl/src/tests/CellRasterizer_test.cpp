@@ -0,0 +1,263 @@
+#include "core/RenderMessageUtils.h"
+#include "core/WorldData.h"
+#include "ui/rendering/CellRenderer.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace DirtSim;
+using namespace DirtSim::Ui;
+
+namespace {
+
+// The original per-pixel loop: clear, then write each whole cell's border and interior.
+std::vector<uint32_t> referenceRaster(
+    const std::vector<CellShade>& shades,
+    uint32_t worldWidth,
+    uint32_t worldHeight,
+    uint32_t cellSize,
+    uint32_t canvasWidth,
+    uint32_t canvasHeight)
+{
+    std::vector<uint32_t> pixels(canvasWidth * canvasHeight, 0);
+    for (uint32_t y = 0; y < worldHeight; ++y) {
+        for (uint32_t x = 0; x < worldWidth; ++x) {
+            const uint32_t cellX = x * cellSize;
+            const uint32_t cellY = y * cellSize;
+            if (cellX + cellSize > canvasWidth || cellY + cellSize > canvasHeight) continue;
+
+            const CellShade& shade = shades[y * worldWidth + x];
+            for (uint32_t py = 0; py < cellSize; ++py) {
+                for (uint32_t px = 0; px < cellSize; ++px) {
+                    const bool isBorder =
+                        px == 0 || px == cellSize - 1 || py == 0 || py == cellSize - 1;
+                    pixels[(cellY + py) * canvasWidth + cellX + px] =
+                        isBorder ? shade.border : shade.interior;
+                }
+            }
+        }
+    }
+    return pixels;
+}
+
+void rasterizeSquareCells(
+    std::vector<uint32_t>& pixels,
+    uint32_t canvasWidth,
+    uint32_t canvasHeight,
+    const std::vector<CellShade>& shades,
+    uint32_t worldWidth,
+    uint32_t cellSize,
+    uint32_t rowBegin,
+    uint32_t rowEnd)
+{
+    rasterizeCellRows(
+        pixels.data(),
+        canvasWidth,
+        canvasHeight,
+        shades.data(),
+        worldWidth,
+        cellSize,
+        cellSize,
+        rowBegin,
+        rowEnd);
+}
+
+std::vector<CellShade> randomShades(uint32_t count, uint32_t seed = 1234)
+{
+    std::mt19937 rng(seed);
+    std::vector<CellShade> shades(count);
+    for (auto& shade : shades) {
+        shade.border = rng();
+        shade.interior = rng();
+    }
+    return shades;
+}
+
+} // namespace
+
+TEST(CellRasterizerTest, CompositeMatchesAlphaBlendOverBlack)
+{
+    for (uint32_t alpha = 0; alpha < 256; ++alpha) {
+        const uint32_t src = (alpha << 24) | 0x00C08040;
+        const uint32_t expected = alpha == 0
+            ? 0
+            : 0xFF000000 | ((0xC0 * alpha / 255) << 16) | ((0x80 * alpha / 255) << 8)
+                | (0x40 * alpha / 255);
+        EXPECT_EQ(compositeOverBlack(src), expected) << "alpha " << alpha;
+    }
+}
+
+TEST(CellRasterizerTest, TilesMatchPerPixelRaster)
+{
+    const uint32_t worldWidth = 7;
+    const uint32_t worldHeight = 5;
+    const std::vector<CellShade> shades = randomShades(worldWidth * worldHeight);
+
+    for (uint32_t cellSize : { 2u, 3u, 8u }) {
+        const uint32_t canvasWidth = worldWidth * cellSize;
+        const uint32_t canvasHeight = worldHeight * cellSize;
+
+        // Garbage first: tiles must overwrite every pixel without a clear.
+        std::vector<uint32_t> pixels(canvasWidth * canvasHeight, 0xDEADBEEF);
+        rasterizeSquareCells(pixels, canvasWidth, canvasHeight, shades, worldWidth, cellSize, 0, 2);
+        rasterizeSquareCells(
+            pixels, canvasWidth, canvasHeight, shades, worldWidth, cellSize, 2, worldHeight);
+
+        EXPECT_EQ(
+            pixels,
+            referenceRaster(
+                shades, worldWidth, worldHeight, cellSize, canvasWidth, canvasHeight))
+            << "cell size " << cellSize;
+    }
+}
+
+TEST(CellRasterizerTest, CellsPastCanvasEdgeAreTransparent)
+{
+    const uint32_t worldWidth = 4;
+    const uint32_t worldHeight = 3;
+    const uint32_t cellSize = 4;
+    const uint32_t canvasWidth = 14; // Last column only partly fits.
+    const uint32_t canvasHeight = 10; // Last row only partly fits.
+    const std::vector<CellShade> shades = randomShades(worldWidth * worldHeight);
+
+    std::vector<uint32_t> pixels(canvasWidth * canvasHeight, 0xDEADBEEF);
+    rasterizeSquareCells(
+        pixels, canvasWidth, canvasHeight, shades, worldWidth, cellSize, 0, worldHeight);
+
+    EXPECT_EQ(
+        pixels,
+        referenceRaster(shades, worldWidth, worldHeight, cellSize, canvasWidth, canvasHeight));
+}
+
+TEST(CellRasterizerTest, SpanRedrawMatchesFullRaster)
+{
+    const uint32_t worldWidth = 9;
+    const uint32_t worldHeight = 4;
+    const uint32_t cellSize = 3;
+    const uint32_t canvasWidth = worldWidth * cellSize;
+    const uint32_t canvasHeight = worldHeight * cellSize;
+    std::vector<CellShade> shades = randomShades(worldWidth * worldHeight);
+
+    std::vector<uint32_t> pixels(canvasWidth * canvasHeight);
+    rasterizeSquareCells(
+        pixels, canvasWidth, canvasHeight, shades, worldWidth, cellSize, 0, worldHeight);
+
+    // Change cells 2..4 of row 1 and the last cell of row 3, then redraw only those.
+    const std::vector<CellShade> changed = randomShades(worldWidth * worldHeight, 99);
+    for (uint32_t x = 2; x < 5; ++x) {
+        shades[worldWidth + x] = changed[worldWidth + x];
+    }
+    shades[4 * worldWidth - 1] = changed[4 * worldWidth - 1];
+
+    for (const auto& [y, span] : { std::pair{ 1u, CellSpan{ 2, 5 } },
+                                   std::pair{ 3u, CellSpan{ worldWidth - 1, worldWidth } } }) {
+        rasterizeCellSpan(
+            pixels.data(),
+            canvasWidth,
+            canvasHeight,
+            shades.data(),
+            worldWidth,
+            cellSize,
+            cellSize,
+            y,
+            span);
+    }
+
+    EXPECT_EQ(
+        pixels,
+        referenceRaster(shades, worldWidth, worldHeight, cellSize, canvasWidth, canvasHeight));
+}
+
+TEST(CellRasterizerTest, DiffFindsChangedCellsPerRow)
+{
+    WorldData data;
+    data.width = 5;
+    data.height = 3;
+    data.cells.resize(15);
+    data.debug_info.resize(15);
+    data.cells[7].material_type = MaterialType::WATER;
+    data.cells[7].fill_ratio = 0.5;
+
+    for (RenderFormat format : { RenderFormat::BASIC, RenderFormat::DEBUG }) {
+        std::vector<BasicCell> previous;
+        std::vector<CellSpan> dirtyRows;
+
+        // First frame: everything is new.
+        WorldData frameData = data;
+        RenderFrame first(RenderMessageUtils::packRenderMessage(frameData, format));
+        EXPECT_EQ(diffFrameCells(first, previous, dirtyRows), 15u);
+        ASSERT_EQ(dirtyRows.size(), 3u);
+        EXPECT_EQ(dirtyRows[0].begin, 0u);
+        EXPECT_EQ(dirtyRows[0].end, 5u);
+
+        // Same cells again: nothing to redraw.
+        RenderFrame same(RenderMessageUtils::packRenderMessage(frameData, format));
+        EXPECT_EQ(diffFrameCells(same, previous, dirtyRows), 0u);
+        for (const CellSpan& span : dirtyRows) {
+            EXPECT_TRUE(span.empty());
+        }
+
+        // Water falls one row and a cell of the top row fills: two rows change.
+        frameData.cells[7] = Cell();
+        frameData.cells[12].material_type = MaterialType::WATER;
+        frameData.cells[12].fill_ratio = 0.5;
+        frameData.cells[1].material_type = MaterialType::SAND;
+        frameData.cells[1].fill_ratio = 1.0;
+        RenderFrame moved(RenderMessageUtils::packRenderMessage(frameData, format));
+        EXPECT_EQ(diffFrameCells(moved, previous, dirtyRows), 3u);
+        EXPECT_EQ(dirtyRows[0].begin, 1u);
+        EXPECT_EQ(dirtyRows[0].end, 2u);
+        EXPECT_EQ(dirtyRows[1].begin, 2u);
+        EXPECT_EQ(dirtyRows[1].end, 3u);
+        EXPECT_EQ(dirtyRows[2].begin, 2u);
+        EXPECT_EQ(dirtyRows[2].end, 3u);
+    }
+}
+
+TEST(CellRasterizerTest, BilinearFilterMatchesPerPixelBoxAverage)
+{
+    std::mt19937 rng(7);
+    for (const auto& [width, height] : { std::pair{ 37u, 11u }, std::pair{ 2u, 2u } }) {
+        std::vector<uint32_t> src(width * height);
+        for (uint32_t& pixel : src) {
+            pixel = rng();
+        }
+
+        // The original per-pixel filter: per-channel 2x2 average with clamped edges.
+        std::vector<uint32_t> expected(width * height);
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                const uint32_t x1 = std::min(x + 1, width - 1);
+                const uint32_t y1 = std::min(y + 1, height - 1);
+                const uint32_t samples[4] = { src[y * width + x],
+                                              src[y * width + x1],
+                                              src[y1 * width + x],
+                                              src[y1 * width + x1] };
+                uint32_t result = 0;
+                for (uint32_t shift = 0; shift < 32; shift += 8) {
+                    uint32_t sum = 0;
+                    for (uint32_t sample : samples) {
+                        sum += (sample >> shift) & 0xFF;
+                    }
+                    result |= (sum / 4) << shift;
+                }
+                expected[y * width + x] = result;
+            }
+        }
+
+        std::vector<uint32_t> dst(width * height, 0);
+        applyBilinearFilter(src.data(), dst.data(), width, height, 0, 0, width, height);
+        EXPECT_EQ(dst, expected) << width << "x" << height;
+
+        // A sub-rectangle only writes its own pixels.
+        std::vector<uint32_t> partial(width * height, 0);
+        applyBilinearFilter(src.data(), partial.data(), width, height, 1, 1, width, height);
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                const uint32_t idx = y * width + x;
+                EXPECT_EQ(partial[idx], (x >= 1 && y >= 1) ? expected[idx] : 0u);
+            }
+        }
+    }
+}
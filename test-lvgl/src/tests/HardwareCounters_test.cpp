@@ -0,0 +1,89 @@
+#include "core/HardwareCounters.h"
+#include "core/ScopeTimer.h"
+#include "core/Timers.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace {
+
+uint64_t busyWork()
+{
+    volatile uint64_t accumulator = 0;
+    for (int i = 0; i < 2000000; ++i) {
+        accumulator = accumulator * 31 + (i % 7 == 0 ? 1 : 2);
+    }
+    return accumulator;
+}
+
+} // namespace
+
+TEST(HardwareCountersTest, DisabledCountersReadZero)
+{
+    HardwareCounters::disable();
+
+    Timers timers;
+    {
+        ScopeTimer timer(timers, "hw_disabled_scope");
+        busyWork();
+    }
+
+    const auto counters = timers.getHardwareCounters("hw_disabled_scope");
+    EXPECT_EQ(counters[HardwareCounters::Cycles], 0u);
+    EXPECT_EQ(counters[HardwareCounters::Instructions], 0u);
+    EXPECT_EQ(timers.getHardwareCounters("hw_unknown_scope")[HardwareCounters::Cycles], 0u);
+}
+
+TEST(HardwareCountersTest, TimerScopesAccumulateCounters)
+{
+    if (!HardwareCounters::enable()) {
+        GTEST_SKIP() << "perf_event_open unavailable in this environment";
+    }
+    if (!HardwareCounters::isAvailable(HardwareCounters::Instructions)) {
+        HardwareCounters::disable();
+        GTEST_SKIP() << "Instruction counter unavailable in this environment";
+    }
+
+    Timers timers;
+    timers.setHardwareCountersEnabled(true);
+    {
+        ScopeTimer timer(timers, "hw_busy_scope");
+        busyWork();
+    }
+    const auto counters = timers.getHardwareCounters("hw_busy_scope");
+    HardwareCounters::disable();
+
+    // The loop alone retires several instructions per iteration.
+    EXPECT_GT(counters[HardwareCounters::Instructions], 2000000u);
+}
+
+TEST(HardwareCountersTest, OnlyOptedInTimersOnOwningThreadCount)
+{
+    if (!HardwareCounters::enable()) {
+        GTEST_SKIP() << "perf_event_open unavailable in this environment";
+    }
+
+    // Timers that did not opt in never read the counters.
+    Timers plain;
+    {
+        ScopeTimer timer(plain, "hw_plain_scope");
+        busyWork();
+    }
+    EXPECT_EQ(plain.getHardwareCounters("hw_plain_scope")[HardwareCounters::Cycles], 0u);
+
+    // Another thread does not own the counters, so it reads zeros instead of their totals.
+    HardwareCounters::Values offThread = { 1, 1, 1, 1 };
+    std::thread other([&offThread] {
+        Timers timers;
+        timers.setHardwareCountersEnabled(true);
+        {
+            ScopeTimer timer(timers, "hw_other_thread_scope");
+            busyWork();
+        }
+        offThread = timers.getHardwareCounters("hw_other_thread_scope");
+    });
+    other.join();
+    HardwareCounters::disable();
+
+    EXPECT_EQ(offThread, HardwareCounters::Values{});
+}
@@ -0,0 +1,68 @@
+#include "core/ReflectSerializer.h"
+#include "core/WorldData.h"
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace DirtSim;
+
+namespace {
+
+WorldData makeWorldData()
+{
+    WorldData data;
+    data.width = 3;
+    data.height = 2;
+    data.cells.resize(6);
+    data.debug_info.resize(6);
+    data.cells[1].material_type = MaterialType::WATER;
+    data.cells[1].fill_ratio = 0.75;
+    data.cells[1].velocity = { 0.1, -2.5 };
+    data.cells[4].material_type = MaterialType::DIRT;
+    data.cells[4].organism_id = 7;
+    data.timestep = 42;
+    data.removed_mass = 1.0;
+    data.scenario_id = "sandbox";
+    data.scenario_config = SandboxConfig{};
+    data.tree_vision = TreeSensoryData{};
+    data.tree_vision->current_thought = "grow \"up\"\n";
+    return data;
+}
+
+} // namespace
+
+TEST(ReflectSerializerTest, StreamedWorldDataMatchesDom)
+{
+    const WorldData data = makeWorldData();
+
+    const nlohmann::json streamed = nlohmann::json::parse(ReflectSerializer::to_json_string(data));
+
+    EXPECT_EQ(streamed, ReflectSerializer::to_json(data));
+}
+
+TEST(ReflectSerializerTest, StreamedWorldDataRoundTrips)
+{
+    const WorldData data = makeWorldData();
+
+    const WorldData decoded =
+        nlohmann::json::parse(ReflectSerializer::to_json_string(data)).get<WorldData>();
+
+    ASSERT_EQ(decoded.cells.size(), data.cells.size());
+    EXPECT_EQ(decoded.cells[1].material_type, MaterialType::WATER);
+    EXPECT_DOUBLE_EQ(decoded.cells[1].fill_ratio, 0.75);
+    EXPECT_DOUBLE_EQ(decoded.cells[1].velocity.y, -2.5);
+    EXPECT_EQ(decoded.cells[4].organism_id, 7u);
+    EXPECT_EQ(decoded.timestep, 42u);
+    ASSERT_TRUE(decoded.tree_vision.has_value());
+    EXPECT_EQ(decoded.tree_vision->current_thought, "grow \"up\"\n");
+}
+
+TEST(ReflectSerializerTest, StreamedScalarsMatchNlohmann)
+{
+    EXPECT_EQ(ReflectSerializer::to_json_string(1.0), "1.0");
+    EXPECT_EQ(ReflectSerializer::to_json_string(-0.5), "-0.5");
+    EXPECT_EQ(ReflectSerializer::to_json_string(std::numeric_limits<double>::infinity()), "null");
+    EXPECT_EQ(ReflectSerializer::to_json_string(true), "true");
+    EXPECT_EQ(ReflectSerializer::to_json_string(std::string("a\tb\x01")), "\"a\\tb\\u0001\"");
+    EXPECT_EQ(ReflectSerializer::to_json_string(std::optional<int>{}), "null");
+    EXPECT_EQ(ReflectSerializer::to_json_string(MaterialType::SAND), "\"SAND\"");
+}
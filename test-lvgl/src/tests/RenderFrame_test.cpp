@@ -0,0 +1,86 @@
+#include "core/RenderFrame.h"
+#include "core/RenderMessageUtils.h"
+#include "core/WorldData.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using namespace DirtSim;
+
+namespace {
+
+WorldData makeWorldData()
+{
+    WorldData data;
+    data.width = 3;
+    data.height = 2;
+    data.cells.resize(6);
+    data.debug_info.resize(6);
+    data.cells[1].material_type = MaterialType::WATER;
+    data.cells[1].fill_ratio = 0.75;
+    data.cells[1].com = { 0.5, -0.25 };
+    data.cells[1].velocity = { 1.0, -2.5 };
+    data.cells[4].material_type = MaterialType::DIRT;
+    data.cells[4].fill_ratio = 1.0;
+    data.timestep = 42;
+    data.fps_server = 60.0;
+    data.scenario_id = "sandbox";
+    data.scenario_config = SandboxConfig{};
+    data.tree_vision = TreeSensoryData{};
+    return data;
+}
+
+} // namespace
+
+TEST(RenderFrameTest, BasicFrameReadsCellsFromPayload)
+{
+    const WorldData data = makeWorldData();
+    const RenderFrame frame(RenderMessageUtils::packRenderMessage(data, RenderFormat::BASIC));
+
+    EXPECT_FALSE(frame.isDebug());
+    EXPECT_EQ(frame.width(), 3u);
+    EXPECT_EQ(frame.height(), 2u);
+    EXPECT_EQ(frame.cellCount(), 6u);
+    EXPECT_EQ(frame.timestep(), 42u);
+    EXPECT_EQ(frame.scenarioId(), "sandbox");
+    EXPECT_TRUE(frame.treeVision().has_value());
+
+    EXPECT_EQ(frame.materialAt(1), MaterialType::WATER);
+    EXPECT_EQ(frame.fillAt(1), 191);
+    EXPECT_NEAR(frame.fillRatioAt(1), 0.75, 1.0 / 255.0);
+    EXPECT_EQ(frame.materialAt(4), MaterialType::DIRT);
+    EXPECT_EQ(frame.fillAt(4), 255);
+    EXPECT_EQ(frame.fillAt(0), 0);
+
+    // BASIC frames carry no physics; decoding leaves those fields at zero.
+    const auto cell = frame.decodeAt(1);
+    EXPECT_EQ(cell.material_type, MaterialType::WATER);
+    EXPECT_DOUBLE_EQ(cell.com.x, 0.0);
+    EXPECT_DOUBLE_EQ(cell.velocity.y, 0.0);
+}
+
+TEST(RenderFrameTest, FromWorldDataKeepsDebugFields)
+{
+    const WorldData data = makeWorldData();
+    const auto frame = RenderFrame::fromWorldData(data);
+
+    ASSERT_TRUE(frame);
+    EXPECT_TRUE(frame->isDebug());
+    EXPECT_DOUBLE_EQ(frame->fpsServer(), 60.0);
+    EXPECT_EQ(frame->materialAt(1), MaterialType::WATER);
+
+    const auto cell = frame->decodeAt(1);
+    EXPECT_NEAR(cell.fill_ratio, 0.75, 1.0 / 255.0);
+    EXPECT_NEAR(cell.com.x, 0.5, 1e-4);
+    EXPECT_NEAR(cell.com.y, -0.25, 1e-4);
+    EXPECT_NEAR(cell.velocity.x, 1.0, 1e-3);
+    EXPECT_NEAR(cell.velocity.y, -2.5, 1e-3);
+}
+
+TEST(RenderFrameTest, ShortPayloadThrows)
+{
+    RenderMessage message =
+        RenderMessageUtils::packRenderMessage(makeWorldData(), RenderFormat::DEBUG);
+    message.payload.resize(message.payload.size() - 1);
+
+    EXPECT_THROW(RenderFrame{ std::move(message) }, std::invalid_argument);
+}
@@ -0,0 +1,106 @@
+#include "core/SamplingProfiler.h"
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// Keep the CPU busy so ITIMER_PROF fires.
+uint64_t burnCpu(std::chrono::milliseconds duration)
+{
+    volatile uint64_t accumulator = 0;
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 0; i < 1000; ++i) {
+            accumulator = accumulator * 31 + i;
+        }
+    }
+    return accumulator;
+}
+
+void userProfHandler(int)
+{}
+
+struct sigaction currentProfAction()
+{
+    struct sigaction action = {};
+    ::sigaction(SIGPROF, nullptr, &action);
+    return action;
+}
+
+} // namespace
+
+TEST(SamplingProfilerTest, SamplesBusyThreadAsFoldedStacks)
+{
+    ASSERT_TRUE(SamplingProfiler::start(1000));
+    EXPECT_FALSE(SamplingProfiler::start(1000));
+    EXPECT_TRUE(SamplingProfiler::isRunning());
+
+    burnCpu(std::chrono::milliseconds(200));
+
+    const SamplingProfiler::Summary summary = SamplingProfiler::stop();
+    EXPECT_FALSE(SamplingProfiler::isRunning());
+    EXPECT_GT(summary.samples, 10u);
+    EXPECT_GT(summary.stacks, 0u);
+
+    // Every line is "frame;frame;... count", and the counts add up to the samples.
+    std::istringstream folded(SamplingProfiler::exportFolded());
+    std::string line;
+    uint64_t total = 0;
+    while (std::getline(folded, line)) {
+        const size_t space = line.rfind(' ');
+        ASSERT_NE(space, std::string::npos) << line;
+        EXPECT_NE(line.find(';'), std::string::npos) << line;
+        total += std::stoull(line.substr(space + 1));
+    }
+    EXPECT_EQ(total, summary.samples);
+}
+
+TEST(SamplingProfilerTest, StopWithoutStartIsHarmless)
+{
+    EXPECT_FALSE(SamplingProfiler::isRunning());
+    SamplingProfiler::stop();
+
+    // A later profile still works after the handler was removed.
+    ASSERT_TRUE(SamplingProfiler::start());
+    burnCpu(std::chrono::milliseconds(50));
+    SamplingProfiler::stop();
+    EXPECT_FALSE(SamplingProfiler::isRunning());
+}
+
+TEST(SamplingProfilerTest, StopRestoresPreviousActionExactly)
+{
+    struct sigaction original = currentProfAction();
+
+    // A user handler comes back with its flags.
+    struct sigaction user = {};
+    user.sa_handler = userProfHandler;
+    user.sa_flags = SA_NODEFER;
+    sigemptyset(&user.sa_mask);
+    ASSERT_EQ(::sigaction(SIGPROF, &user, nullptr), 0);
+
+    ASSERT_TRUE(SamplingProfiler::start());
+    burnCpu(std::chrono::milliseconds(20));
+    SamplingProfiler::stop();
+
+    struct sigaction restored = currentProfAction();
+    EXPECT_EQ(restored.sa_handler, userProfHandler);
+    EXPECT_EQ(restored.sa_flags & SA_NODEFER, SA_NODEFER);
+
+    // SIG_DFL comes back as SIG_DFL, not SIG_IGN.
+    struct sigaction defaults = {};
+    defaults.sa_handler = SIG_DFL;
+    sigemptyset(&defaults.sa_mask);
+    ASSERT_EQ(::sigaction(SIGPROF, &defaults, nullptr), 0);
+
+    ASSERT_TRUE(SamplingProfiler::start());
+    burnCpu(std::chrono::milliseconds(20));
+    SamplingProfiler::stop();
+
+    EXPECT_EQ(currentProfAction().sa_handler, SIG_DFL);
+
+    ::sigaction(SIGPROF, &original, nullptr);
+}
@@ -1,5 +1,6 @@
 #include "core/Timers.h"
 #include <cassert>
+#include <chrono>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <spdlog/spdlog.h>
@@ -118,3 +119,70 @@ TEST(TimersTest, ResetTimer)
     EXPECT_GE(elapsed, 100.0);
     EXPECT_LT(elapsed, 200.0);
 }
+
+TEST(TimersTest, InternedIdSharesSlotWithName)
+{
+    Timers timers;
+    const Timers::TimerId id = Timers::intern("interned_test");
+    EXPECT_EQ(Timers::intern("interned_test"), id);
+    EXPECT_EQ(Timers::nameOf(id), "interned_test");
+
+    timers.startTimer(id);
+    timers.stopTimer(id);
+    timers.startTimer("interned_test");
+    timers.stopTimer("interned_test");
+
+    EXPECT_TRUE(timers.hasTimer("interned_test"));
+    EXPECT_EQ(timers.getCallCount("interned_test"), 2u);
+}
+
+TEST(TimersTest, UnusedInternedTimerIsNotReported)
+{
+    Timers timers;
+    Timers::intern("registered_but_unused");
+
+    EXPECT_FALSE(timers.hasTimer("registered_but_unused"));
+    EXPECT_EQ(timers.stopTimer("registered_but_unused"), -1.0);
+    EXPECT_TRUE(timers.getAllTimerNames().empty());
+}
+
+TEST(TimersTest, NameInternedAfterConstructionGetsSlot)
+{
+    Timers timers;
+    const Timers::TimerId used = Timers::intern("used_before_late_name");
+    timers.startTimer(used);
+    timers.stopTimer(used);
+
+    const Timers::TimerId late = Timers::intern("interned_after_construction");
+    timers.startTimer(late);
+    timers.stopTimer(late);
+
+    EXPECT_EQ(timers.getCallCount("used_before_late_name"), 1u);
+    EXPECT_EQ(timers.getCallCount("interned_after_construction"), 1u);
+    EXPECT_EQ(timers.getAllTimerNames().size(), 2u);
+
+    // Copies carry the sparse index along with the timers.
+    const Timers copy = timers;
+    EXPECT_EQ(copy.getCallCount("interned_after_construction"), 1u);
+}
+
+TEST(TimersTest, PercentilesTrackSpikes)
+{
+    Timers timers;
+
+    // 99 short calls and one long one: p50 stays small, max catches the spike.
+    for (int i = 0; i < 99; ++i) {
+        timers.startTimer("spiky");
+        timers.stopTimer("spiky");
+    }
+    timers.startTimer("spiky");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    timers.stopTimer("spiky");
+
+    const auto p = timers.getPercentiles("spiky");
+    EXPECT_LT(p.p50_ms, 1.0);
+    EXPECT_GE(p.max_ms, 20.0);
+    EXPECT_LE(p.p50_ms, p.p90_ms);
+    EXPECT_LE(p.p90_ms, p.p99_ms);
+    EXPECT_LE(p.p99_ms, p.max_ms);
+}
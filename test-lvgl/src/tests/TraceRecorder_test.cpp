@@ -0,0 +1,158 @@
+#include "core/ScopeTimer.h"
+#include "core/Timers.h"
+#include "core/TraceRecorder.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Count "B"/"E" events for a timer name in an exported trace.
+int countEvents(const nlohmann::json& trace, const std::string& name, const std::string& phase)
+{
+    int count = 0;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["name"] == name && event["ph"] == phase) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(TraceRecorderTest, RecordsTimerScopesFromAllThreads)
+{
+    ASSERT_TRUE(TraceRecorder::start(1024));
+    EXPECT_FALSE(TraceRecorder::start(1024));
+
+    Timers mainTimers;
+    {
+        ScopeTimer timer(mainTimers, "trace_main_scope");
+    }
+    std::thread worker([] {
+        Timers workerTimers;
+        ScopeTimer timer(workerTimers, "trace_worker_scope");
+    });
+    worker.join();
+
+    const TraceRecorder::Summary summary = TraceRecorder::stop();
+    EXPECT_EQ(summary.recorded, 4u);
+    EXPECT_EQ(summary.dropped, 0u);
+
+    const nlohmann::json trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(countEvents(trace, "trace_main_scope", "B"), 1);
+    EXPECT_EQ(countEvents(trace, "trace_main_scope", "E"), 1);
+    EXPECT_EQ(countEvents(trace, "trace_worker_scope", "B"), 1);
+    EXPECT_EQ(countEvents(trace, "trace_worker_scope", "E"), 1);
+}
+
+TEST(TraceRecorderTest, NothingRecordedWhileStopped)
+{
+    ASSERT_TRUE(TraceRecorder::start(16));
+    TraceRecorder::stop();
+
+    Timers timers;
+    {
+        ScopeTimer timer(timers, "trace_after_stop");
+    }
+
+    const nlohmann::json trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(countEvents(trace, "trace_after_stop", "B"), 0);
+}
+
+TEST(TraceRecorderTest, RingKeepsNewestEventsAndDropsOrphanEnds)
+{
+    ASSERT_TRUE(TraceRecorder::start(8));
+    EXPECT_EQ(TraceRecorder::capacity(), 8u);
+
+    // 5 scopes = 10 events into an 8-slot ring: the first scope's begin and end are lost.
+    Timers timers;
+    const Timers::TimerId id = Timers::intern("trace_ring_scope");
+    for (int i = 0; i < 5; ++i) {
+        ScopeTimer timer(timers, id);
+    }
+
+    const TraceRecorder::Summary summary = TraceRecorder::stop();
+    EXPECT_EQ(summary.recorded, 10u);
+    EXPECT_EQ(summary.dropped, 2u);
+
+    const nlohmann::json trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(countEvents(trace, "trace_ring_scope", "B"), 4);
+    EXPECT_EQ(countEvents(trace, "trace_ring_scope", "E"), 4);
+}
+
+TEST(TraceRecorderTest, WritersLappingTheRingKeepEventsWhole)
+{
+    ASSERT_TRUE(TraceRecorder::start(16));
+
+    // Each thread times its own name, so any event mixing two writers' fields shows up as a
+    // thread ID paired with another thread's name.
+    constexpr int THREADS = 4;
+    constexpr int SCOPES = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < THREADS; ++t) {
+        workers.emplace_back([t] {
+            Timers timers;
+            const Timers::TimerId id = Timers::intern("trace_lap_" + std::to_string(t));
+            for (int i = 0; i < SCOPES; ++i) {
+                ScopeTimer timer(timers, id);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    const TraceRecorder::Summary summary = TraceRecorder::stop();
+    EXPECT_EQ(summary.recorded, uint64_t{ THREADS * SCOPES * 2 });
+
+    const nlohmann::json trace = TraceRecorder::exportChromeTrace();
+    std::map<uint32_t, std::string> nameByTid;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "M") {
+            continue;
+        }
+        const std::string name = event["name"];
+        const auto [it, inserted] = nameByTid.try_emplace(event["tid"].get<uint32_t>(), name);
+        EXPECT_EQ(it->second, name);
+    }
+    EXPECT_FALSE(nameByTid.empty());
+}
+
+TEST(TraceRecorderTest, WorkerScopesDoNotDuplicateEnclosingTimer)
+{
+    ASSERT_TRUE(TraceRecorder::start(1024));
+
+    Timers timers;
+    const Timers::TimerId id = Timers::intern("trace_parallel_scope");
+    int teamSize = 1;
+    {
+        ScopeTimer timer(timers, id);
+#ifdef _OPENMP
+#pragma omp parallel num_threads(4)
+#endif
+        {
+            TraceScope workerTrace(id);
+#ifdef _OPENMP
+#pragma omp single
+            teamSize = omp_get_num_threads();
+#endif
+        }
+    }
+
+    TraceRecorder::stop();
+
+    // One slice from the timer, plus one per worker other than the primary thread.
+    const nlohmann::json trace = TraceRecorder::exportChromeTrace();
+    EXPECT_EQ(countEvents(trace, "trace_parallel_scope", "B"), teamSize);
+    EXPECT_EQ(countEvents(trace, "trace_parallel_scope", "E"), teamSize);
+}
@@ -82,45 +82,45 @@ SimPlayground::~SimPlayground()
     spdlog::info("SimPlayground: Destroyed");
 }
 
-void SimPlayground::updateFromWorldData(const WorldData& data, double uiFPS)
+void SimPlayground::updateFromFrame(const RenderFrame& frame, double uiFPS)
 {
     // Update stats display.
-    coreControls_->updateStats(data.fps_server, uiFPS);
+    coreControls_->updateStats(frame.fpsServer(), uiFPS);
 
     // Handle scenario changes.
-    if (data.scenario_id != currentScenarioId_) {
-        spdlog::info("SimPlayground: Scenario changed to '{}'", data.scenario_id);
+    if (frame.scenarioId() != currentScenarioId_) {
+        spdlog::info("SimPlayground: Scenario changed to '{}'", frame.scenarioId());
 
         // Clear old scenario controls.
         sandboxControls_.reset();
 
         // Create new scenario controls based on scenario type.
-        if (data.scenario_id == "sandbox") {
+        if (frame.scenarioId() == "sandbox") {
             lv_obj_t* scenarioContainer = uiManager_->getScenarioControlsContainer();
-            const SandboxConfig& config = std::get<SandboxConfig>(data.scenario_config);
+            const SandboxConfig& config = std::get<SandboxConfig>(frame.scenarioConfig());
             sandboxControls_ =
                 std::make_unique<SandboxControls>(scenarioContainer, wsClient_, config);
         }
         // TODO: Add other scenario control creators here.
 
-        currentScenarioId_ = data.scenario_id;
+        currentScenarioId_ = frame.scenarioId();
     }
 
     // Always update controls with latest config (idempotent, detects changes internally).
-    if (data.scenario_id == "sandbox" && sandboxControls_
-        && std::holds_alternative<SandboxConfig>(data.scenario_config)) {
-        const SandboxConfig& config = std::get<SandboxConfig>(data.scenario_config);
+    if (frame.scenarioId() == "sandbox" && sandboxControls_
+        && std::holds_alternative<SandboxConfig>(frame.scenarioConfig())) {
+        const SandboxConfig& config = std::get<SandboxConfig>(frame.scenarioConfig());
         sandboxControls_->updateFromConfig(config);
-        sandboxControls_->updateWorldDimensions(data.width, data.height);
+        sandboxControls_->updateWorldDimensions(frame.width(), frame.height());
     }
 }
 
-void SimPlayground::render(const WorldData& data, bool debugDraw)
+void SimPlayground::render(const RenderFrame& frame, bool debugDraw)
 {
     lv_obj_t* worldContainer = uiManager_->getWorldDisplayArea();
 
     // Render world state (CellRenderer handles initialization/resize internally).
-    renderer_->renderWorldData(data, worldContainer, debugDraw, renderMode_);
+    renderer_->renderFrame(frame, worldContainer, debugDraw, renderMode_);
 }
 
 void SimPlayground::setRenderMode(RenderMode mode)
@@ -135,15 +135,15 @@ void SimPlayground::setRenderMode(RenderMode mode)
     spdlog::info("SimPlayground: Render mode set to {}", renderModeToString(mode));
 }
 
-void SimPlayground::renderNeuralGrid(const WorldData& data)
+void SimPlayground::renderNeuralGrid(const RenderFrame& frame)
 {
     lv_obj_t* neuralGridContainer = uiManager_->getNeuralGridDisplayArea();
 
     // Adjust layout based on plant presence.
-    if (data.tree_vision.has_value()) {
+    if (frame.treeVision().has_value()) {
         // Plant exists: 50/50 split.
         uiManager_->setDisplayAreaRatio(1, 1);
-        neuralGridRenderer_->renderSensoryData(data.tree_vision.value(), neuralGridContainer);
+        neuralGridRenderer_->renderSensoryData(frame.treeVision().value(), neuralGridContainer);
     }
     else {
         // No plant: 90/10 split (world gets more space).
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "core/WorldData.h"
+#include "core/RenderFrame.h"
 #include "ui/rendering/RenderMode.h"
 #include <memory>
 
@@ -36,15 +36,15 @@ public:
     ~SimPlayground();
 
     /**
-     * @brief Update UI from world data.
+     * @brief Update UI from a received frame.
      * @param uiFPS Current UI frame rate for display.
      */
-    void updateFromWorldData(const WorldData& data, double uiFPS = 0.0);
+    void updateFromFrame(const RenderFrame& frame, double uiFPS = 0.0);
 
     /**
      * @brief Render world state.
      */
-    void render(const WorldData& data, bool debugDraw);
+    void render(const RenderFrame& frame, bool debugDraw);
 
     /**
      * @brief Set render mode and update UI dropdown.
@@ -58,9 +58,9 @@ public:
 
     /**
      * @brief Render neural grid (tree vision).
-     * @param data World data containing tree information.
+     * @param frame Frame containing tree information.
      */
-    void renderNeuralGrid(const WorldData& data);
+    void renderNeuralGrid(const RenderFrame& frame);
 
     /**
      * @brief Get physics controls for settings updates.
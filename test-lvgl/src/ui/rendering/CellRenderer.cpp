@@ -6,6 +6,7 @@
 #include <cstring> // for std::memcpy
 #include <new>     // for std::bad_alloc
 #include <spdlog/spdlog.h>
+#include <thread>
 
 namespace DirtSim {
 namespace Ui {
@@ -13,6 +14,15 @@ namespace Ui {
 // Compile-time toggle for dithering in pixel renderer.
 constexpr bool ENABLE_DITHERING = false;
 
+// Pixel rasterizer threads: n/2 cores capped at 8 (as for JuliaFractal), at least 1.
+const int RASTER_THREADS = []() {
+    const int threads = static_cast<int>(std::thread::hardware_concurrency() / 2);
+    return std::clamp(threads, 1, 8);
+}();
+
+// Canvases smaller than this are rasterized on the calling thread.
+constexpr size_t PARALLEL_RASTER_MIN_PIXELS = 256 * 256;
+
 // Mode-specific pixels per cell for optimal quality.
 constexpr uint32_t MIN_PIXELS_PER_CELL_SHARP = 8;  // Less GPU scaling = sharper.
 constexpr uint32_t MIN_PIXELS_PER_CELL_SMOOTH = 3; // More GPU scaling + bilinear filter.
@@ -64,6 +74,200 @@ void drawLineBresenham(
     }
 }
 
+uint32_t compositeOverBlack(uint32_t argb)
+{
+    const uint32_t alpha = argb >> 24;
+    if (alpha == 0) {
+        return 0;
+    }
+
+    // Same integer blend as src * alpha + dst * (1 - alpha) with dst = black.
+    const uint32_t r = ((argb >> 16) & 0xFF) * alpha / 255;
+    const uint32_t g = ((argb >> 8) & 0xFF) * alpha / 255;
+    const uint32_t b = (argb & 0xFF) * alpha / 255;
+    return 0xFF000000 | (r << 16) | (g << 8) | b;
+}
+
+// Solid span fill; vectorizes to wide stores.
+static inline void fillSpan(uint32_t* dst, uint32_t count, uint32_t color)
+{
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (uint32_t i = 0; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+
+// Part of one canvas row through cells [cellBegin, cellEnd) of a cell row: border rows are a
+// solid span per cell, interior rows are border pixel, interior span, border pixel. When the
+// span reaches the last whole cell, the pixels past it are cleared.
+static void shadeCanvasRow(
+    uint32_t* row,
+    uint32_t canvasWidth,
+    const CellShade* shades,
+    uint32_t cellBegin,
+    uint32_t cellEnd,
+    uint32_t cells,
+    uint32_t cellWidth,
+    bool borderRow)
+{
+    const uint32_t last = std::min(cellEnd, cells);
+    uint32_t px = cellBegin * cellWidth;
+    if (borderRow || cellWidth < 3) {
+        for (uint32_t x = cellBegin; x < last; ++x, px += cellWidth) {
+            fillSpan(row + px, cellWidth, shades[x].border);
+        }
+    }
+    else {
+        for (uint32_t x = cellBegin; x < last; ++x, px += cellWidth) {
+            row[px] = shades[x].border;
+            fillSpan(row + px + 1, cellWidth - 2, shades[x].interior);
+            row[px + cellWidth - 1] = shades[x].border;
+        }
+    }
+    if (cellEnd >= cells) {
+        fillSpan(row + px, canvasWidth - px, 0);
+    }
+}
+
+// Ordered dithering of raw ARGB pixels [x0, x1) of a row: partial alpha becomes fully on or off.
+static void ditherCanvasRow(uint32_t* row, uint32_t x0, uint32_t x1, uint32_t canvasY)
+{
+    for (uint32_t x = x0; x < x1; ++x) {
+        const uint32_t alpha = row[x] >> 24;
+        if (alpha == 0) {
+            row[x] = 0;
+        }
+        else if (alpha != 255) {
+            // Compare alpha to the Bayer threshold (scaled 0-255 to 0-15).
+            const int bayerThreshold = BAYER_MATRIX_4X4[canvasY % 4][x % 4];
+            row[x] = (static_cast<int>(alpha * 16 / 256) > bayerThreshold)
+                ? 0xFF000000 | (row[x] & 0x00FFFFFF)
+                : 0;
+        }
+    }
+}
+
+void rasterizeCellSpan(
+    uint32_t* pixels,
+    uint32_t canvasWidth,
+    uint32_t canvasHeight,
+    const CellShade* shades,
+    uint32_t worldWidth,
+    uint32_t cellWidth,
+    uint32_t cellHeight,
+    uint32_t y,
+    CellSpan span)
+{
+    if (cellWidth == 0 || cellHeight == 0 || span.empty()) return;
+
+    const uint32_t top = y * cellHeight;
+    if (top >= canvasHeight) return;
+
+    // Cells that do not fit entirely on the canvas are left transparent.
+    const uint32_t cells = std::min(worldWidth, canvasWidth / cellWidth);
+    const uint32_t cellBegin = std::min(span.begin, cells);
+    const uint32_t x0 = cellBegin * cellWidth;
+    const uint32_t x1 = span.end >= cells ? canvasWidth : span.end * cellWidth;
+
+    uint32_t* rows = pixels + static_cast<size_t>(top) * canvasWidth;
+    if (top + cellHeight > canvasHeight) {
+        for (uint32_t py = 0; py < canvasHeight - top; ++py) {
+            fillSpan(rows + static_cast<size_t>(py) * canvasWidth + x0, x1 - x0, 0);
+        }
+        return;
+    }
+
+    const CellShade* rowShades = shades + static_cast<size_t>(y) * worldWidth;
+    for (uint32_t py = 0; py < cellHeight; ++py) {
+        uint32_t* row = rows + static_cast<size_t>(py) * canvasWidth;
+        const bool borderRow = (py == 0 || py == cellHeight - 1);
+
+        if constexpr (ENABLE_DITHERING) {
+            shadeCanvasRow(
+                row, canvasWidth, rowShades, cellBegin, span.end, cells, cellWidth, borderRow);
+            ditherCanvasRow(row, x0, x1, top + py);
+        }
+        else if (py <= 1) {
+            // First border row and first interior row are shaded; the rest are copies.
+            shadeCanvasRow(
+                row, canvasWidth, rowShades, cellBegin, span.end, cells, cellWidth, borderRow);
+        }
+        else {
+            const uint32_t* source = borderRow ? rows : rows + canvasWidth;
+            std::memcpy(row + x0, source + x0, (x1 - x0) * sizeof(uint32_t));
+        }
+    }
+}
+
+void rasterizeCellRows(
+    uint32_t* pixels,
+    uint32_t canvasWidth,
+    uint32_t canvasHeight,
+    const CellShade* shades,
+    uint32_t worldWidth,
+    uint32_t cellWidth,
+    uint32_t cellHeight,
+    uint32_t rowBegin,
+    uint32_t rowEnd)
+{
+    for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+        rasterizeCellSpan(
+            pixels,
+            canvasWidth,
+            canvasHeight,
+            shades,
+            worldWidth,
+            cellWidth,
+            cellHeight,
+            y,
+            CellSpan{ 0, worldWidth });
+    }
+}
+
+size_t diffFrameCells(
+    const RenderFrame& frame, std::vector<BasicCell>& previous, std::vector<CellSpan>& dirtyRows)
+{
+    const uint32_t width = frame.width();
+    const uint32_t height = frame.height();
+    dirtyRows.assign(height, CellSpan{});
+
+    // No material has value 0xFF, so after a size change every cell compares as changed.
+    if (previous.size() != frame.cellCount()) {
+        previous.assign(frame.cellCount(), BasicCell{ 0xFF, 0 });
+    }
+
+    const BasicCell* basic = frame.basicPayload();
+    size_t changed = 0;
+    for (uint32_t y = 0; y < height; ++y) {
+        const size_t rowStart = static_cast<size_t>(y) * width;
+        BasicCell* last = previous.data() + rowStart;
+
+        // BASIC payloads have the same layout, so unchanged rows are one memcmp.
+        if (basic && std::memcmp(last, basic + rowStart, width * sizeof(BasicCell)) == 0) {
+            continue;
+        }
+
+        CellSpan& span = dirtyRows[y];
+        span.begin = width;
+        for (uint32_t x = 0; x < width; ++x) {
+            const BasicCell cell = basic
+                ? basic[rowStart + x]
+                : BasicCell{ static_cast<uint8_t>(frame.materialAt(rowStart + x)),
+                             frame.fillAt(rowStart + x) };
+            if (cell.material_type != last[x].material_type
+                || cell.fill_ratio != last[x].fill_ratio) {
+                last[x] = cell;
+                span.begin = std::min(span.begin, x);
+                span.end = x + 1;
+                changed++;
+            }
+        }
+    }
+    return changed;
+}
+
 // Get optimal pixel size for a given render mode.
 // For PIXEL_PERFECT, returns 0 (special case - calculated dynamically).
 static uint32_t getPixelsPerCellForMode(RenderMode mode)
@@ -100,48 +304,86 @@ static uint32_t calculateIntegerPixelsPerCell(
     return std::max(2u, scale);
 }
 
-// Apply bilinear smoothing filter to blend adjacent pixels.
-// This creates anti-aliasing at cell boundaries.
-static void applyBilinearFilter(uint32_t* pixels, uint32_t width, uint32_t height)
+// Channel lanes: B and R in the even lanes, G and A in the odd ones (after >> 8). Each lane has
+// 16 bits, so sums of four 8-bit channels cannot carry into the next lane.
+constexpr uint32_t EVEN_CHANNELS = 0x00FF00FF;
+
+// One output row of the 2x2 box filter, [rx0, rx1) of row y, as two separable passes over
+// packed channel lanes: vertical sums of each pixel and the one below, then horizontal sums
+// of neighbouring columns. Both passes vectorize; the result is exactly floor(sum / 4).
+static void filterRow(
+    const uint32_t* src,
+    uint32_t* dst,
+    uint32_t width,
+    uint32_t height,
+    uint32_t rx0,
+    uint32_t rx1,
+    uint32_t y)
 {
-    if (width < 2 || height < 2) return;
-
-    // Create temporary buffer for filtered output.
-    std::vector<uint32_t> filtered(width * height);
-
-    // Apply 2x2 box filter to smooth transitions.
-    for (uint32_t y = 0; y < height; ++y) {
-        for (uint32_t x = 0; x < width; ++x) {
-            uint32_t idx = y * width + x;
-
-            // Sample neighborhood (with boundary clamping).
-            uint32_t x0 = x;
-            uint32_t x1 = std::min(x + 1, width - 1);
-            uint32_t y0 = y;
-            uint32_t y1 = std::min(y + 1, height - 1);
-
-            // Get four samples.
-            uint32_t p00 = pixels[y0 * width + x0];
-            uint32_t p10 = pixels[y0 * width + x1];
-            uint32_t p01 = pixels[y1 * width + x0];
-            uint32_t p11 = pixels[y1 * width + x1];
+    // Column sums for [rx0, rx1] (one past the end for the right neighbour), reused per thread.
+    thread_local std::vector<uint32_t> evenSums;
+    thread_local std::vector<uint32_t> oddSums;
+    const uint32_t count = rx1 - rx0;
+    evenSums.resize(count + 1);
+    oddSums.resize(count + 1);
+    uint32_t* even = evenSums.data();
+    uint32_t* odd = oddSums.data();
+
+    // Sample neighborhood (with boundary clamping).
+    const uint32_t* row0 = src + static_cast<size_t>(y) * width + rx0;
+    const uint32_t* row1 = src + static_cast<size_t>(std::min(y + 1, height - 1)) * width + rx0;
+
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (uint32_t i = 0; i < count; ++i) {
+        even[i] = (row0[i] & EVEN_CHANNELS) + (row1[i] & EVEN_CHANNELS);
+        odd[i] = ((row0[i] >> 8) & EVEN_CHANNELS) + ((row1[i] >> 8) & EVEN_CHANNELS);
+    }
+    const uint32_t last = std::min(rx1, width - 1) - rx0;
+    even[count] = (row0[last] & EVEN_CHANNELS) + (row1[last] & EVEN_CHANNELS);
+    odd[count] = ((row0[last] >> 8) & EVEN_CHANNELS) + ((row1[last] >> 8) & EVEN_CHANNELS);
+
+    uint32_t* out = dst + static_cast<size_t>(y) * width + rx0;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t evenAverage = ((even[i] + even[i + 1]) >> 2) & EVEN_CHANNELS;
+        const uint32_t oddAverage = ((odd[i] + odd[i + 1]) >> 2) & EVEN_CHANNELS;
+        out[i] = evenAverage | (oddAverage << 8);
+    }
+}
 
-            // Extract and average ARGB channels.
-            uint32_t a = ((p00 >> 24) + (p10 >> 24) + (p01 >> 24) + (p11 >> 24)) / 4;
-            uint32_t r = (((p00 >> 16) & 0xFF) + ((p10 >> 16) & 0xFF) + ((p01 >> 16) & 0xFF)
-                          + ((p11 >> 16) & 0xFF))
-                / 4;
-            uint32_t g = (((p00 >> 8) & 0xFF) + ((p10 >> 8) & 0xFF) + ((p01 >> 8) & 0xFF)
-                          + ((p11 >> 8) & 0xFF))
-                / 4;
-            uint32_t b = ((p00 & 0xFF) + (p10 & 0xFF) + (p01 & 0xFF) + (p11 & 0xFF)) / 4;
+void applyBilinearFilter(
+    const uint32_t* src,
+    uint32_t* dst,
+    uint32_t width,
+    uint32_t height,
+    uint32_t rx0,
+    uint32_t ry0,
+    uint32_t rx1,
+    uint32_t ry1)
+{
+    if (rx0 >= rx1 || ry0 >= ry1) return;
 
-            filtered[idx] = (a << 24) | (r << 16) | (g << 8) | b;
+    if (width < 2 || height < 2) {
+        for (uint32_t y = ry0; y < ry1; ++y) {
+            const size_t offset = static_cast<size_t>(y) * width + rx0;
+            std::memcpy(dst + offset, src + offset, (rx1 - rx0) * sizeof(uint32_t));
         }
+        return;
     }
 
-    // Copy filtered result back to original buffer.
-    std::memcpy(pixels, filtered.data(), width * height * sizeof(uint32_t));
+    // Apply 2x2 box filter to smooth transitions, rows in parallel.
+    const int rows = static_cast<int>(ry1 - ry0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(RASTER_THREADS) if ( \
+        static_cast<size_t>(rx1 - rx0) * rows >= PARALLEL_RASTER_MIN_PIXELS)
+#endif
+    for (int row = 0; row < rows; ++row) {
+        filterRow(src, dst, width, height, rx0, rx1, ry0 + row);
+    }
 }
 
 static lv_color_t getMaterialColor(MaterialType type)
@@ -172,6 +414,30 @@ static lv_color_t getMaterialColor(MaterialType type)
     }
 }
 
+// Border and interior colours of one frame cell. Border opacity varies by debug mode: full
+// in debug mode (pronounced border), 0.85 otherwise (subtle/faint border). The interior is
+// always at 0.7 opacity (darker).
+static CellShade shadeCell(const RenderFrame& frame, size_t idx, bool debugDraw)
+{
+    const MaterialType material = frame.materialAt(idx);
+    if (frame.fillAt(idx) == 0 || material == MaterialType::AIR) {
+        return CellShade{ 0xFF000000, 0xFF000000 }; // ARGB black with full alpha.
+    }
+
+    const double fillRatio = frame.fillRatioAt(idx);
+    const lv_color_t matColor = getMaterialColor(material);
+    const double borderOpacityFactor = debugDraw ? 1.0 : 0.85;
+    const uint32_t borderAlpha = static_cast<uint8_t>(fillRatio * 255.0 * borderOpacityFactor);
+    const uint32_t interiorAlpha = static_cast<uint8_t>(fillRatio * 255.0 * 0.7);
+    const uint32_t rgb = (matColor.red << 16) | (matColor.green << 8) | matColor.blue;
+
+    const CellShade raw{ (borderAlpha << 24) | rgb, (interiorAlpha << 24) | rgb };
+    if constexpr (ENABLE_DITHERING) {
+        return raw;
+    }
+    return CellShade{ compositeOverBlack(raw.border), compositeOverBlack(raw.interior) };
+}
+
 CellRenderer::~CellRenderer()
 {
     cleanup();
@@ -317,6 +583,9 @@ void CellRenderer::initializeWithPixelSize(
     // Position canvas at top-left of container.
     lv_obj_set_pos(worldCanvas_, 0, 0);
 
+    // The new buffer shows nothing yet; the next frame is drawn in full.
+    canvasCurrent_ = false;
+
     // Apply LVGL transform scaling to fit canvas to container.
     // LVGL uses fixed-point scaling where 256 = 1.0×.
     // Calculate scale to fit world in container while preserving aspect ratio.
@@ -361,16 +630,19 @@ void CellRenderer::resize(lv_obj_t* parent, uint32_t worldWidth, uint32_t worldH
     initialize(parent, worldWidth, worldHeight);
 }
 
-void CellRenderer::renderWorldData(
-    const WorldData& worldData, lv_obj_t* parent, bool debugDraw, RenderMode mode)
+void CellRenderer::renderFrame(
+    const RenderFrame& frame, lv_obj_t* parent, bool debugDraw, RenderMode mode)
 {
+    const uint32_t worldWidth = frame.width();
+    const uint32_t worldHeight = frame.height();
+
     // Validate input.
-    if (!parent || worldData.width == 0 || worldData.height == 0) {
+    if (!parent || worldWidth == 0 || worldHeight == 0) {
         spdlog::warn(
             "CellRenderer: Invalid render parameters (parent={}, size={}x{})",
             (void*)parent,
-            worldData.width,
-            worldData.height);
+            worldWidth,
+            worldHeight);
         return;
     }
 
@@ -397,6 +669,8 @@ void CellRenderer::renderWorldData(
         cleanup();
     }
 
+    // A mode change alters every pixel even when the canvas is kept.
+    const bool modeChanged = effectiveMode != currentMode_;
     currentMode_ = effectiveMode;
 
     // Determine rendering path based on mode.
@@ -431,20 +705,20 @@ void CellRenderer::renderWorldData(
         // PIXEL_PERFECT mode calculates integer scale dynamically.
         if (effectiveMode == RenderMode::PIXEL_PERFECT) {
             pixelsPerCell = calculateIntegerPixelsPerCell(
-                worldData.width, worldData.height, currentContainerWidth, currentContainerHeight);
+                worldWidth, worldHeight, currentContainerWidth, currentContainerHeight);
             spdlog::info(
                 "CellRenderer: PIXEL_PERFECT mode - using {}× integer scale", pixelsPerCell);
         }
 
-        initializeWithPixelSize(parent, worldData.width, worldData.height, pixelsPerCell);
+        initializeWithPixelSize(parent, worldWidth, worldHeight, pixelsPerCell);
         if (!worldCanvas_) {
             return; // Failed to initialize.
         }
     }
 
     // Update scaling if world dimensions changed
-    if (width_ != worldData.width || height_ != worldData.height) {
-        resize(parent, worldData.width, worldData.height);
+    if (width_ != worldWidth || height_ != worldHeight) {
+        resize(parent, worldWidth, worldHeight);
     }
 
     // Check if canvas is still valid
@@ -454,137 +728,92 @@ void CellRenderer::renderWorldData(
         return;
     }
 
-    // Clear buffer
-    std::fill(canvasBuffer_.begin(), canvasBuffer_.end(), 0);
-
     // With transform scaling, world fills canvas exactly - no offset needed.
     int32_t renderOffsetX = 0;
     int32_t renderOffsetY = 0;
 
     if (usePixelRenderer) {
-        // FAST PATH: Direct pixel rendering with alpha blending
-        uint32_t* pixels = reinterpret_cast<uint32_t*>(canvasBuffer_.data());
+        // FAST PATH: only cells whose material or fill changed since the last frame are redrawn,
+        // in horizontal tiles of cell rows shaded and rasterized in parallel. Tiles write every
+        // pixel they cover, so the canvas is not cleared first. Debug overlays depend on
+        // physics fields that are not diffed, so debug draw always redraws the whole canvas.
+        const bool fullRedraw = !canvasCurrent_ || modeChanged || debugDraw || lastDebugDraw_;
+        lastDebugDraw_ = debugDraw;
+
+        const size_t changedCells = diffFrameCells(frame, lastCells_, dirtyRows_);
+        if (fullRedraw) {
+            std::fill(dirtyRows_.begin(), dirtyRows_.end(), CellSpan{ 0, worldWidth });
+        }
+        else if (changedCells == 0) {
+            return; // Unchanged frame: the canvas already shows it.
+        }
 
-        for (uint32_t y = 0; y < worldData.height; ++y) {
-            for (uint32_t x = 0; x < worldData.width; ++x) {
-                uint32_t idx = y * worldData.width + x;
-                if (idx >= worldData.cells.size()) break;
+        // SMOOTH rasterizes into an unfiltered buffer and filters it into the canvas.
+        uint32_t* canvasPixels = reinterpret_cast<uint32_t*>(canvasBuffer_.data());
+        const size_t canvasPixelCount = static_cast<size_t>(canvasWidth_) * canvasHeight_;
+        uint32_t* pixels = canvasPixels;
+        if (useBilinearFilter) {
+            rasterBuffer_.resize(canvasPixelCount);
+            pixels = rasterBuffer_.data();
+        }
+        shades_.resize(frame.cellCount());
+
+        const int rows = static_cast<int>(worldHeight);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(RASTER_THREADS) if ( \
+        canvasPixelCount >= PARALLEL_RASTER_MIN_PIXELS)
+#endif
+        for (int y = 0; y < rows; ++y) {
+            const CellSpan span = dirtyRows_[y];
+            if (span.empty()) continue;
+
+            const size_t rowStart = static_cast<size_t>(y) * worldWidth;
+            for (uint32_t x = span.begin; x < span.end; ++x) {
+                shades_[rowStart + x] = shadeCell(frame, rowStart + x, debugDraw);
+            }
+            rasterizeCellSpan(
+                pixels,
+                canvasWidth_,
+                canvasHeight_,
+                shades_.data(),
+                worldWidth,
+                scaledCellWidth_,
+                scaledCellHeight_,
+                y,
+                span);
+        }
 
-                const Cell& cell = worldData.cells[idx];
-                int32_t cellX = renderOffsetX + x * scaledCellWidth_;
-                int32_t cellY = renderOffsetY + y * scaledCellHeight_;
+        // Canvas rows below the grid, if the canvas is taller than the world.
+        if (fullRedraw) {
+            const size_t gridRows = std::min<size_t>(
+                static_cast<size_t>(worldHeight) * scaledCellHeight_, canvasHeight_);
+            std::fill(pixels + gridRows * canvasWidth_, pixels + canvasPixelCount, 0);
+        }
 
-                // Bounds check
-                if (cellX < 0 || cellY < 0 || cellX + scaledCellWidth_ > canvasWidth_
-                    || cellY + scaledCellHeight_ > canvasHeight_) {
-                    continue;
-                }
+        // Debug draw: COM indicator and pressure gradient, on top of the finished cells.
+        if (debugDraw) {
+            for (uint32_t y = 0; y < worldHeight; ++y) {
+                for (uint32_t x = 0; x < worldWidth; ++x) {
+                    const size_t idx = static_cast<size_t>(y) * worldWidth + x;
+                    if (frame.fillAt(idx) == 0 || frame.materialAt(idx) == MaterialType::AIR) {
+                        continue;
+                    }
 
-                // Prepare border color and interior color.
-                uint32_t borderColor = 0xFF000000;   // ARGB black with full alpha.
-                uint32_t interiorColor = 0xFF000000; // ARGB black with full alpha.
-
-                if (!cell.isEmpty() && cell.material_type != MaterialType::AIR) {
-                    lv_color_t matColor = getMaterialColor(cell.material_type);
-                    // Border opacity varies by debug mode.
-                    // Debug mode: full opacity (pronounced border).
-                    // Normal mode: 0.85 opacity (subtle/faint border).
-                    double borderOpacityFactor = debugDraw ? 1.0 : 0.85;
-                    uint8_t borderAlpha =
-                        static_cast<uint8_t>(cell.fill_ratio * 255.0 * borderOpacityFactor);
-                    // Interior always at 0.7 opacity (darker).
-                    uint8_t interiorAlpha = static_cast<uint8_t>(cell.fill_ratio * 255.0 * 0.7);
-
-                    borderColor = (borderAlpha << 24) | (matColor.red << 16) | (matColor.green << 8)
-                        | matColor.blue;
-                    interiorColor = (interiorAlpha << 24) | (matColor.red << 16)
-                        | (matColor.green << 8) | matColor.blue;
-                }
+                    int32_t cellX = renderOffsetX + x * scaledCellWidth_;
+                    int32_t cellY = renderOffsetY + y * scaledCellHeight_;
 
-                // Fill cell rectangle with border and interior.
-                for (uint32_t py = 0; py < scaledCellHeight_; py++) {
-                    uint32_t rowStart = (cellY + py) * canvasWidth_ + cellX;
-                    for (uint32_t px = 0; px < scaledCellWidth_; px++) {
-                        uint32_t pixelIdx = rowStart + px;
-
-                        // Determine if this pixel is on the border.
-                        bool isBorder =
-                            (px == 0 || px == scaledCellWidth_ - 1 || py == 0
-                             || py == scaledCellHeight_ - 1);
-
-                        // Select color based on position (border vs interior).
-                        uint32_t pixelColor = isBorder ? borderColor : interiorColor;
-                        uint8_t alpha = (pixelColor >> 24) & 0xFF;
-
-                        if constexpr (ENABLE_DITHERING) {
-                            // Dithered rendering: use Bayer matrix to decide pixel on/off.
-                            if (alpha == 0) {
-                                // Fully transparent - skip.
-                                continue;
-                            }
-                            else if (alpha == 255) {
-                                // Fully opaque - direct write.
-                                pixels[pixelIdx] = pixelColor;
-                            }
-                            else {
-                                // Partial transparency - use dithering.
-                                // Get Bayer threshold for this pixel position.
-                                int bayerX = (cellX + px) % 4;
-                                int bayerY = (cellY + py) % 4;
-                                int bayerThreshold = BAYER_MATRIX_4X4[bayerY][bayerX];
-
-                                // Compare alpha to threshold (scaled 0-255 to 0-15).
-                                // If alpha > threshold, draw pixel at full opacity.
-                                if ((alpha * 16 / 256) > bayerThreshold) {
-                                    // Draw pixel with full material color (no alpha).
-                                    pixels[pixelIdx] = 0xFF000000 | (pixelColor & 0x00FFFFFF);
-                                }
-                                // Otherwise skip pixel (leave background).
-                            }
-                        }
-                        else {
-                            // Alpha blending: blend source with destination
-                            if (alpha == 0) {
-                                // Fully transparent - skip (keep background)
-                                continue;
-                            }
-                            else if (alpha == 255) {
-                                // Fully opaque - direct write (optimization)
-                                pixels[pixelIdx] = pixelColor;
-                            }
-                            else {
-                                // Partial transparency - blend
-                                uint32_t dstColor = pixels[pixelIdx];
-                                uint8_t invAlpha = 255 - alpha;
-
-                                // Extract source channels
-                                uint8_t srcR = (pixelColor >> 16) & 0xFF;
-                                uint8_t srcG = (pixelColor >> 8) & 0xFF;
-                                uint8_t srcB = pixelColor & 0xFF;
-
-                                // Extract destination channels
-                                uint8_t dstR = (dstColor >> 16) & 0xFF;
-                                uint8_t dstG = (dstColor >> 8) & 0xFF;
-                                uint8_t dstB = dstColor & 0xFF;
-
-                                // Blend: result = (src * alpha + dst * (1 - alpha)) / 255
-                                uint8_t r = (srcR * alpha + dstR * invAlpha) / 255;
-                                uint8_t g = (srcG * alpha + dstG * invAlpha) / 255;
-                                uint8_t b = (srcB * alpha + dstB * invAlpha) / 255;
-
-                                // Write blended pixel (with full alpha)
-                                pixels[pixelIdx] = 0xFF000000 | (r << 16) | (g << 8) | b;
-                            }
-                        }
+                    // Bounds check
+                    if (cellX < 0 || cellY < 0 || cellX + scaledCellWidth_ > canvasWidth_
+                        || cellY + scaledCellHeight_ > canvasHeight_) {
+                        continue;
                     }
-                }
 
-                // Debug draw: COM indicator (single pixel)
-                if (debugDraw && !cell.isEmpty() && cell.material_type != MaterialType::AIR) {
+                    const RenderMessageUtils::UnpackedDebugCell cell = frame.decodeAt(idx);
+
                     // Calculate COM position in pixel coordinates.
                     // COM ranges from [-1, 1] where -1 is top/left and +1 is bottom/right.
-                    int com_pixel_x =
-                        cellX + static_cast<int>((cell.com.x + 1.0) * (scaledCellWidth_ - 1) / 2.0);
+                    int com_pixel_x = cellX
+                        + static_cast<int>((cell.com.x + 1.0) * (scaledCellWidth_ - 1) / 2.0);
                     int com_pixel_y = cellY
                         + static_cast<int>((cell.com.y + 1.0) * (scaledCellHeight_ - 1) / 2.0);
 
@@ -617,37 +846,48 @@ void CellRenderer::renderWorldData(
             }
         }
 
-        // Apply bilinear smoothing filter if mode requires it.
-        if (useBilinearFilter) {
-            applyBilinearFilter(pixels, canvasWidth_, canvasHeight_);
+        // Apply bilinear smoothing filter if mode requires it, then refresh what changed.
+        collectDirtyRects(fullRedraw, useBilinearFilter);
+        for (const PixelRect& rect : dirtyRects_) {
+            if (useBilinearFilter) {
+                applyBilinearFilter(
+                    pixels,
+                    canvasPixels,
+                    canvasWidth_,
+                    canvasHeight_,
+                    rect.x0,
+                    rect.y0,
+                    rect.x1,
+                    rect.y1);
+            }
+            if (!fullRedraw) {
+                invalidateCanvasRect(rect);
+            }
         }
 
         // Invalidate canvas to trigger display update.
-        lv_obj_invalidate(worldCanvas_);
+        if (fullRedraw) {
+            lv_obj_invalidate(worldCanvas_);
+        }
+        canvasCurrent_ = true;
     }
     else {
         // SLOW PATH: LVGL layer rendering
+        std::fill(canvasBuffer_.begin(), canvasBuffer_.end(), 0);
+        canvasCurrent_ = false;
+
         lv_layer_t layer;
         lv_canvas_init_layer(worldCanvas_, &layer);
 
-        for (uint32_t y = 0; y < worldData.height; ++y) {
-            for (uint32_t x = 0; x < worldData.width; ++x) {
-                uint32_t idx = y * worldData.width + x;
-                if (idx >= worldData.cells.size()) {
-                    spdlog::error(
-                        "CellRenderer: Cell index out of bounds (idx={}, size={})",
-                        idx,
-                        worldData.cells.size());
-                    break;
-                }
-                const Cell& cell = worldData.cells[idx];
-                const CellDebug& debug = worldData.debug_info[idx];
+        for (uint32_t y = 0; y < worldHeight; ++y) {
+            for (uint32_t x = 0; x < worldWidth; ++x) {
+                const size_t idx = static_cast<size_t>(y) * worldWidth + x;
 
                 // Calculate cell position with pre-computed offset
                 int32_t cellX = renderOffsetX + x * scaledCellWidth_;
                 int32_t cellY = renderOffsetY + y * scaledCellHeight_;
 
-                renderCellLVGL(cell, debug, layer, cellX, cellY, debugDraw);
+                renderCellLVGL(frame.decodeAt(idx), layer, cellX, cellY, debugDraw);
             }
         }
 
@@ -678,11 +918,81 @@ void CellRenderer::cleanup()
     parent_ = nullptr;
     lastContainerWidth_ = 0;
     lastContainerHeight_ = 0;
+    canvasCurrent_ = false;
+    rasterBuffer_.clear();
+    rasterBuffer_.shrink_to_fit();
+}
+
+void CellRenderer::collectDirtyRects(bool fullRedraw, bool smoothing)
+{
+    dirtyRects_.clear();
+    if (fullRedraw) {
+        dirtyRects_.push_back(PixelRect{ 0, 0, canvasWidth_, canvasHeight_ });
+        return;
+    }
+
+    // Consecutive dirty cell rows merge into one band spanning their cells.
+    const auto addBand = [&](uint32_t rowBegin, uint32_t rowEnd, CellSpan cells) {
+        PixelRect rect{ cells.begin * scaledCellWidth_,
+                        rowBegin * scaledCellHeight_,
+                        std::min(cells.end * scaledCellWidth_, canvasWidth_),
+                        std::min(rowEnd * scaledCellHeight_, canvasHeight_) };
+        if (smoothing) {
+            // Filtered pixels also read their right and lower neighbours.
+            rect.x0 = rect.x0 > 0 ? rect.x0 - 1 : 0;
+            rect.y0 = rect.y0 > 0 ? rect.y0 - 1 : 0;
+        }
+        if (rect.x0 < rect.x1 && rect.y0 < rect.y1) {
+            dirtyRects_.push_back(rect);
+        }
+    };
+
+    uint32_t bandBegin = 0;
+    CellSpan band;
+    for (uint32_t y = 0; y <= dirtyRows_.size(); ++y) {
+        const bool dirty = y < dirtyRows_.size() && !dirtyRows_[y].empty();
+        if (dirty && band.empty()) {
+            bandBegin = y;
+            band = dirtyRows_[y];
+        }
+        else if (dirty) {
+            band.begin = std::min(band.begin, dirtyRows_[y].begin);
+            band.end = std::max(band.end, dirtyRows_[y].end);
+        }
+        else if (!band.empty()) {
+            addBand(bandBegin, y, band);
+            band = CellSpan{};
+        }
+    }
+
+    // Past a handful of areas LVGL would redraw the whole screen anyway; one box is cheaper.
+    constexpr size_t MAX_DIRTY_RECTS = 16;
+    if (dirtyRects_.size() > MAX_DIRTY_RECTS) {
+        PixelRect bounds = dirtyRects_.front();
+        for (const PixelRect& rect : dirtyRects_) {
+            bounds.x0 = std::min(bounds.x0, rect.x0);
+            bounds.y0 = std::min(bounds.y0, rect.y0);
+            bounds.x1 = std::max(bounds.x1, rect.x1);
+            bounds.y1 = std::max(bounds.y1, rect.y1);
+        }
+        dirtyRects_.assign(1, bounds);
+    }
+}
+
+void CellRenderer::invalidateCanvasRect(const PixelRect& rect)
+{
+    // Invalidation takes untransformed screen coordinates; LVGL applies the canvas scaling.
+    lv_area_t coords;
+    lv_obj_get_coords(worldCanvas_, &coords);
+    const lv_area_t area = { coords.x1 + static_cast<int32_t>(rect.x0),
+                             coords.y1 + static_cast<int32_t>(rect.y0),
+                             coords.x1 + static_cast<int32_t>(rect.x1) - 1,
+                             coords.y1 + static_cast<int32_t>(rect.y1) - 1 };
+    lv_obj_invalidate_area(worldCanvas_, &area);
 }
 
 void CellRenderer::renderCellLVGL(
-    const Cell& cell,
-    const CellDebug& debug,
+    const RenderMessageUtils::UnpackedDebugCell& cell,
     lv_layer_t& layer,
     int32_t cellX,
     int32_t cellY,
@@ -708,7 +1018,7 @@ void CellRenderer::renderCellLVGL(
     lv_draw_rect(&layer, &bg_rect_dsc, &bg_coords);
 
     // Render material if not empty
-    if (!cell.isEmpty() && cell.material_type != MaterialType::AIR) {
+    if (cell.fill_ratio > 0.0 && cell.material_type != MaterialType::AIR) {
         lv_color_t material_color = getMaterialColor(cell.material_type);
         lv_opa_t opacity =
             static_cast<lv_opa_t>(cell.fill_ratio * static_cast<double>(LV_OPA_COVER));
@@ -776,9 +1086,9 @@ void CellRenderer::renderCellLVGL(
                 // Scale pressure values to opacity range [0, 255].
                 const double PRESSURE_OPACITY_SCALE = 25.0;
                 int dynamic_opacity = std::min(
-                    static_cast<int>(cell.dynamic_component * PRESSURE_OPACITY_SCALE), 255);
+                    static_cast<int>(cell.pressure_dynamic * PRESSURE_OPACITY_SCALE), 255);
                 int hydrostatic_opacity = std::min(
-                    static_cast<int>(cell.hydrostatic_component * PRESSURE_OPACITY_SCALE), 255);
+                    static_cast<int>(cell.pressure_hydro * PRESSURE_OPACITY_SCALE), 255);
 
                 // Dynamic pressure border (magenta outer).
                 if (dynamic_opacity > 0) {
@@ -837,73 +1147,6 @@ void CellRenderer::renderCellLVGL(
                 grad_dsc.p2.y = end_y;
                 lv_draw_line(&layer, &grad_dsc);
             }
-
-            // Adhesion force vector (orange line from center).
-            if (scaledCellWidth_ >= 10 && debug.accumulated_adhesion_force.magnitude() > 0.01) {
-                const double ADHESION_SCALE = 10.0 * scaleX_;
-                int end_x = com_pixel_x
-                    + static_cast<int>(debug.accumulated_adhesion_force.x * ADHESION_SCALE);
-                int end_y = com_pixel_y
-                    + static_cast<int>(debug.accumulated_adhesion_force.y * ADHESION_SCALE);
-
-                lv_draw_line_dsc_t adhesion_dsc;
-                lv_draw_line_dsc_init(&adhesion_dsc);
-                adhesion_dsc.color = lv_color_hex(0xFF8000); // Orange.
-                adhesion_dsc.width = std::max(1, static_cast<int>(2 * scaleX_));
-                adhesion_dsc.p1.x = com_pixel_x;
-                adhesion_dsc.p1.y = com_pixel_y;
-                adhesion_dsc.p2.x = end_x;
-                adhesion_dsc.p2.y = end_y;
-                lv_draw_line(&layer, &adhesion_dsc);
-            }
-
-            // COM cohesion force vector (purple line from cell center).
-            if (scaledCellWidth_ >= 10 && debug.accumulated_com_cohesion_force.magnitude() > 0.01) {
-                const double COHESION_SCALE = 1.0 * scaleX_;
-
-                // Draw from cell center (not COM).
-                int cell_center_x = cellX + scaledCellWidth_ / 2;
-                int cell_center_y = cellY + scaledCellHeight_ / 2;
-
-                int end_x = cell_center_x
-                    + static_cast<int>(debug.accumulated_com_cohesion_force.x * COHESION_SCALE);
-                int end_y = cell_center_y
-                    + static_cast<int>(debug.accumulated_com_cohesion_force.y * COHESION_SCALE);
-
-                lv_draw_line_dsc_t cohesion_dsc;
-                lv_draw_line_dsc_init(&cohesion_dsc);
-                cohesion_dsc.color = lv_color_hex(0x9370DB); // Purple (medium purple).
-                cohesion_dsc.width = std::max(1, static_cast<int>(2 * scaleX_));
-                cohesion_dsc.p1.x = cell_center_x;
-                cohesion_dsc.p1.y = cell_center_y;
-                cohesion_dsc.p2.x = end_x;
-                cohesion_dsc.p2.y = end_y;
-                lv_draw_line(&layer, &cohesion_dsc);
-            }
-
-            // Viscous force vector (cyan line from cell center).
-            if (scaledCellWidth_ >= 10 && debug.accumulated_viscous_force.magnitude() > 0.01) {
-                const double VISCOUS_SCALE = 5.0 * scaleX_;
-
-                // Draw from cell center.
-                int cell_center_x = cellX + scaledCellWidth_ / 2;
-                int cell_center_y = cellY + scaledCellHeight_ / 2;
-
-                int end_x = cell_center_x
-                    + static_cast<int>(debug.accumulated_viscous_force.x * VISCOUS_SCALE);
-                int end_y = cell_center_y
-                    + static_cast<int>(debug.accumulated_viscous_force.y * VISCOUS_SCALE);
-
-                lv_draw_line_dsc_t viscous_dsc;
-                lv_draw_line_dsc_init(&viscous_dsc);
-                viscous_dsc.color = lv_color_hex(0x00FFFF); // Cyan.
-                viscous_dsc.width = std::max(1, static_cast<int>(2 * scaleX_));
-                viscous_dsc.p1.x = cell_center_x;
-                viscous_dsc.p1.y = cell_center_y;
-                viscous_dsc.p2.x = end_x;
-                viscous_dsc.p2.y = end_y;
-                lv_draw_line(&layer, &viscous_dsc);
-            }
         }
     }
 }
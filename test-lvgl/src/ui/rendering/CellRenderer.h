@@ -2,7 +2,7 @@
 
 #include "RenderMode.h"
 #include "core/Cell.h"
-#include "core/WorldData.h"
+#include "core/RenderFrame.h"
 #include "lvgl/lvgl.h"
 #include <cstdint>
 #include <vector>
@@ -10,6 +10,21 @@
 namespace DirtSim {
 namespace Ui {
 
+// Canvas colours of one cell's border ring and interior: composited over black, or raw ARGB
+// when the renderer is built with dithering.
+struct CellShade {
+    uint32_t border = 0;
+    uint32_t interior = 0;
+};
+
+// Range [begin, end) of cells within one cell row; empty when begin == end.
+struct CellSpan {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+
+    bool empty() const { return begin >= end; }
+};
+
 class CellRenderer {
 public:
     CellRenderer() = default;
@@ -17,8 +32,8 @@ public:
 
     void initialize(lv_obj_t* parent, uint32_t worldWidth, uint32_t worldHeight);
     void resize(lv_obj_t* parent, uint32_t worldWidth, uint32_t worldHeight);
-    void renderWorldData(
-        const WorldData& worldData,
+    void renderFrame(
+        const RenderFrame& frame,
         lv_obj_t* parent,
         bool debugDraw,
         RenderMode mode = RenderMode::ADAPTIVE);
@@ -51,20 +66,98 @@ private:
     // Track current render mode to detect changes requiring reinitialization.
     RenderMode currentMode_ = RenderMode::ADAPTIVE;
 
+    // Per-cell shades for the frame being rasterized (reused across frames).
+    std::vector<CellShade> shades_;
+
+    // Incremental redraw: material and fill of every cell as last rasterized, the cells of
+    // each row that changed in the current frame, and whether the canvas shows lastCells_.
+    std::vector<BasicCell> lastCells_;
+    std::vector<CellSpan> dirtyRows_;
+    bool canvasCurrent_ = false;
+    bool lastDebugDraw_ = false;
+
+    // Unfiltered raster for SMOOTH mode; the canvas holds its filtered copy, so dirty areas
+    // can be re-filtered without the rest of the frame.
+    std::vector<uint32_t> rasterBuffer_;
+
+    // Canvas pixel rectangles [x0, x1) × [y0, y1) refreshed this frame.
+    struct PixelRect {
+        uint32_t x0 = 0;
+        uint32_t y0 = 0;
+        uint32_t x1 = 0;
+        uint32_t y1 = 0;
+    };
+    std::vector<PixelRect> dirtyRects_;
+
     void calculateScaling(uint32_t worldWidth, uint32_t worldHeight);
+    void collectDirtyRects(bool fullRedraw, bool smoothing);
+    void invalidateCanvasRect(const PixelRect& rect);
     void initializeWithPixelSize(
         lv_obj_t* parent, uint32_t worldWidth, uint32_t worldHeight, uint32_t pixelsPerCell);
 
     // LVGL-based cell rendering (used for LVGL_DEBUG mode).
     void renderCellLVGL(
-        const Cell& cell,
-        const CellDebug& debug,
+        const RenderMessageUtils::UnpackedDebugCell& cell,
         lv_layer_t& layer,
         int32_t cellX,
         int32_t cellY,
         bool debugDraw);
 };
 
+// Composite an ARGB colour over opaque black (the pixel renderer's background).
+// Returns 0 (transparent) for zero alpha. Exposed for unit testing.
+uint32_t compositeOverBlack(uint32_t argb);
+
+// Rasterize cell rows [rowBegin, rowEnd) of a worldWidth-wide grid of cellWidth × cellHeight
+// cells, reading shades in row-major order. Every canvas pixel in those rows is written (cells
+// that do not fit the canvas become transparent), so the canvas needs no clear beforehand.
+// Rows are disjoint, so separate row ranges may be rasterized concurrently. Exposed for unit
+// testing.
+void rasterizeCellRows(
+    uint32_t* pixels,
+    uint32_t canvasWidth,
+    uint32_t canvasHeight,
+    const CellShade* shades,
+    uint32_t worldWidth,
+    uint32_t cellWidth,
+    uint32_t cellHeight,
+    uint32_t rowBegin,
+    uint32_t rowEnd);
+
+// Rasterize only cells [span.begin, span.end) of cell row y, as rasterizeCellRows would.
+// A span reaching the last cell that fits also rewrites the transparent tail of the row.
+void rasterizeCellSpan(
+    uint32_t* pixels,
+    uint32_t canvasWidth,
+    uint32_t canvasHeight,
+    const CellShade* shades,
+    uint32_t worldWidth,
+    uint32_t cellWidth,
+    uint32_t cellHeight,
+    uint32_t y,
+    CellSpan span);
+
+// Compare a frame's material and fill with the cells last rasterized, store each cell row's
+// changed range in dirtyRows and bring previous up to date. A size change marks every cell
+// dirty. Returns the number of changed cells. Exposed for unit testing.
+size_t diffFrameCells(
+    const RenderFrame& frame,
+    std::vector<BasicCell>& previous,
+    std::vector<CellSpan>& dirtyRows);
+
+// SMOOTH mode's bilinear smoothing: each pixel of the output rectangle [rx0, rx1) × [ry0, ry1)
+// of dst becomes the per-channel average (rounded down) of the 2x2 block of src at its position,
+// clamped at the right and bottom edges. Exposed for unit testing.
+void applyBilinearFilter(
+    const uint32_t* src,
+    uint32_t* dst,
+    uint32_t width,
+    uint32_t height,
+    uint32_t rx0,
+    uint32_t ry0,
+    uint32_t rx1,
+    uint32_t ry1);
+
 // Bresenham's line algorithm for fast pixel-based line drawing.
 // Exposed for unit testing. Uses only integer math for maximum performance.
 void drawLineBresenham(
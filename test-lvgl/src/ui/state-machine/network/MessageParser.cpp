@@ -1,5 +1,6 @@
 #include "MessageParser.h"
 #include "core/PhysicsSettings.h"
+#include "core/RenderFrame.h"
 #include "core/WorldData.h"
 #include <spdlog/spdlog.h>
 
@@ -51,7 +52,7 @@ std::optional<Event> MessageParser::parseWorldDataResponse(const nlohmann::json&
 
         uint64_t stepCount = worldData.timestep;
         UiUpdateEvent evt{ .sequenceNum = 0,
-                           .worldData = std::move(worldData),
+                           .frame = RenderFrame::fromWorldData(worldData),
                            .fps = static_cast<uint32_t>(worldData.fps_server),
                            .stepCount = stepCount,
                            .isPaused = false,
@@ -1,6 +1,7 @@
 #include "WebSocketClient.h"
 #include "core/MsgPackAdapter.h"
 #include "core/ReflectSerializer.h"
+#include "core/RenderFrame.h"
 #include "core/RenderMessage.h"
 #include "core/RenderMessageUtils.h"
 #include "core/WorldData.h"
@@ -80,65 +81,6 @@ bool WebSocketClient::connect(const std::string& url)
                                              deserializeEnd - deserializeStart)
                                              .count();
 
-                    // Reconstruct WorldData from RenderMessage.
-                    WorldData worldData;
-                    worldData.width = renderMsg.width;
-                    worldData.height = renderMsg.height;
-                    worldData.timestep = renderMsg.timestep;
-                    worldData.fps_server = renderMsg.fps_server;
-                    worldData.scenario_id = renderMsg.scenario_id;
-                    worldData.scenario_config = renderMsg.scenario_config;
-                    worldData.tree_vision = renderMsg.tree_vision;
-
-                    // Unpack cells based on format.
-                    size_t numCells = renderMsg.width * renderMsg.height;
-                    worldData.cells.resize(numCells);
-                    // Ensure debug_info is sized to match cells (default-initialized).
-                    // This prevents crashes when debug draw is enabled but CellDebug
-                    // data isn't transmitted over the network.
-                    worldData.debug_info.resize(numCells);
-
-                    if (renderMsg.format == RenderFormat::BASIC) {
-                        // Unpack BasicCell format.
-                        const BasicCell* basicCells =
-                            reinterpret_cast<const BasicCell*>(renderMsg.payload.data());
-                        for (size_t i = 0; i < numCells; ++i) {
-                            MaterialType material;
-                            double fill_ratio;
-                            RenderMessageUtils::unpackBasicCell(
-                                basicCells[i], material, fill_ratio);
-
-                            worldData.cells[i].material_type = material;
-                            worldData.cells[i].fill_ratio = fill_ratio;
-                            // Other fields remain at default values.
-                        }
-                    }
-                    else if (renderMsg.format == RenderFormat::DEBUG) {
-                        // Unpack DebugCell format.
-                        const DebugCell* debugCells =
-                            reinterpret_cast<const DebugCell*>(renderMsg.payload.data());
-                        for (size_t i = 0; i < numCells; ++i) {
-                            auto unpacked = RenderMessageUtils::unpackDebugCell(debugCells[i]);
-
-                            worldData.cells[i].material_type = unpacked.material_type;
-                            worldData.cells[i].fill_ratio = unpacked.fill_ratio;
-                            worldData.cells[i].com = unpacked.com;
-                            worldData.cells[i].velocity = unpacked.velocity;
-                            worldData.cells[i].hydrostatic_component = unpacked.pressure_hydro;
-                            worldData.cells[i].dynamic_component = unpacked.pressure_dynamic;
-                            worldData.cells[i].pressure =
-                                unpacked.pressure_hydro + unpacked.pressure_dynamic;
-                            worldData.cells[i].pressure_gradient = unpacked.pressure_gradient;
-                        }
-                    }
-
-                    // Apply sparse organism data.
-                    std::vector<uint8_t> organism_ids =
-                        RenderMessageUtils::applyOrganismData(renderMsg.organisms, numCells);
-                    for (size_t i = 0; i < numCells; ++i) {
-                        worldData.cells[i].organism_id = organism_ids[i];
-                    }
-
                     static int deserializeCount = 0;
                     static double totalDeserializeMs = 0.0;
                     deserializeCount++;
@@ -151,17 +93,19 @@ bool WebSocketClient::connect(const std::string& url)
                             totalDeserializeMs / deserializeCount,
                             deserializeCount,
                             deserializeMs,
-                            worldData.cells.size(),
+                            renderMsg.width * renderMsg.height,
                             renderMsg.format == RenderFormat::BASIC ? "BASIC" : "DEBUG");
                     }
 
-                    // Fast path: queue UiUpdateEvent directly via EventSink.
+                    // Fast path: queue UiUpdateEvent directly via EventSink. The renderer
+                    // reads cells straight from the payload, so nothing is unpacked here.
                     if (eventSink_) {
                         // No throttling needed - server pushes frames continuously.
                         auto now = std::chrono::steady_clock::now();
-                        uint64_t stepCount = worldData.timestep;
+                        auto frame = std::make_shared<const RenderFrame>(std::move(renderMsg));
+                        uint64_t stepCount = frame->timestep();
                         UiUpdateEvent evt{ .sequenceNum = 0,
-                                           .worldData = std::move(worldData),
+                                           .frame = std::move(frame),
                                            .fps = 0,
                                            .stepCount = stepCount,
                                            .isPaused = false,
@@ -173,7 +117,45 @@ bool WebSocketClient::connect(const std::string& url)
                         return; // Done - skip JSON conversion entirely.
                     }
 
-                    // Legacy fallback: convert to JSON for MessageParser.
+                    // Legacy fallback: reconstruct WorldData from RenderMessage.
+                    WorldData worldData;
+                    worldData.width = renderMsg.width;
+                    worldData.height = renderMsg.height;
+                    worldData.timestep = renderMsg.timestep;
+                    worldData.fps_server = renderMsg.fps_server;
+                    worldData.scenario_id = renderMsg.scenario_id;
+                    worldData.scenario_config = renderMsg.scenario_config;
+                    worldData.tree_vision = renderMsg.tree_vision;
+
+                    const RenderFrame frame(std::move(renderMsg));
+                    size_t numCells = frame.cellCount();
+                    worldData.cells.resize(numCells);
+                    // Ensure debug_info is sized to match cells (default-initialized).
+                    worldData.debug_info.resize(numCells);
+                    for (size_t i = 0; i < numCells; ++i) {
+                        auto unpacked = frame.decodeAt(i);
+
+                        worldData.cells[i].material_type = unpacked.material_type;
+                        worldData.cells[i].fill_ratio = unpacked.fill_ratio;
+                        if (frame.isDebug()) {
+                            worldData.cells[i].com = unpacked.com;
+                            worldData.cells[i].velocity = unpacked.velocity;
+                            worldData.cells[i].hydrostatic_component = unpacked.pressure_hydro;
+                            worldData.cells[i].dynamic_component = unpacked.pressure_dynamic;
+                            worldData.cells[i].pressure =
+                                unpacked.pressure_hydro + unpacked.pressure_dynamic;
+                            worldData.cells[i].pressure_gradient = unpacked.pressure_gradient;
+                        }
+                    }
+
+                    // Apply sparse organism data.
+                    std::vector<uint8_t> organism_ids =
+                        RenderMessageUtils::applyOrganismData(frame.organisms(), numCells);
+                    for (size_t i = 0; i < numCells; ++i) {
+                        worldData.cells[i].organism_id = organism_ids[i];
+                    }
+
+                    // Convert to JSON for MessageParser.
                     nlohmann::json doc;
                     doc["value"] = ReflectSerializer::to_json(worldData);
                     message = doc.dump();
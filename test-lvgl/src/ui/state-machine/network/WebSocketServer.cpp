@@ -1,4 +1,5 @@
 #include "WebSocketServer.h"
+#include "core/MsgPackAdapter.h"
 #include <spdlog/spdlog.h>
 
 namespace DirtSim {
@@ -50,7 +51,17 @@ void WebSocketServer::onClientConnected(std::shared_ptr<rtc::WebSocket> ws)
             onMessage(ws, message);
         }
         else {
-            spdlog::warn("UI WebSocket received binary message (not supported)");
+            // MessagePack command (the CLI's wire format), same map layout as the JSON form.
+            const auto& bytes = std::get<rtc::binary>(data);
+            try {
+                const msgpack::object_handle handle =
+                    msgpack::unpack(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+                onMessage(ws, handle.get().as<nlohmann::json>().dump());
+            }
+            catch (const std::exception& e) {
+                spdlog::error("UI WebSocket: MessagePack parse error: {}", e.what());
+                ws->send(nlohmann::json{ { "error", "MessagePack parse error" } }.dump());
+            }
         }
     });
 
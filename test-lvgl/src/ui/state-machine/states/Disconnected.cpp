@@ -9,6 +9,14 @@ namespace DirtSim {
 namespace Ui {
 namespace State {
 
+namespace {
+
+// Interned once at startup so per-frame timing skips the name lookup.
+const Timers::TimerId TIMER_CLIENT_TOTAL_PROCESSING = Timers::intern("client_total_processing");
+const Timers::TimerId TIMER_PARSE_MESSAGE = Timers::intern("parse_message");
+
+} // namespace
+
 void Disconnected::onEnter(StateMachine& /*sm*/)
 {
     spdlog::info("Disconnected: Not connected to DSSM server");
@@ -57,9 +65,9 @@ State::Any Disconnected::onEvent(const ConnectToServerCommand& cmd, StateMachine
 
         // Time message parsing (JSON parse + WorldData deserialization).
         auto& timers = sm.getTimers();
-        timers.startTimer("parse_message");
+        timers.startTimer(TIMER_PARSE_MESSAGE);
         auto event = MessageParser::parse(message);
-        timers.stopTimer("parse_message");
+        timers.stopTimer(TIMER_PARSE_MESSAGE);
 
         if (event) {
             // Track when we finish client-side processing.
@@ -69,8 +77,8 @@ State::Any Disconnected::onEvent(const ConnectToServerCommand& cmd, StateMachine
                                            .count();
 
             // Track total client-side processing time.
-            timers.startTimer("client_total_processing");
-            timers.stopTimer("client_total_processing");
+            timers.startTimer(TIMER_CLIENT_TOTAL_PROCESSING);
+            timers.stopTimer(TIMER_CLIENT_TOTAL_PROCESSING);
 
             // Log for debugging (will be noisy, but we can track patterns).
             spdlog::trace(
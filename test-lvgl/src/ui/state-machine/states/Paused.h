@@ -1,13 +1,11 @@
 #pragma once
 
 #include "StateForward.h"
+#include "core/RenderFrame.h"
 #include "ui/state-machine/Event.h"
 #include <memory>
 
 namespace DirtSim {
-
-struct WorldData;
-
 namespace Ui {
 namespace State {
 
@@ -15,7 +13,7 @@ namespace State {
  * @brief Paused state - simulation stopped but world still displayed.
  */
 struct Paused {
-    std::unique_ptr<WorldData> worldData; // Preserve world data while paused.
+    std::shared_ptr<const RenderFrame> frame; // Preserve the last frame while paused.
 
     void onEnter(StateMachine& sm);
     void onExit(StateMachine& sm);
@@ -12,6 +12,15 @@ namespace DirtSim {
 namespace Ui {
 namespace State {
 
+namespace {
+
+// Interned once at startup so per-frame timing skips the name lookup.
+const Timers::TimerId TIMER_RENDER_NEURAL_GRID = Timers::intern("render_neural_grid");
+const Timers::TimerId TIMER_RENDER_WORLD = Timers::intern("render_world");
+const Timers::TimerId TIMER_UPDATE_CONTROLS = Timers::intern("update_controls");
+
+} // namespace
+
 void SimRunning::onEnter(StateMachine& sm)
 {
     spdlog::info("SimRunning: Simulation is running, displaying world updates");
@@ -146,7 +155,7 @@ State::Any SimRunning::onEvent(const UiApi::SimPause::Cwc& cwc, StateMachine& /*
     cwc.sendResponse(UiApi::SimPause::Response::okay({ true }));
 
     // Transition to Paused state (keep renderer for when we resume).
-    return Paused{ std::move(worldData) };
+    return Paused{ std::move(frame) };
 }
 
 State::Any SimRunning::onEvent(const PhysicsSettingsReceivedEvent& evt, StateMachine& /*sm*/)
@@ -219,18 +228,12 @@ State::Any SimRunning::onEvent(const UiUpdateEvent& evt, StateMachine& sm)
         uint32_t intervalRenderCount = renderCount - lastRenderCount;
 
         // Get additional timing info
-        double copyTotal = timers.getAccumulatedTime("copy_worlddata");
-        uint32_t copyCount = timers.getCallCount("copy_worlddata");
         double updateTotal = timers.getAccumulatedTime("update_controls");
         uint32_t updateCount_ = timers.getCallCount("update_controls");
 
-        static double lastCopyTotal = 0.0;
-        static uint32_t lastCopyCount = 0;
         static double lastUpdateTotal = 0.0;
         static uint32_t lastUpdateCount = 0;
 
-        double intervalCopyTime = copyTotal - lastCopyTotal;
-        uint32_t intervalCopyCount = copyCount - lastCopyCount;
         double intervalUpdateTime = updateTotal - lastUpdateTotal;
         uint32_t intervalUpdateCount = updateCount_ - lastUpdateCount;
 
@@ -240,11 +243,6 @@ State::Any SimRunning::onEvent(const UiUpdateEvent& evt, StateMachine& sm)
             intervalParseCount > 0 ? intervalParseTime / intervalParseCount : 0.0,
             intervalParseCount,
             intervalParseTime);
-        spdlog::info(
-            "  WorldData copy: {:.1f}ms avg ({} calls, {:.1f}ms interval)",
-            intervalCopyCount > 0 ? intervalCopyTime / intervalCopyCount : 0.0,
-            intervalCopyCount,
-            intervalCopyTime);
         spdlog::info(
             "  Update controls: {:.1f}ms avg ({} calls, {:.1f}ms interval)",
             intervalUpdateCount > 0 ? intervalUpdateTime / intervalUpdateCount : 0.0,
@@ -256,8 +254,6 @@ State::Any SimRunning::onEvent(const UiUpdateEvent& evt, StateMachine& sm)
             intervalRenderCount,
             intervalRenderTime);
 
-        lastCopyTotal = copyTotal;
-        lastCopyCount = copyCount;
         lastUpdateTotal = updateTotal;
         lastUpdateCount = updateCount_;
 
@@ -268,33 +264,31 @@ State::Any SimRunning::onEvent(const UiUpdateEvent& evt, StateMachine& sm)
         lastRenderCount = renderCount;
     }
 
-    // Update local worldData with received state.
-    sm.getTimers().startTimer("copy_worlddata");
-    worldData = std::make_unique<WorldData>(evt.worldData);
-    sm.getTimers().stopTimer("copy_worlddata");
+    // Keep the received frame; it is shared with the event, so nothing is copied.
+    frame = evt.frame;
 
     // Update and render via playground.
-    if (playground_ && worldData) {
+    if (playground_ && frame) {
         // Update controls with new world state.
-        sm.getTimers().startTimer("update_controls");
-        playground_->updateFromWorldData(*worldData, smoothedUiFps);
-        sm.getTimers().stopTimer("update_controls");
+        sm.getTimers().startTimer(TIMER_UPDATE_CONTROLS);
+        playground_->updateFromFrame(*frame, smoothedUiFps);
+        sm.getTimers().stopTimer(TIMER_UPDATE_CONTROLS);
 
         // Render world.
-        sm.getTimers().startTimer("render_world");
-        playground_->render(*worldData, debugDrawEnabled);
-        sm.getTimers().stopTimer("render_world");
+        sm.getTimers().startTimer(TIMER_RENDER_WORLD);
+        playground_->render(*frame, debugDrawEnabled);
+        sm.getTimers().stopTimer(TIMER_RENDER_WORLD);
 
         // Render neural grid (tree vision).
-        sm.getTimers().startTimer("render_neural_grid");
-        playground_->renderNeuralGrid(*worldData);
-        sm.getTimers().stopTimer("render_neural_grid");
+        sm.getTimers().startTimer(TIMER_RENDER_NEURAL_GRID);
+        playground_->renderNeuralGrid(*frame);
+        sm.getTimers().stopTimer(TIMER_RENDER_NEURAL_GRID);
 
         spdlog::debug(
             "SimRunning: Rendered world ({}x{}, step {})",
-            worldData->width,
-            worldData->height,
-            worldData->timestep);
+            frame->width(),
+            frame->height(),
+            frame->timestep());
     }
 
     return std::move(*this);
@@ -1,14 +1,12 @@
 #pragma once
 
 #include "StateForward.h"
+#include "core/RenderFrame.h"
 #include "ui/SimPlayground.h"
 #include "ui/state-machine/Event.h"
 #include <memory>
 
 namespace DirtSim {
-
-struct WorldData;
-
 namespace Ui {
 
 class SimPlayground;
@@ -19,7 +17,7 @@ namespace State {
  * @brief Simulation running state - active display and interaction.
  */
 struct SimRunning {
-    std::unique_ptr<WorldData> worldData;       // Local copy of world data for rendering.
+    std::shared_ptr<const RenderFrame> frame;   // Latest received frame, shared with the event.
     std::unique_ptr<SimPlayground> playground_; // Coordinates all UI components.
 
     // UI-local draw mode toggles.